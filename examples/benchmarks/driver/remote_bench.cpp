@@ -0,0 +1,457 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/* Remote access benchmark driver. Sweeps the operation, access pattern,
+ * PE count, team shape and message size, and reports the latency
+ * percentiles and bandwidth of each configuration as CSV or JSON. The
+ * memory space is the default remote memory space of the build. */
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using RemoteSpace = Kokkos::Experimental::DefaultRemoteMemorySpace;
+using Value_t = int64_t;
+using RemoteView = Kokkos::View<Value_t **, RemoteSpace>;
+using BufferView = Kokkos::View<Value_t **, Kokkos::LayoutRight>;
+using Generator = Kokkos::Random_XorShift64_Pool<>;
+using TeamPolicy = Kokkos::TeamPolicy<>;
+
+enum Op { Get, Put };
+enum Pattern { Linear, Normal, Uniform };
+
+const char *op_names[] = {"get", "put"};
+const char *pattern_names[] = {"linear", "normal", "uniform"};
+
+struct Config {
+  Op op;
+  Pattern pattern;
+  int num_pes;
+  int league_size;
+  int team_size;
+  int64_t msg_size;
+};
+
+/* Per-message latency in microseconds over all samples of a configuration,
+ * one sample per participating rank and timed repetition */
+struct Result {
+  double min, p50, p90, p99, max;
+  double bandwidth;
+};
+
+std::vector<int64_t> parse_list(const char *arg) {
+  std::vector<int64_t> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty())
+      values.push_back(std::atoll(item.c_str()));
+  return values;
+}
+
+template <class Names>
+std::vector<int> parse_names(const char *arg, const Names &names,
+                             const int num_names) {
+  std::vector<int> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    int i = 0;
+    while (i < num_names && item != names[i])
+      i++;
+    if (i == num_names) {
+      std::cerr << "Unknown value: " << item << std::endl;
+      std::exit(1);
+    }
+    values.push_back(i);
+  }
+  return values;
+}
+
+double percentile(const std::vector<double> &sorted, const double p) {
+  const size_t i = size_t(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(i, sorted.size() - 1)];
+}
+
+/* Element offset in the global index space [0, num_pes * size) of
+ * message k of thread t. home is the start of the segment of the calling
+ * PE, around which the normal pattern is centered. */
+KOKKOS_INLINE_FUNCTION
+int64_t message_index(const Pattern pattern, const int64_t t,
+                      const int64_t k, const int64_t iters,
+                      const int64_t msg_size, const int64_t home,
+                      const double stddev, const int64_t total,
+                      Generator::generator_type &g) {
+  int64_t idx;
+  if (pattern == Linear)
+    idx = home + (t * iters + k) * msg_size;
+  else if (pattern == Normal)
+    idx = int64_t(g.normal(double(home), stddev));
+  else
+    idx = int64_t(g.urand64(uint64_t(total)));
+  idx %= total;
+  return idx < 0 ? idx + total : idx;
+}
+
+/* Times of the repetitions of cfg on the calling rank, excluding the
+ * first one as warm-up. Ranks at or beyond cfg.num_pes only take part in
+ * the fences. */
+std::vector<double> run(const Config &cfg, const RemoteView &v,
+                        const int64_t size, const int64_t iters,
+                        const int repeats, const double sigma,
+                        const int my_rank) {
+  const bool active = my_rank < cfg.num_pes;
+  const Op op = cfg.op;
+  const Pattern pattern = cfg.pattern;
+  const int64_t msg_size = cfg.msg_size;
+  const int64_t total = int64_t(cfg.num_pes) * size;
+  const int64_t home = int64_t(my_rank) * size;
+  const double stddev = sigma * size;
+
+  TeamPolicy policy(cfg.league_size, cfg.team_size, 1);
+  BufferView buffer("Buffer", int64_t(cfg.league_size) * cfg.team_size,
+                    msg_size);
+  Generator pool(5374857 + my_rank);
+
+  std::vector<double> times;
+  for (int r = 0; r < repeats; r++) {
+    RemoteSpace().fence();
+    Kokkos::Timer timer;
+    if (active)
+      Kokkos::parallel_for(
+          "RemoteBench", policy,
+          KOKKOS_LAMBDA(const TeamPolicy::member_type &team) {
+            const int64_t t =
+                int64_t(team.league_rank()) * team.team_size() +
+                team.team_rank();
+            auto buf = Kokkos::subview(buffer, t, Kokkos::ALL);
+            Generator::generator_type g = pool.get_state();
+            for (int64_t k = 0; k < iters; k++) {
+              const int64_t idx = message_index(pattern, t, k, iters,
+                                                msg_size, home, stddev,
+                                                total, g);
+              const int pe = idx / size;
+              // Messages do not cross segment boundaries
+              const int64_t offset = idx % size < size - msg_size
+                                         ? idx % size
+                                         : size - msg_size;
+              if (msg_size == 1) {
+                if (op == Get)
+                  buf(0) = v(pe, offset);
+                else
+                  v(pe, offset) = buf(0);
+              } else {
+                const Kokkos::pair<size_t, size_t> range(offset,
+                                                         offset + msg_size);
+                if (op == Get)
+                  Kokkos::Experimental::local_deep_copy(buf, v, pe, range);
+                else
+                  Kokkos::Experimental::local_deep_copy(v, buf, pe, range);
+              }
+            }
+            pool.free_state(g);
+          });
+    RemoteSpace().fence();
+    const double time = timer.seconds();
+    if (r > 0 && active)
+      times.push_back(time);
+  }
+  return times;
+}
+
+Result summarize(const Config &cfg, const std::vector<double> &local_times,
+                 const int64_t iters, const int repeats, const int my_rank,
+                 const int num_ranks) {
+  const int timed = repeats - 1;
+  std::vector<double> padded(timed, -1.0);
+  std::copy(local_times.begin(), local_times.end(), padded.begin());
+  std::vector<double> all(my_rank == 0 ? timed * num_ranks : 0);
+  MPI_Gather(padded.data(), timed, MPI_DOUBLE, all.data(), timed, MPI_DOUBLE,
+             0, MPI_COMM_WORLD);
+
+  Result res = Result();
+  if (my_rank != 0)
+    return res;
+  const double messages =
+      double(cfg.league_size) * cfg.team_size * double(iters);
+  std::vector<double> latencies;
+  std::vector<double> times;
+  for (double t : all)
+    if (t >= 0.0) {
+      latencies.push_back(t / messages * 1.0e6);
+      times.push_back(t);
+    }
+  std::sort(latencies.begin(), latencies.end());
+  std::sort(times.begin(), times.end());
+  res.min = latencies.front();
+  res.p50 = percentile(latencies, 0.50);
+  res.p90 = percentile(latencies, 0.90);
+  res.p99 = percentile(latencies, 0.99);
+  res.max = latencies.back();
+  const double bytes =
+      cfg.num_pes * messages * cfg.msg_size * sizeof(Value_t);
+  res.bandwidth = bytes / percentile(times, 0.50) / 1.0e9;
+  return res;
+}
+
+void print_result(const bool json, const bool first, const Config &cfg,
+                  const Result &res, const int64_t iters, const int repeats) {
+  const char *backend = RemoteSpace::name();
+  const long long msg_bytes = cfg.msg_size * sizeof(Value_t);
+  const long long messages =
+      (long long)cfg.league_size * cfg.team_size * iters;
+  if (json) {
+    printf("%s\n  {\"backend\": \"%s\", \"op\": \"%s\", \"pattern\": \"%s\", "
+           "\"pes\": %d, \"league_size\": %d, \"team_size\": %d, "
+           "\"msg_size\": %lld, \"msg_bytes\": %lld, \"messages\": %lld, "
+           "\"repeats\": %d, \"lat_us_min\": %.4f, \"lat_us_p50\": %.4f, "
+           "\"lat_us_p90\": %.4f, \"lat_us_p99\": %.4f, "
+           "\"lat_us_max\": %.4f, \"bw_GBs\": %.4f}",
+           first ? "" : ",", backend, op_names[cfg.op],
+           pattern_names[cfg.pattern], cfg.num_pes, cfg.league_size,
+           cfg.team_size, (long long)cfg.msg_size, msg_bytes, messages,
+           repeats - 1, res.min, res.p50, res.p90, res.p99, res.max,
+           res.bandwidth);
+  } else {
+    if (first)
+      printf("backend,op,pattern,pes,league_size,team_size,msg_size,"
+             "msg_bytes,messages,repeats,lat_us_min,lat_us_p50,lat_us_p90,"
+             "lat_us_p99,lat_us_max,bw_GBs\n");
+    printf("%s,%s,%s,%d,%d,%d,%lld,%lld,%lld,%d,%.4f,%.4f,%.4f,%.4f,%.4f,"
+           "%.4f\n",
+           backend, op_names[cfg.op], pattern_names[cfg.pattern],
+           cfg.num_pes, cfg.league_size, cfg.team_size,
+           (long long)cfg.msg_size, msg_bytes, messages, repeats - 1,
+           res.min, res.p50, res.p90, res.p99, res.max, res.bandwidth);
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+  // Init
+  MPI_Init(&argc, &argv);
+#ifdef KOKKOS_ENABLE_SHMEMSPACE
+  shmem_init();
+#endif
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+  MPI_Comm mpi_comm;
+  nvshmemx_init_attr_t attr;
+  mpi_comm = MPI_COMM_WORLD;
+  attr.mpi_comm = &mpi_comm;
+  nvshmemx_init_attr(NVSHMEMX_INIT_WITH_MPI_COMM, &attr);
+#endif
+
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  // Default values
+  int64_t size = 1 << 20;
+  int64_t iters = 128;
+  int repeats = 11;
+  double sigma = 1.0;
+  bool json = false;
+  std::vector<int> ops = {Get};
+  std::vector<int> patterns = {Linear, Normal, Uniform};
+  std::vector<int64_t> msg_sizes = {1, 8, 64, 512};
+  std::vector<int64_t> league_sizes = {1, 64};
+  std::vector<int64_t> team_sizes = {32};
+  std::vector<int64_t> pe_counts;
+  for (int p = 1; p < num_ranks; p *= 2)
+    pe_counts.push_back(p);
+  pe_counts.push_back(num_ranks);
+
+  option gopt[] = {
+    { "help", no_argument, NULL, 'h' },
+    { "size", required_argument, NULL, 'n' },
+    { "iters", required_argument, NULL, 'i' },
+    { "repeat", required_argument, NULL, 'r' },
+    { "sigma", required_argument, NULL, 's' },
+    { "ops", required_argument, NULL, 'o' },
+    { "patterns", required_argument, NULL, 'p' },
+    { "msg_sizes", required_argument, NULL, 'm' },
+    { "league_sizes", required_argument, NULL, 'L' },
+    { "team_sizes", required_argument, NULL, 'T' },
+    { "pes", required_argument, NULL, 'P' },
+    { "format", required_argument, NULL, 'f' },
+    { NULL, 0, NULL, 0 }
+  };
+
+  int ch;
+  bool help = false;
+  optind = 1;
+  while ((ch = getopt_long(argc, argv, "hn:i:r:s:o:p:m:L:T:P:f:", gopt,
+                           NULL)) != -1) {
+    switch (ch) {
+    case 'h':
+      help = true;
+      break;
+    case 'n':
+      size = std::atoll(optarg);
+      break;
+    case 'i':
+      iters = std::atoll(optarg);
+      break;
+    case 'r':
+      repeats = std::atoi(optarg) + 1;
+      if (repeats < 2) {
+        std::cerr << "At least one timed repetition required: " << optarg
+                  << std::endl;
+        std::exit(1);
+      }
+      break;
+    case 's':
+      sigma = std::atof(optarg);
+      break;
+    case 'o':
+      ops = parse_names(optarg, op_names, 2);
+      break;
+    case 'p':
+      patterns = parse_names(optarg, pattern_names, 3);
+      break;
+    case 'm':
+      msg_sizes = parse_list(optarg);
+      break;
+    case 'L':
+      league_sizes = parse_list(optarg);
+      break;
+    case 'T':
+      team_sizes = parse_list(optarg);
+      break;
+    case 'P':
+      pe_counts = parse_list(optarg);
+      break;
+    case 'f':
+      json = std::string(optarg) == "json";
+      break;
+    }
+  }
+
+  if (help) {
+    if (my_rank == 0)
+      std::cout << "remote_bench <optional_args> [-- <kokkos_args>]"
+        "\nLists are comma separated, every combination is run."
+        "\n-n/--size:          Elements per PE (default: 1048576)"
+        "\n-i/--iters:         Messages per thread and repetition (default: 128)"
+        "\n-r/--repeat:        Timed repetitions after one warm-up (default: 10)"
+        "\n-s/--sigma:         Standard deviation of the normal pattern in"
+        "\n                    units of the PE segment (default: 1.0)"
+        "\n-o/--ops:           get,put (default: get)"
+        "\n-p/--patterns:      linear,normal,uniform (default: all)"
+        "\n-m/--msg_sizes:     Elements per message (default: 1,8,64,512)"
+        "\n-L/--league_sizes:  League sizes (default: 1,64)"
+        "\n-T/--team_sizes:    Team sizes (default: 32)"
+        "\n-P/--pes:           PE counts (default: powers of two up to all PEs)"
+        "\n-f/--format:        csv or json (default: csv)"
+        "\n-h/--help:          Prints this help message"
+        "\n";
+    MPI_Finalize();
+    return 0;
+  }
+
+  int kokkos_argc = argc - optind + 1;
+  char **kokkos_argv = argv + optind - 1;
+  if (optind >= argc || kokkos_argv[0] != std::string("--")) {
+    // there are no kokkos options
+    kokkos_argv = argv;
+    kokkos_argc = 1;
+  }
+
+  Kokkos::initialize(kokkos_argc, kokkos_argv);
+  {
+    RemoteView v =
+        Kokkos::Experimental::allocate_symmetric_remote_view<RemoteView>(
+            "RemoteView", num_ranks, size);
+
+    if (my_rank == 0 && json)
+      printf("[");
+    bool first = true;
+    for (int op : ops)
+      for (int pattern : patterns)
+        for (int64_t num_pes : pe_counts)
+          for (int64_t league_size : league_sizes)
+            for (int64_t team_size : team_sizes)
+              for (int64_t msg_size : msg_sizes) {
+                if (num_pes < 1 || num_pes > num_ranks || msg_size < 1 ||
+                    msg_size > size)
+                  continue;
+                Config cfg;
+                cfg.op = Op(op);
+                cfg.pattern = Pattern(pattern);
+                cfg.num_pes = num_pes;
+                cfg.league_size = league_size;
+                cfg.team_size = team_size;
+                cfg.msg_size = msg_size;
+                const std::vector<double> times =
+                    run(cfg, v, size, iters, repeats, sigma, my_rank);
+                const Result res = summarize(cfg, times, iters, repeats,
+                                             my_rank, num_ranks);
+                if (my_rank == 0)
+                  print_result(json, first, cfg, res, iters, repeats);
+                first = false;
+              }
+    if (my_rank == 0 && json)
+      printf("\n]\n");
+    RemoteSpace().fence();
+  }
+  Kokkos::finalize();
+#ifdef KOKKOS_ENABLE_SHMEMSPACE
+  shmem_finalize();
+#endif
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+  nvshmem_finalize();
+#endif
+  MPI_Finalize();
+  return 0;
+}
@@ -51,8 +51,8 @@
 #include <cmath>
 
 using GenPool=Kokkos::Random_XorShift64_Pool<>;
-using RemoteSpace=Kokkos::DefaultRemoteMemorySpace;
-using RemoteView=Kokkos::View<double**, Kokkos::DefaultRemoteMemorySpace>;
+using RemoteSpace=Kokkos::Experimental::DefaultRemoteMemorySpace;
+using RemoteView=Kokkos::View<double**, RemoteSpace>;
 
 #define MASK (2 << 27)
 constexpr uint64_t MISS_INDEX = std::numeric_limits<uint64_t>::max();
@@ -60,11 +60,16 @@ constexpr uint64_t MISS_INDEX = std::numeric_limits<uint64_t>::max();
 int main(int argc, char** argv)
 {
   MPI_Init(&argc,&argv);
+#ifdef KOKKOS_ENABLE_SHMEMSPACE
+  shmem_init();
+#endif
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
   MPI_Comm mpi_comm;
   nvshmemx_init_attr_t attr;
   mpi_comm = MPI_COMM_WORLD;
   attr.mpi_comm = &mpi_comm;
   nvshmemx_init_attr (NVSHMEMX_INIT_WITH_MPI_COMM, &attr);
+#endif
 
   int rank, nproc;
   MPI_Comm_rank(MPI_COMM_WORLD,&rank);
@@ -79,12 +84,13 @@ int main(int argc, char** argv)
 
   option gopt[] = {
     { "help", no_argument, NULL, 'h' },
-    { "lambda", no_argument, NULL, 'l'},
-    { "team_size", no_argument, NULL, 'T'},
-    { "nx", no_argument, NULL, 'n'},
-    { "league_size", no_argument, NULL, 'L'},
-    { "repeat", no_argument, NULL, 'r'},
-    { "fraction", no_argument, NULL, 'f'},
+    { "lambda", required_argument, NULL, 'l'},
+    { "team_size", required_argument, NULL, 'T'},
+    { "nx", required_argument, NULL, 'n'},
+    { "league_size", required_argument, NULL, 'L'},
+    { "repeat", required_argument, NULL, 'r'},
+    { "fraction", required_argument, NULL, 'f'},
+    { NULL, 0, NULL, 0 }
   };
 
   int ch;
@@ -178,7 +184,7 @@ int main(int argc, char** argv)
     Kokkos::View<double*>  target("target", view_size);
     Kokkos::View<double*>  values("values", view_size);
     Kokkos::TeamPolicy<> policy(league_size,team_size,1);
-    RemoteView remote = Kokkos::allocate_symmetric_remote_view<RemoteView>("MyView",nproc,rankList.data(),view_size);
+    RemoteView remote = Kokkos::Experimental::allocate_symmetric_remote_view<RemoteView>("MyView",nproc,view_size);
 
     Kokkos::Timer init_timer;
     //initialize the list of indices to zero
@@ -58,7 +58,7 @@
 #define ORDINAL_T int64_t
 #define SIGMA 1000
 
-using RemoteSpace = Kokkos::DefaultRemoteMemorySpace;
+using RemoteSpace = Kokkos::Experimental::DefaultRemoteMemorySpace;
 using RemoteView = Kokkos::View<ORDINAL_T **, RemoteSpace>;
 using Generator = Kokkos::Random_XorShift64_Pool<>;
 
@@ -85,18 +85,19 @@ int main(int argc, char *argv[]) {
 
   option gopt[] = {
     { "help", no_argument, NULL, 'h' },
-    { "size", no_argument, NULL, 's'},
-    { "sigma", no_argument, NULL, 'si'},
-    { "leage_size", no_argument, NULL, 'l'},
-    { "team_size", no_argument, NULL, 't'},
-    { "vec_len", no_argument, NULL, 'v'},
+    { "size", required_argument, NULL, 's'},
+    { "sigma", required_argument, NULL, 'S'},
+    { "league_size", required_argument, NULL, 'l'},
+    { "team_size", required_argument, NULL, 't'},
+    { "vec_len", required_argument, NULL, 'v'},
+    { NULL, 0, NULL, 0 }
   };
 
   int ch;
   bool help = false;
   bool keepParsingOpts = true;
   optind = 1;
-  while ((ch = getopt_long(argc, argv, "hs:si:l:t:v:", gopt, NULL)) != -1 && keepParsingOpts){
+  while ((ch = getopt_long(argc, argv, "hs:S:l:t:v:", gopt, NULL)) != -1 && keepParsingOpts){
       switch (ch) {
       case 0:
         //this set an input flag
@@ -107,7 +108,7 @@ int main(int argc, char *argv[]) {
       case 's': 
         array_size = (std::atoi(optarg) << 10) / sizeof(ORDINAL_T);
         break;
-      case 'si':
+      case 'S':
         sigma = std::atoi(optarg);
         break;
       case 'l':
@@ -116,15 +117,19 @@ int main(int argc, char *argv[]) {
       case 't':
         team_size = std::atoi(optarg);
         break;
+      case 'v':
+        vec_len = std::atoi(optarg);
+        break;
       }
   }
 
   if (help){
     std::cout << "randomaccess <optional_args>"
 	    "\n-s/--size:             The size of the problem in kB (default: 1000)"
-      "\n-si/--sigma:           Sigma used to conpute variance normalized to 1000 (default: 1000)"
+      "\n-S/--sigma:            Sigma used to conpute variance normalized to 1000 (default: 1000)"
       "\n-t/--team_size:        The team size (default: 32)"
       "\n-l/--league_size:      The league size (default: 1)"
+      "\n-v/--vec_len:          The vector length (default: 1)"
       "\n-h/--help:             Prints this help message"
       "\n"
     ;
@@ -172,11 +177,9 @@ int main(int argc, char *argv[]) {
   TeamPolicy policy = TeamPolicy(league_size, team_size, vec_len);  
   {
     elems_per_rank = ceil(1.0 * array_size / num_ranks);
-    int rank_list[num_ranks];
-    for (int r = 0; r < num_ranks; r++)
-      rank_list[r] = r;
-    RemoteView v = Kokkos::allocate_symmetric_remote_view<RemoteView>(
-        "RemoteView", num_ranks, rank_list, elems_per_rank);
+    RemoteView v =
+        Kokkos::Experimental::allocate_symmetric_remote_view<RemoteView>(
+            "RemoteView", num_ranks, elems_per_rank);
 
     do {
       Generator gen_pool(5374857);
@@ -223,7 +226,7 @@ int main(int argc, char *argv[]) {
       league_size, 
       team_size,
       vec_len, 
-      array_size, 
+      (long long) array_size, 
       access_latency, time, GBs);
   }
 
@@ -98,9 +98,117 @@ void spmv(YType y, AType A, XType x) {
             });
       });
 
+  // Entries of x change between calls, drop them from the cache
+  x.fence();
+}
+
+enum { SpmvCached, SpmvGather, SpmvHalo };
+
+/* As spmv, but each team first collects the entries of x referenced by
+ * its rows in scratch with one remote_gather, which groups the remote
+ * reads by PE, instead of reading them one by one */
+template <class YType, class AType, class XType>
+void spmv_gather(YType y, AType A, XType x) {
+
+#ifdef KOKKOS_ENABLE_CUDA
+  int rows_per_team = 16;
+  int team_size = 16;
+#else
+  int rows_per_team = 512;
+  int team_size = 1;
+#endif
+
+  int vector_length = 8;
+
+  int64_t nrows = y.extent(0);
+  int64_t league_size = (nrows + rows_per_team - 1) / rows_per_team;
+
+  typedef Kokkos::DefaultExecutionSpace::scratch_memory_space scratch_t;
+  typedef Kokkos::View<int *, scratch_t, Kokkos::MemoryUnmanaged> pe_view_t;
+  typedef Kokkos::View<size_t *, scratch_t, Kokkos::MemoryUnmanaged>
+      offset_view_t;
+  typedef Kokkos::View<double *, scratch_t, Kokkos::MemoryUnmanaged>
+      value_view_t;
+
+  // Scratch has to hold the entries of the densest block of rows
+  int64_t max_nnz = 0;
+  Kokkos::parallel_reduce(
+      "spmv_gather_nnz", league_size,
+      KOKKOS_LAMBDA(const int64_t team, int64_t &lmax) {
+        const int64_t first_row = team * rows_per_team;
+        const int64_t last_row = first_row + rows_per_team < nrows
+                                     ? first_row + rows_per_team
+                                     : nrows;
+        const int64_t nnz = A.row_ptr(last_row) - A.row_ptr(first_row);
+        if (nnz > lmax)
+          lmax = nnz;
+      },
+      Kokkos::Max<int64_t>(max_nnz));
+  const size_t scratch_size = pe_view_t::shmem_size(max_nnz) +
+                              offset_view_t::shmem_size(max_nnz) +
+                              value_view_t::shmem_size(max_nnz);
+
+  auto policy =
+      require(Kokkos::TeamPolicy<>(league_size, team_size, vector_length)
+                  .set_scratch_size(1, Kokkos::PerTeam(scratch_size)),
+              Kokkos::Experimental::WorkItemProperty::HintHeavyWeight);
+  Kokkos::parallel_for(
+      "spmv_gather", policy,
+      KOKKOS_LAMBDA(const Kokkos::TeamPolicy<>::member_type &team) {
+        const int64_t first_row = team.league_rank() * rows_per_team;
+        const int64_t last_row = first_row + rows_per_team < nrows
+                                     ? first_row + rows_per_team
+                                     : nrows;
+        const int64_t first = A.row_ptr(first_row);
+        const int64_t nnz = A.row_ptr(last_row) - first;
+
+        pe_view_t pes(team.team_scratch(1), nnz);
+        offset_view_t offsets(team.team_scratch(1), nnz);
+        value_view_t x_team(team.team_scratch(1), nnz);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nnz),
+                             [&](const int64_t j) {
+                               int64_t idx = A.col_idx(first + j);
+                               pes(j) = idx / MASK;
+                               offsets(j) = idx % MASK;
+                             });
+        Kokkos::Experimental::remote_gather(team, x, pes, offsets, x_team);
+
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, first_row, last_row),
+            [&](const int64_t row) {
+              const int64_t row_start = A.row_ptr(row);
+              const int64_t row_length = A.row_ptr(row + 1) - row_start;
+
+              double y_row = 0.0;
+              Kokkos::parallel_reduce(
+                  Kokkos::ThreadVectorRange(team, row_length),
+                  [=](const int64_t i, double &sum) {
+                    sum += A.values(i + row_start) *
+                           x_team(i + row_start - first);
+                  },
+                  y_row);
+              y(row) = y_row;
+            });
+      });
+
+  // Entries of x change between calls
   RemoteMemSpace_t().fence();
 }
 
+/* Product with a matrix whose column indices address the local vector x,
+ * such as the ghost buffer of a HaloPlan */
+template <class YType, class AType, class XType>
+void spmv_local(YType y, AType A, XType x) {
+  int64_t nrows = y.extent(0);
+  Kokkos::parallel_for(
+      "spmv_local", nrows, KOKKOS_LAMBDA(const int64_t row) {
+        double y_row = 0.0;
+        for (int64_t i = A.row_ptr(row); i < A.row_ptr(row + 1); i++)
+          y_row += A.values(i) * x(A.col_idx(i));
+        y(row) = y_row;
+      });
+}
+
 template <class YType, class XType> double dot(YType y, XType x) {
   double result = 0.0;
   Kokkos::parallel_reduce(
@@ -132,7 +240,7 @@ template <class VType> void print_vector(int label, VType v) {
 
 template <class VType, class AType, class PType>
 int cg_solve(VType y, AType A, VType b, PType p_global, int max_iter,
-             double tolerance) {
+             double tolerance, int spmv_mode) {
   int myproc = 0;
   MPI_Comm_rank(MPI_COMM_WORLD, &myproc);
   int num_iters = 0;
@@ -151,11 +259,48 @@ int cg_solve(VType y, AType A, VType b, PType p_global, int max_iter,
   VType p(p_global.data(), x.extent(0)); // Globally accessible data
   VType Ap("Ap", x.extent(0));
 
+  // Remote entries of p are re-read by many rows of A
+  Kokkos::Experimental::CachedView<PType> p_cached(p_global);
+
+  // The columns of A are the same in every iteration, so the entries of p
+  // they reference can be exchanged into a ghost buffer in bulk
+  typedef Kokkos::Experimental::HaloPlan<PType> halo_type;
+  halo_type halo;
+  AType A_halo = A;
+  if (spmv_mode == SpmvHalo) {
+    const int64_t nnz = A.nnz();
+    Kokkos::View<int *> pes("pes", nnz);
+    Kokkos::View<size_t *> offsets("offsets", nnz);
+    Kokkos::parallel_for(
+        "halo_columns", nnz, KOKKOS_LAMBDA(const int64_t i) {
+          pes(i) = A.col_idx(i) / MASK;
+          offsets(i) = A.col_idx(i) % MASK;
+        });
+    halo = halo_type(p_global, pes, offsets);
+    A_halo.col_idx = decltype(A.col_idx)("col_idx_halo", nnz);
+    auto local_index = halo.local_index();
+    auto col_idx = A_halo.col_idx;
+    Kokkos::parallel_for(
+        "halo_remap", nnz,
+        KOKKOS_LAMBDA(const int64_t i) { col_idx(i) = local_index(i); });
+  }
+
+  auto apply_A = [&]() {
+    if (spmv_mode == SpmvGather) {
+      spmv_gather(Ap, A, p_global);
+    } else if (spmv_mode == SpmvHalo) {
+      halo.exchange();
+      spmv_local(Ap, A_halo, halo.values());
+    } else {
+      spmv(Ap, A, p_cached);
+    }
+  };
+
   double one = 1.0;
   double zero = 0.0;
 
   axpby(p, one, x, zero, x);
-  spmv(Ap, A, p_global);
+  apply_A();
   axpby(r, one, b, -one, Ap);
 
   rtrans = dot(r, r);
@@ -193,7 +338,7 @@ int cg_solve(VType y, AType A, VType b, PType p_global, int max_iter,
 
     double alpha = 0;
     double p_ap_dot = 0;
-    spmv(Ap, A, p_global);
+    apply_A();
     p_ap_dot = dot(Ap, p);
 
     MPI_Allreduce(MPI_IN_PLACE, &p_ap_dot, 1, MPI_DOUBLE, MPI_SUM,
@@ -239,6 +384,9 @@ int main(int argc, char *argv[]) {
     int N = argc > 1 ? atoi(argv[1]) : 100;
     int max_iter = argc > 2 ? atoi(argv[2]) : 200;
     double tolerance = argc > 3 ? atoi(argv[3]) : 1e-7;
+    // Reads of remote entries of p: 0 cached, 1 gathered per team,
+    // 2 exchanged in bulk by a HaloPlan
+    int spmv_mode = argc > 4 ? atoi(argv[4]) : SpmvCached;
     CrsMatrix<Kokkos::HostSpace> h_A = Impl::generate_miniFE_matrix(N);
     Kokkos::View<double *, Kokkos::HostSpace> h_x =
         Impl::generate_miniFE_vector(N);
@@ -271,7 +419,7 @@ int main(int argc, char *argv[]) {
 
     Kokkos::Timer timer;
 
-    int num_iters = cg_solve(y, A, x_sub, p, max_iter, tolerance);
+    int num_iters = cg_solve(y, A, x_sub, p, max_iter, tolerance, spmv_mode);
     double time = timer.seconds();
 
     // Compute Bytes and Flops
@@ -59,7 +59,9 @@
 #define SIGMA 1000
 
 using RemoteSpace = Kokkos::Experimental::DefaultRemoteMemorySpace;
-using RemoteView = Kokkos::View<ORDINAL_T **, RemoteSpace>;
+using RemoteView =
+    Kokkos::Experimental::GlobalView<ORDINAL_T, Kokkos::Experimental::Block<>,
+                                     RemoteSpace>;
 using Generator = Kokkos::Random_XorShift64_Pool<>;
 
 KOKKOS_INLINE_FUNCTION
@@ -130,7 +132,8 @@ int main(int argc, char *argv[]) {
     ORDINAL_T iters_per_team;
     num_elems_per_rank = ceil(1.0 * num_elems / num_ranks);
 
-    RemoteView v = RemoteView("RemoteView", num_ranks, num_elems_per_rank);
+    const ORDINAL_T num_elems_total = num_elems_per_rank * num_ranks;
+    RemoteView v = RemoteView("RemoteView", num_elems_total);
 
     do {
       Generator gen_pool(5374857);
@@ -148,11 +151,8 @@ int main(int argc, char *argv[]) {
                 Kokkos::TeamThreadRange(team, my_rank * iters_per_team,
                                         (my_rank + 1) * iters_per_team),
                 [&](const ORDINAL_T i) {
-                  int rank;
                   ORDINAL_T index = abs(get(i, variance, g));
-                  rank = (index / num_elems_per_rank) % num_ranks;
-                  index = index % num_elems_per_rank;
-                  v(rank, index) ^= 0xC0FFEE;
+                  v(index % num_elems_total) ^= 0xC0FFEE;
                 });
             gen_pool.free_state(g);
           });
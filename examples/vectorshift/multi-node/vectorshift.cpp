@@ -53,7 +53,11 @@
 #define SIZE 1024
 
 using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
-using RemoteView_t = Kokkos::View<T **, RemoteSpace_t>;
+// Stores complete at RemoteSpace_t().fence(), so puts need not be flushed
+// individually
+using RemoteView_t =
+    Kokkos::View<T **, RemoteSpace_t,
+                 Kokkos::MemoryTraits<Kokkos::Experimental::DeferredPut>>;
 using HostView_t = Kokkos::View<T **, Kokkos::HostSpace>;
 
 #define swap(a, b, T)                                                          \
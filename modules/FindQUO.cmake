@@ -1,6 +1,6 @@
 
-find_library(libquo_found nvshmem PATHS ${QUO_ROOT} SUFFIXES lib lib64 NO_DEFAULT_PATHS)
-find_path(quohdr_found nvshmem.h PATHS ${QUO_ROOT}/include NO_DEFAULT_PATHS)
+find_library(libquo_found quo PATHS ${QUO_ROOT} SUFFIXES lib lib64 NO_DEFAULT_PATHS)
+find_path(quohdr_found quo.h PATHS ${QUO_ROOT}/include NO_DEFAULT_PATHS)
 
 find_package_handle_standard_args(QUO DEFAULT_MSG libquo_found quohdr_found)
 
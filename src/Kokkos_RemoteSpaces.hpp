@@ -44,6 +44,9 @@
 #ifndef KOKKOS_REMOTESPACES_HPP_
 #define KOKKOS_REMOTESPACES_HPP_
 #include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces_Options.hpp>
+#include <Kokkos_RemoteSpaces_Arena.hpp>
+#include <Kokkos_RemoteSpaces_Instrumentation.hpp>
 
 #ifdef KOKKOS_ENABLE_SHMEMSPACE
 namespace Kokkos {
@@ -75,8 +78,6 @@ class MPISpace;
 namespace Kokkos {
 namespace Experimental {
 
-enum { Monolithic, Symmetric, Asymmetric };
-
 #ifdef KOKKOS_ENABLE_NVSHMEMSPACE
 typedef NVSHMEMSpace DefaultRemoteMemorySpace;
 #else
@@ -91,20 +92,114 @@ error "At least one remote space must be selected."
 #endif
 #endif
 
+/* The allocation helpers below are collective over the PEs of the
+ * memory space instance, all PEs unless the optional first argument
+ * scopes it to a communicator or team. num_ranks is the number of PEs of
+ * that instance. */
+template <typename ViewType, class... Args>
+ViewType
+allocate_symmetric_remote_view(const char *const label,
+                               const typename ViewType::memory_space &scope,
+                               const int num_ranks, Args... args) {
+  typedef typename ViewType::memory_space t_mem_space;
+  t_mem_space space(scope);
+  int64_t size = ViewType::required_allocation_size(1, args...);
+  space.impl_set_allocation_mode(Symmetric);
+  space.impl_set_extent(size);
+  return ViewType(Kokkos::view_alloc(std::string(label), space), num_ranks,
+                  args...);
+}
+
 template <typename ViewType, class... Args>
 ViewType allocate_symmetric_remote_view(const char *const label,
                                         const int num_ranks, Args... args) {
+  return allocate_symmetric_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), num_ranks, args...);
+}
+
+/* Like allocate_symmetric_remote_view, but peers on the same node access
+ * each other's segments through load/store where the backend supports it. */
+template <typename ViewType, class... Args>
+ViewType allocate_symmetric_shared_remote_view(
+    const char *const label, const typename ViewType::memory_space &scope,
+    const int num_ranks, Args... args) {
   typedef typename ViewType::memory_space t_mem_space;
-  t_mem_space space;
+  t_mem_space space(scope);
   int64_t size = ViewType::required_allocation_size(1, args...);
-  space.impl_set_allocation_mode(Symmetric);
+  space.impl_set_allocation_mode(SymmetricShared);
+  space.impl_set_extent(size);
+  return ViewType(Kokkos::view_alloc(std::string(label), space), num_ranks,
+                  args...);
+}
+
+template <typename ViewType, class... Args>
+ViewType allocate_symmetric_shared_remote_view(const char *const label,
+                                               const int num_ranks,
+                                               Args... args) {
+  return allocate_symmetric_shared_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), num_ranks, args...);
+}
+
+/* Every PE owns local_extent entries of the first dimension after the PE
+ * index; local_extent may differ between PEs. */
+template <typename ViewType, class... Args>
+ViewType allocate_asymmetric_remote_view(
+    const char *const label, const typename ViewType::memory_space &scope,
+    const int num_ranks, const size_t local_extent, Args... args) {
+  typedef typename ViewType::memory_space t_mem_space;
+  t_mem_space space(scope);
+  int64_t size = ViewType::required_allocation_size(1, local_extent, args...);
+  space.impl_set_allocation_mode(Asymmetric);
   space.impl_set_extent(size);
   return ViewType(Kokkos::view_alloc(std::string(label), space), num_ranks,
+                  local_extent, args...);
+}
+
+template <typename ViewType, class... Args>
+ViewType allocate_asymmetric_remote_view(const char *const label,
+                                         const int num_ranks,
+                                         const size_t local_extent,
+                                         Args... args) {
+  return allocate_asymmetric_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), num_ranks, local_extent,
+      args...);
+}
+
+/* The view has no PE index. Each PE contributes local_rows rows of a
+ * global first dimension, in PE order. */
+template <typename ViewType, class... Args>
+ViewType allocate_monolithic_remote_view(
+    const char *const label, const typename ViewType::memory_space &scope,
+    const size_t local_rows, Args... args) {
+  typedef typename ViewType::memory_space t_mem_space;
+  t_mem_space space(scope);
+  int64_t size = ViewType::required_allocation_size(local_rows, args...);
+  space.impl_set_allocation_mode(Monolithic);
+  space.impl_set_extent(size);
+  return ViewType(Kokkos::view_alloc(std::string(label), space), local_rows,
                   args...);
 }
 
+template <typename ViewType, class... Args>
+ViewType allocate_monolithic_remote_view(const char *const label,
+                                         const size_t local_rows,
+                                         Args... args) {
+  return allocate_monolithic_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), local_rows, args...);
+}
+
 } // namespace Experimental
 
 } // namespace Kokkos
 
+#include <Kokkos_RemoteSpaces_Aggregator.hpp>
+#include <Kokkos_RemoteSpaces_Atomics.hpp>
+#include <Kokkos_RemoteSpaces_Cache.hpp>
+#include <Kokkos_RemoteSpaces_Checkpoint.hpp>
+#include <Kokkos_RemoteSpaces_Collectives.hpp>
+#include <Kokkos_RemoteSpaces_Distribution.hpp>
+#include <Kokkos_RemoteSpaces_Halo.hpp>
+#include <Kokkos_RemoteSpaces_Signal.hpp>
+#include <Kokkos_RemoteSpaces_Topology.hpp>
+
 #endif
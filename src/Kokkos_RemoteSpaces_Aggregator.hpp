@@ -0,0 +1,379 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_AGGREGATOR_HPP_
+#define KOKKOS_REMOTESPACES_AGGREGATOR_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces_Topology.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <mpi.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Kokkos {
+namespace Experimental {
+
+namespace Impl {
+
+/* Combines updates of an element with op. combine merges two updates on
+ * the origin, apply combines an update atomically into a local element. */
+template <int Op> struct apply_op;
+
+template <> struct apply_op<OpReplace> {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void apply(T *ptr, const T &val) {
+    Kokkos::atomic_exchange(ptr, val);
+  }
+  template <class T> static T combine(const T &, const T &val) {
+    return val;
+  }
+};
+
+template <> struct apply_op<OpSum> {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void apply(T *ptr, const T &val) {
+    Kokkos::atomic_add(ptr, val);
+  }
+  template <class T> static T combine(const T &a, const T &b) {
+    return a + b;
+  }
+};
+
+template <> struct apply_op<OpProd> {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void apply(T *ptr, const T &val) {
+    Kokkos::atomic_fetch_mul(ptr, val);
+  }
+  template <class T> static T combine(const T &a, const T &b) {
+    return a * b;
+  }
+};
+
+template <> struct apply_op<OpMin> {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void apply(T *ptr, const T &val) {
+    Kokkos::atomic_fetch_min(ptr, val);
+  }
+  template <class T> static T combine(const T &a, const T &b) {
+    return b < a ? b : a;
+  }
+};
+
+template <> struct apply_op<OpMax> {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void apply(T *ptr, const T &val) {
+    Kokkos::atomic_fetch_max(ptr, val);
+  }
+  template <class T> static T combine(const T &a, const T &b) {
+    return a < b ? b : a;
+  }
+};
+
+/* Memory spaces able to apply a list of scattered updates to one PE as a
+ * single operation */
+template <class MemorySpace> struct has_scatter : std::false_type {};
+
+#ifdef KOKKOS_ENABLE_MPISPACE
+template <> struct has_scatter<MPISpace> : std::true_type {};
+#endif
+
+} // namespace Impl
+
+/** \brief  Coalesces fine-grained updates of a rank-2 remote view (pe, i)
+ *          into bulk transfers per destination PE.
+ *
+ *  update(pe, i, val) may be called from any thread of the execution
+ *  space. Updates are appended to a pool shared by all destination PEs
+ *  and combined into the remote element with Op when the pool is
+ *  flushed. Updates to the same element are combined on the origin
+ *  before they are sent. update() returns false once the pool is full;
+ *  the update is then dropped and must be issued again after a flush.
+ *
+ *  On MPISpace the updates to each PE are applied with a single
+ *  MPI_Accumulate over an indexed datatype, so the target applies them
+ *  atomically with respect to other accumulates, and flush() does not
+ *  synchronize PEs. On the SHMEM backends flush() is collective over all
+ *  PEs: the updates to each PE are put into an inbox on that PE with one
+ *  transfer of offsets and one of values, and every PE then applies the
+ *  updates it received with atomics on its local segment.
+ *
+ *  The order in which updates of an element are applied is unspecified,
+ *  hence OpReplace is only meaningful if all updates of an element within
+ *  one flush carry the same value.
+ */
+template <class ViewType, int Op = OpSum> class RemoteAggregator {
+public:
+  typedef ViewType view_type;
+  typedef typename view_type::non_const_value_type value_type;
+  typedef typename view_type::memory_space memory_space;
+  typedef typename view_type::execution_space execution_space;
+
+  static_assert(view_type::Rank == 2,
+                "RemoteAggregator requires a rank-2 view indexed by (pe, i)");
+  static_assert(
+      std::is_same<typename view_type::array_layout,
+                   Kokkos::LayoutRight>::value ||
+          std::is_same<typename view_type::array_layout,
+                       Kokkos::LayoutLeft>::value,
+      "RemoteAggregator requires a contiguous layout");
+
+  enum : size_t { default_capacity = 1 << 16 };
+
+  RemoteAggregator() = default;
+
+  /** \brief  Buffers up to capacity updates, whatever their destination */
+  explicit RemoteAggregator(const view_type &v,
+                            const size_t capacity = default_capacity)
+      : m_view(v), m_capacity(capacity) {
+    if (v.impl_map().partition().is_monolithic)
+      Kokkos::abort("RemoteAggregator: Monolithic views are not supported.");
+    m_num_pes =
+        view_type::memory_space::impl_num_pes(v.impl_map().handle().scope) -
+        v.impl_map().pe_offset();
+
+    const std::string label = v.label();
+    m_count = count_view_type(label + "_agg_count");
+    m_pes = pe_view_type(
+        Kokkos::view_alloc(label + "_agg_pes", Kokkos::WithoutInitializing),
+        m_capacity);
+    m_offsets = offset_view_type(
+        Kokkos::view_alloc(label + "_agg_offsets", Kokkos::WithoutInitializing),
+        m_capacity);
+    m_values = value_view_type(
+        Kokkos::view_alloc(label + "_agg_values", Kokkos::WithoutInitializing),
+        m_capacity);
+  }
+
+  /** \brief  Buffers combining val into element i of the segment of pe.
+   *          Returns false without buffering if the pool is full. */
+  KOKKOS_INLINE_FUNCTION bool update(const int pe, const size_t i,
+                                     const value_type &val) const {
+    const size_t slot = Kokkos::atomic_fetch_add(&m_count(), size_t(1));
+    if (slot >= m_capacity)
+      return false;
+    m_pes(slot) = pe;
+    m_offsets(slot) = i;
+    m_values(slot) = val;
+    return true;
+  }
+
+  /** \brief  Applies all buffered updates and empties the pool. On
+   *          MPISpace it completes after the updates are applied at their
+   *          targets, without synchronizing PEs. */
+  void flush() const {
+    Kokkos::fence();
+    size_t n = 0;
+    Kokkos::deep_copy(n, m_count);
+    n = std::min<size_t>(n, m_capacity);
+
+    // Only the filled part of the pool is copied
+    const Kokkos::pair<size_t, size_t> used(0, n);
+    auto h_pes = Kokkos::create_mirror_view(
+        Kokkos::HostSpace(), Kokkos::subview(m_pes, used));
+    auto h_offsets = Kokkos::create_mirror_view(
+        Kokkos::HostSpace(), Kokkos::subview(m_offsets, used));
+    auto h_values = Kokkos::create_mirror_view(
+        Kokkos::HostSpace(), Kokkos::subview(m_values, used));
+    Kokkos::deep_copy(h_pes, Kokkos::subview(m_pes, used));
+    Kokkos::deep_copy(h_offsets, Kokkos::subview(m_offsets, used));
+    Kokkos::deep_copy(h_values, Kokkos::subview(m_values, used));
+
+    // Sort by target PE and offset and combine updates of the same element
+    std::vector<size_t> order(n);
+    for (size_t j = 0; j < n; j++)
+      order[j] = j;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return h_pes(a) < h_pes(b) ||
+             (h_pes(a) == h_pes(b) && h_offsets(a) < h_offsets(b));
+    });
+    std::vector<int> pes;
+    std::vector<size_t> offsets;
+    std::vector<value_type> values;
+    for (size_t j = 0; j < n; j++) {
+      const int pe = h_pes(order[j]);
+      const size_t off = h_offsets(order[j]);
+      const value_type val = h_values(order[j]);
+      if (!pes.empty() && pes.back() == pe && offsets.back() == off) {
+        values.back() = Impl::apply_op<Op>::combine(values.back(), val);
+      } else {
+        pes.push_back(pe);
+        offsets.push_back(off);
+        values.push_back(val);
+      }
+    }
+
+    apply(pes, offsets, values, Impl::has_scatter<memory_space>());
+    Kokkos::deep_copy(m_count, size_t(0));
+  }
+
+  /** \brief  Flushes the pool and fences the underlying view, making all
+   *          updates visible on all PEs */
+  void fence() const {
+    flush();
+    memory_space().fence(m_view);
+  }
+
+  KOKKOS_INLINE_FUNCTION const view_type &view() const { return m_view; }
+  KOKKOS_INLINE_FUNCTION size_t capacity() const { return m_capacity; }
+
+private:
+  typedef Kokkos::View<size_t, execution_space> count_view_type;
+  typedef Kokkos::View<int *, execution_space> pe_view_type;
+  typedef Kokkos::View<size_t *, execution_space> offset_view_type;
+  typedef Kokkos::View<value_type *, execution_space> value_view_type;
+  typedef Kokkos::View<size_t **, memory_space> inbox_offset_type;
+  typedef Kokkos::View<value_type **, memory_space> inbox_value_type;
+
+  void apply(const std::vector<int> &pes, const std::vector<size_t> &offsets,
+             const std::vector<value_type> &values, std::true_type) const {
+    size_t begin = 0;
+    while (begin < pes.size()) {
+      size_t end = begin;
+      while (end < pes.size() && pes[end] == pes[begin])
+        end++;
+#ifdef KOKKOS_ENABLE_MPISPACE
+      m_view.impl_map().handle().scatter(
+          m_view.impl_map().pe_offset() + pes[begin], &offsets[begin],
+          &values[begin], end - begin, Kokkos::Impl::get_mpi_op(Op));
+#endif
+      begin = end;
+    }
+  }
+
+  void apply(const std::vector<int> &pes, const std::vector<size_t> &offsets,
+             const std::vector<value_type> &values, std::false_type) const {
+    typedef Kokkos::View<const size_t *, Kokkos::HostSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        h_offset_view;
+    typedef Kokkos::View<const value_type *, Kokkos::HostSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        h_value_view;
+    const MPI_Comm comm =
+        Impl::scope_comm<memory_space>::comm(m_view.impl_map().handle().scope);
+    int num_pes;
+    MPI_Comm_size(comm, &num_pes);
+
+    // Every PE learns how many updates it receives from each origin and
+    // tells each origin where in its inbox to put them
+    const int pe_offset = m_view.impl_map().pe_offset();
+    std::vector<uint64_t> send_counts(num_pes, 0), send_first(num_pes, 0);
+    for (size_t j = pes.size(); j-- > 0;) {
+      send_counts[pe_offset + pes[j]]++;
+      send_first[pe_offset + pes[j]] = j;
+    }
+    std::vector<uint64_t> recv_counts(num_pes), recv_displs(num_pes),
+        send_displs(num_pes);
+    MPI_Alltoall(send_counts.data(), 1, MPI_UINT64_T, recv_counts.data(), 1,
+                 MPI_UINT64_T, comm);
+    uint64_t incoming = 0;
+    for (int pe = 0; pe < num_pes; pe++) {
+      recv_displs[pe] = incoming;
+      incoming += recv_counts[pe];
+    }
+    MPI_Alltoall(recv_displs.data(), 1, MPI_UINT64_T, send_displs.data(), 1,
+                 MPI_UINT64_T, comm);
+    uint64_t max_incoming = 0;
+    MPI_Allreduce(&incoming, &max_incoming, 1, MPI_UINT64_T, MPI_MAX, comm);
+    if (max_incoming == 0)
+      return;
+
+    // All PEs agree on the inbox size, so it is grown collectively
+    if (max_incoming > m_inbox_capacity) {
+      const std::string label = m_view.label();
+      const memory_space space = Impl::scope_space<memory_space>::space(
+          m_view.impl_map().handle().scope);
+      m_inbox_offsets = allocate_symmetric_remote_view<inbox_offset_type>(
+          (label + "_agg_inbox_offsets").c_str(), space, num_pes,
+          max_incoming);
+      m_inbox_values = allocate_symmetric_remote_view<inbox_value_type>(
+          (label + "_agg_inbox_values").c_str(), space, num_pes,
+          max_incoming);
+      m_inbox_capacity = max_incoming;
+    }
+
+    for (int pe = 0; pe < num_pes; pe++) {
+      const size_t n = send_counts[pe];
+      if (n == 0)
+        continue;
+      const size_t first = send_first[pe];
+      const Kokkos::pair<size_t, size_t> range(send_displs[pe],
+                                               send_displs[pe] + n);
+      Kokkos::Experimental::deep_copy(
+          m_inbox_offsets, h_offset_view(&offsets[first], n), pe, range);
+      Kokkos::Experimental::deep_copy(
+          m_inbox_values, h_value_view(&values[first], n), pe, range);
+    }
+    memory_space().fence(m_inbox_values);
+
+    // Updates from different origins may target the same element
+    value_type *const segment = m_view.data();
+    const size_t *const in_offsets = m_inbox_offsets.data();
+    const value_type *const in_values = m_inbox_values.data();
+    Kokkos::parallel_for(
+        "RemoteAggregator::flush",
+        Kokkos::RangePolicy<execution_space>(0, incoming),
+        KOKKOS_LAMBDA(const size_t j) {
+          Impl::apply_op<Op>::apply(segment + in_offsets[j], in_values[j]);
+        });
+    Kokkos::fence();
+  }
+
+  view_type m_view;
+  count_view_type m_count;
+  pe_view_type m_pes;
+  offset_view_type m_offsets;
+  value_view_type m_values;
+  mutable inbox_offset_type m_inbox_offsets;
+  mutable inbox_value_type m_inbox_values;
+  mutable uint64_t m_inbox_capacity = 0;
+  size_t m_capacity = 0;
+  int m_num_pes = 0;
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_AGGREGATOR_HPP_
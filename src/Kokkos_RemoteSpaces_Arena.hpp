@@ -0,0 +1,196 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef KOKKOS_REMOTESPACES_ARENA_HPP_
+#define KOKKOS_REMOTESPACES_ARENA_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Kokkos {
+namespace Experimental {
+
+namespace Impl {
+
+/** \brief  Bookkeeping of a RemoteArena.
+ *
+ *  Blocks are carved from the local segment of a backing allocation with
+ *  a power-of-two size-class allocator: freed blocks are kept on a LIFO
+ *  list of their class and reused, otherwise a bump pointer advances.
+ *  Both are O(1) and purely local. Since every PE issues the same
+ *  sequence of allocations, a block lies at the same offset in the
+ *  segments of all PEs.
+ */
+struct RemoteArenaState {
+  enum : int { min_class = 6, num_classes = 64 };
+  enum : size_t { npos = ~size_t(0) };
+
+  // Local segment of the backing allocation
+  char *base;
+  size_t capacity;
+  // Keeps the backing allocation alive while blocks are in use
+  Kokkos::Impl::SharedAllocationTracker tracker;
+
+  size_t top;
+  size_t used;
+  std::vector<size_t> free_blocks[num_classes];
+
+  RemoteArenaState() : base(NULL), capacity(0), top(0), used(0) {}
+
+  static int size_class(const size_t size) {
+    int c = min_class;
+    while ((size_t(1) << c) < size)
+      c++;
+    return c;
+  }
+
+  /* Offset of a block of at least size bytes, npos if exhausted */
+  size_t allocate(const size_t size) {
+    const int c = size_class(size);
+    const size_t block = size_t(1) << c;
+    size_t offset;
+    if (!free_blocks[c].empty()) {
+      offset = free_blocks[c].back();
+      free_blocks[c].pop_back();
+    } else if (top + block <= capacity) {
+      offset = top;
+      top += block;
+    } else {
+      return npos;
+    }
+    used += block;
+    return offset;
+  }
+
+  void deallocate(const size_t offset, const size_t size) {
+    const int c = size_class(size);
+    free_blocks[c].push_back(offset);
+    used -= size_t(1) << c;
+  }
+
+  /* Counterparts for pointers into the local segment */
+  void *allocate_ptr(const size_t size, const char *const space_name) {
+    const size_t offset = allocate(size);
+    if (offset == npos) {
+      std::string msg = std::string(space_name) +
+                        ": RemoteArena exhausted, requested " +
+                        std::to_string(size) + " bytes.";
+      Kokkos::Impl::throw_runtime_exception(msg);
+    }
+    return base + offset;
+  }
+
+  void deallocate_ptr(void *const ptr, const size_t size) {
+    deallocate(static_cast<char *>(ptr) - base, size);
+  }
+};
+
+} // namespace Impl
+
+/** \brief  Pool of symmetric memory for short-lived remote views.
+ *
+ *    RemoteArena<RemoteSpace_t> arena(64 << 20);
+ *    for (int step = 0; step < num_steps; step++) {
+ *      View<double **, RemoteSpace_t> tmp(
+ *          view_alloc("Tmp", arena.space()), num_pes, n);
+ *      ...
+ *    }
+ *
+ *  Construction reserves capacity bytes on every PE with one collective
+ *  allocation. Views allocated with the memory space instance returned by
+ *  space() are then carved from this reservation without communication,
+ *  and returned to it on deallocation. As with any remote allocation,
+ *  all PEs must allocate and deallocate views from an arena in the same
+ *  order and with the same sizes; only Symmetric views are supported.
+ *  Blocks are rounded up to a power of two. The arena may be destroyed
+ *  before the views allocated from it.
+ *
+ *  The reservation spans the PEs of scope. On the SHMEM backends the
+ *  symmetric heap is collective over all PEs, so the arena is reserved
+ *  over all of them; views of a team are then allocated from
+ *  space(team_space) without involving PEs outside the team.
+ */
+template <class MemorySpace> class RemoteArena {
+public:
+  typedef MemorySpace memory_space;
+
+  explicit RemoteArena(const size_t capacity,
+                       const std::string &label = "RemoteArena",
+                       const memory_space &scope = memory_space())
+      : m_state(std::make_shared<Impl::RemoteArenaState>()), m_scope(scope) {
+    Kokkos::View<char **, MemorySpace> backing(
+        Kokkos::view_alloc(label, Kokkos::WithoutInitializing, scope),
+        scope.impl_num_pes(), capacity);
+    m_state->base = reinterpret_cast<char *>(backing.data());
+    m_state->capacity = capacity;
+    m_state->tracker = backing.impl_track();
+  }
+
+  /** \brief  Memory space instance allocating from the arena */
+  memory_space space() const { return space(m_scope); }
+
+  /** \brief  As space(), for views over the PEs of scope. On MPISpace
+   *          scope must span the communicator of the arena, on the SHMEM
+   *          backends it may be any team. */
+  memory_space space(const memory_space &scope) const {
+    memory_space s(scope);
+    s.impl_set_arena(m_state);
+    return s;
+  }
+
+  size_t capacity() const { return m_state->capacity; }
+
+  /** \brief  Bytes in blocks currently allocated */
+  size_t used() const { return m_state->used; }
+
+private:
+  std::shared_ptr<Impl::RemoteArenaState> m_state;
+  memory_space m_scope;
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_ARENA_HPP_
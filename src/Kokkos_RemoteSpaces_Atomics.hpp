@@ -0,0 +1,115 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_ATOMICS_HPP_
+#define KOKKOS_REMOTESPACES_ATOMICS_HPP_
+
+#include <Kokkos_Core.hpp>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Atomic operations on elements of remote views, e.g.
+ *
+ *    const int64_t ticket = atomic_fetch_add(v(pe, i), int64_t(1));
+ *
+ *  All return the value of the element before the update. They accept the
+ *  reference returned by element access of any remote memory space and
+ *  map to MPI_Fetch_and_op / MPI_Compare_and_swap on MPISpace and to
+ *  the typed SHMEM and NVSHMEM atomics otherwise.
+ */
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_fetch_add(const Element &e,
+                 const typename Element::const_value_type &val)
+    -> decltype(e.fetch_add(val)) {
+  return e.fetch_add(val);
+}
+
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_fetch_and(const Element &e,
+                 const typename Element::const_value_type &val)
+    -> decltype(e.fetch_and(val)) {
+  return e.fetch_and(val);
+}
+
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_fetch_or(const Element &e,
+                const typename Element::const_value_type &val)
+    -> decltype(e.fetch_or(val)) {
+  return e.fetch_or(val);
+}
+
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_fetch_xor(const Element &e,
+                 const typename Element::const_value_type &val)
+    -> decltype(e.fetch_xor(val)) {
+  return e.fetch_xor(val);
+}
+
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_exchange(const Element &e,
+                const typename Element::const_value_type &val)
+    -> decltype(e.exchange(val)) {
+  return e.exchange(val);
+}
+
+/** \brief  Stores desired if the element equals expected. Succeeded if
+ *          the returned value equals expected. */
+template <class Element>
+KOKKOS_INLINE_FUNCTION auto
+atomic_compare_exchange(const Element &e,
+                        const typename Element::const_value_type &expected,
+                        const typename Element::const_value_type &desired)
+    -> decltype(e.compare_exchange(expected, desired)) {
+  return e.compare_exchange(expected, desired);
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_ATOMICS_HPP_
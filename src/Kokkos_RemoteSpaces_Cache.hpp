@@ -0,0 +1,229 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_CACHE_HPP_
+#define KOKKOS_REMOTESPACES_CACHE_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <stdint.h>
+#include <string>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Read-only view of a rank-2 remote view (pe, i) that serves
+ *          repeated remote reads from a local software cache.
+ *
+ *  Remote segments are fetched at line granularity into a direct-mapped
+ *  cache in the memory space of the execution space. Reads of the calling
+ *  PE's own segment bypass the cache. The cache is only coherent while no
+ *  PE writes the remote view: writes must be separated from cached reads
+ *  by fence(), which completes outstanding operations and invalidates
+ *  all lines. Copies of a CachedView share the cache.
+ *
+ *  Line fills are guarded by a per-line sequence number. A thread that
+ *  finds a line being filled by another thread reads the remote element
+ *  directly instead of waiting.
+ */
+template <class ViewType> class CachedView {
+public:
+  typedef ViewType view_type;
+  typedef typename view_type::non_const_value_type value_type;
+  typedef typename view_type::memory_space memory_space;
+  typedef typename view_type::execution_space execution_space;
+
+  static_assert(view_type::Rank == 2,
+                "CachedView requires a rank-2 view indexed by (pe, i)");
+  static_assert(
+      std::is_same<typename view_type::array_layout,
+                   Kokkos::LayoutRight>::value ||
+          std::is_same<typename view_type::array_layout,
+                       Kokkos::LayoutLeft>::value,
+      "CachedView requires a contiguous layout");
+
+  enum : size_t {
+    default_line_bytes = 4096,
+    default_cache_bytes = 1 << 22
+  };
+
+  CachedView() = default;
+
+  /** \brief  Wraps v with a cache of at least cache_bytes, organized in
+   *          lines of line_bytes. Both are rounded up to powers of two. */
+  explicit CachedView(const view_type &v,
+                      const size_t cache_bytes = default_cache_bytes,
+                      const size_t line_bytes = default_line_bytes)
+      : m_view(v) {
+    if (v.impl_map().partition().is_monolithic)
+      Kokkos::abort("CachedView: Monolithic views are not supported.");
+    m_my_pe = view_type::memory_space::impl_my_pe(v.impl_map().handle().scope) -
+              v.impl_map().pe_offset();
+
+    size_t line_len = 1;
+    while (line_len * sizeof(value_type) < line_bytes)
+      line_len *= 2;
+    size_t num_lines = 1;
+    while (num_lines * line_len * sizeof(value_type) < cache_bytes)
+      num_lines *= 2;
+
+    m_line_shift = 0;
+    while ((size_t(1) << m_line_shift) < line_len)
+      m_line_shift++;
+    m_line_mask = line_len - 1;
+    m_slot_mask = num_lines - 1;
+
+    const Impl::PEPartition &partition = v.impl_map().partition();
+    size_t max_extent = v.impl_map().dimension_1();
+    if (partition.is_partitioned()) {
+      max_extent = 0;
+      for (int pe = 0; pe < partition.num_pes; pe++) {
+        const size_t n =
+            partition.host_offsets[pe + 1] - partition.host_offsets[pe];
+        max_extent = n > max_extent ? n : max_extent;
+      }
+    }
+    m_lines_per_pe = (max_extent + line_len - 1) >> m_line_shift;
+
+    const std::string label = v.label();
+    m_lines = line_view_type(
+        Kokkos::view_alloc(label + "_cache", Kokkos::WithoutInitializing),
+        num_lines << m_line_shift);
+    m_tags = tag_view_type(label + "_cache_tags", num_lines);
+    m_seq = tag_view_type(label + "_cache_seq", num_lines);
+  }
+
+  /** \brief  Element i of the segment of pe */
+  KOKKOS_INLINE_FUNCTION value_type operator()(const int pe,
+                                               const size_t i) const {
+    if (pe == m_my_pe)
+      return m_view(pe, i);
+
+    const size_t line = i >> m_line_shift;
+    const uint64_t key = uint64_t(pe) * m_lines_per_pe + line + 1;
+    const size_t slot = (key - 1) & m_slot_mask;
+    volatile uint64_t *seq = &m_seq(slot);
+    volatile uint64_t *tag = &m_tags(slot);
+    volatile value_type *data = &m_lines(slot << m_line_shift);
+
+    const uint64_t s = *seq;
+    if (s & 1)
+      return m_view(pe, i);
+
+    if (*tag == key) {
+      Kokkos::memory_fence();
+      const value_type val = data[i & m_line_mask];
+      Kokkos::memory_fence();
+      if (*seq == s)
+        return val;
+    } else if (Kokkos::atomic_compare_exchange(&m_seq(slot), s, s + 1) ==
+               s) {
+      Kokkos::memory_fence();
+      *tag = key;
+      fill(slot, pe, line);
+      const value_type val = data[i & m_line_mask];
+      Kokkos::memory_fence();
+      Kokkos::atomic_increment(&m_seq(slot));
+      return val;
+    }
+    return m_view(pe, i);
+  }
+
+  /** \brief  Invalidates all lines without completing remote operations */
+  void invalidate() const { Kokkos::deep_copy(m_tags, uint64_t(0)); }
+
+  /** \brief  Completes outstanding operations on the underlying view,
+   *          synchronizes all PEs and invalidates the cache */
+  void fence() const {
+    memory_space().fence(m_view);
+    invalidate();
+  }
+
+  KOKKOS_INLINE_FUNCTION size_t extent(const int r) const {
+    return m_view.extent(r);
+  }
+  KOKKOS_INLINE_FUNCTION const view_type &view() const { return m_view; }
+  KOKKOS_INLINE_FUNCTION size_t line_elements() const {
+    return m_line_mask + 1;
+  }
+  KOKKOS_INLINE_FUNCTION size_t num_lines() const { return m_slot_mask + 1; }
+
+private:
+  typedef Kokkos::View<value_type *, execution_space> line_view_type;
+  typedef Kokkos::View<uint64_t *, execution_space> tag_view_type;
+
+  /* Number of elements of the segment of pe, which differs across PEs
+   * for Asymmetric views */
+  KOKKOS_INLINE_FUNCTION size_t segment_extent(const int pe) const {
+    const Impl::PEPartition &partition = m_view.impl_map().partition();
+    if (partition.is_partitioned())
+      return partition.offsets[pe + 1] - partition.offsets[pe];
+    return m_view.impl_map().dimension_1();
+  }
+
+  KOKKOS_INLINE_FUNCTION void fill(const size_t slot, const int pe,
+                                   const size_t line) const {
+    const size_t first = line << m_line_shift;
+    const size_t extent = segment_extent(pe);
+    const size_t n =
+        first + m_line_mask + 1 < extent ? m_line_mask + 1 : extent - first;
+    m_view.impl_map().handle().thread_get(
+        &m_lines(slot << m_line_shift), m_view.impl_map().pe_offset() + pe,
+        first, n);
+  }
+
+  view_type m_view;
+  line_view_type m_lines;
+  tag_view_type m_tags;
+  tag_view_type m_seq;
+  size_t m_line_shift = 0;
+  size_t m_line_mask = 0;
+  size_t m_slot_mask = 0;
+  uint64_t m_lines_per_pe = 0;
+  int m_my_pe = 0;
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_CACHE_HPP_
@@ -0,0 +1,308 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_CHECKPOINT_HPP_
+#define KOKKOS_REMOTESPACES_CHECKPOINT_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces_Topology.hpp>
+#include <mpi.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Checkpoint and restart of remote views with collective MPI-IO
+ *
+ *    write_remote_view(v, "state.krs");
+ *    // ... possibly a new run on a different number of PEs ...
+ *    read_remote_view(v, "state.krs");
+ *
+ *  All PEs of the communicator or team of the view call both functions.
+ *  Each PE writes its local segment straight from the memory of the space
+ *  with MPI_File_write_at_all, without a copy into a host view. Segments
+ *  that the host cannot access, e.g. of NVSHMEMSpace, are streamed
+ *  through a pinned host buffer in chunks.
+ *
+ *  The file starts with a header holding the value size, rank and
+ *  extents of the view and the number of elements of each PE, followed by
+ *  the segments of all PEs in PE order. read_remote_view assigns the
+ *  elements of this global sequence to the segments of its view in PE
+ *  order. A file can thus be read into a view of a different number of
+ *  PEs or a different row distribution, e.g. a Monolithic view, as long
+ *  as the total number of elements matches.
+ *
+ *  Views must be whole remote views with contiguous segments. Both
+ *  functions fence the view, so outstanding remote stores are part of
+ *  the checkpoint and restored elements are visible to all PEs on return.
+ */
+
+namespace Impl {
+
+/* Leading part of a checkpoint file. It is followed by num_pes element
+ * counts and the elements of the segments. */
+struct CheckpointHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t value_size;
+  uint64_t rank;
+  uint64_t extent[8];
+  uint64_t num_pes;
+};
+
+/* Chunk sizes of a single collective call, in bytes. Chunks stay below
+ * the int count limit of MPI and bound the size of the staging buffer. */
+enum : size_t {
+  checkpoint_direct_chunk = size_t(1) << 30,
+  checkpoint_staged_chunk = size_t(1) << 26
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+typedef Kokkos::CudaHostPinnedSpace checkpoint_staging_space;
+#else
+typedef Kokkos::HostSpace checkpoint_staging_space;
+#endif
+
+template <class ViewType>
+inline void check_checkpoint_view(const ViewType &v, const char *const name) {
+  static_assert(
+      std::is_same<typename ViewType::traits::specialize,
+                   Kokkos::Experimental::RemoteSpaceSpecializeTag>::value,
+      "Checkpoints require remote views");
+  static_assert(!Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+                    typename ViewType::memory_traits>::is_fixed_pe,
+                "Checkpoints require views with a PE dimension");
+  if (v.impl_map().pe_offset() != 0 || !v.span_is_contiguous()) {
+    std::string msg = std::string(name) + " of " + v.label() +
+                      " requires a whole view with contiguous segments.";
+    Kokkos::Impl::throw_runtime_exception(msg);
+  }
+}
+
+/* Moves the n bytes of the local segment seg to or from byte position
+ * pos of the file. All PEs issue the same number of collective calls,
+ * those with fewer bytes with empty chunks. */
+template <class MemorySpace>
+inline void checkpoint_transfer(MPI_File fh, MPI_Comm comm,
+                                const MPI_Offset pos, char *seg,
+                                const size_t n, const bool write) {
+  const bool direct =
+      Kokkos::Impl::MemorySpaceAccess<Kokkos::HostSpace,
+                                      MemorySpace>::accessible;
+  const size_t chunk =
+      direct ? size_t(checkpoint_direct_chunk) : size_t(checkpoint_staged_chunk);
+  unsigned long long num_chunks = (n + chunk - 1) / chunk;
+  unsigned long long max_chunks = 0;
+  MPI_Allreduce(&num_chunks, &max_chunks, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+                comm);
+  Kokkos::View<char *, checkpoint_staging_space> staging;
+  if (!direct && n)
+    staging = Kokkos::View<char *, checkpoint_staging_space>(
+        Kokkos::ViewAllocateWithoutInitializing("Checkpoint::staging"),
+        std::min(n, chunk));
+  for (unsigned long long c = 0; c < max_chunks; c++) {
+    const size_t first = std::min(n, size_t(c) * chunk);
+    const size_t count = std::min(n - first, chunk);
+    char *buf = direct ? seg + first : staging.data();
+    if (write) {
+      if (!direct && count)
+        Kokkos::Impl::DeepCopy<Kokkos::HostSpace, MemorySpace,
+                               Kokkos::Experimental::RemoteSpaceSpecializeTag>(
+            buf, seg + first, count);
+      MPI_File_write_at_all(fh, pos + MPI_Offset(first), buf, int(count),
+                            MPI_BYTE, MPI_STATUS_IGNORE);
+    } else {
+      MPI_File_read_at_all(fh, pos + MPI_Offset(first), buf, int(count),
+                           MPI_BYTE, MPI_STATUS_IGNORE);
+      if (!direct && count)
+        Kokkos::Impl::DeepCopy<MemorySpace, Kokkos::HostSpace,
+                               Kokkos::Experimental::RemoteSpaceSpecializeTag>(
+            seg + first, buf, count);
+    }
+  }
+}
+
+inline void checkpoint_error(MPI_File *fh, const std::string &msg) {
+  if (fh)
+    MPI_File_close(fh);
+  Kokkos::Impl::throw_runtime_exception(msg);
+}
+
+} // namespace Impl
+
+/** \brief  Writes all segments of v to the file at path, replacing it */
+template <class ViewType>
+void write_remote_view(const ViewType &v, const std::string &path) {
+  typedef typename ViewType::memory_space memory_space;
+  typedef typename ViewType::non_const_value_type value_type;
+  Impl::check_checkpoint_view(v, "write_remote_view");
+  const MPI_Comm comm = Impl::scope_comm<memory_space>::comm(
+      v.impl_map().handle().scope);
+  int my_pe, num_pes;
+  MPI_Comm_rank(comm, &my_pe);
+  MPI_Comm_size(comm, &num_pes);
+
+  // The PE layout, bytes before the segment of the calling PE follow
+  uint64_t count = v.span();
+  std::vector<uint64_t> counts(num_pes);
+  MPI_Allgather(&count, 1, MPI_UINT64_T, counts.data(), 1, MPI_UINT64_T,
+                comm);
+  uint64_t before = 0;
+  for (int pe = 0; pe < my_pe; pe++)
+    before += counts[pe];
+
+  Impl::CheckpointHeader header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, "KRSVIEW", sizeof(header.magic));
+  header.version = 1;
+  header.value_size = sizeof(value_type);
+  header.rank = ViewType::Rank;
+  for (int r = 0; r < int(ViewType::Rank); r++)
+    header.extent[r] = v.extent(r);
+  header.num_pes = num_pes;
+  const MPI_Offset data_pos =
+      sizeof(header) + MPI_Offset(num_pes) * sizeof(uint64_t);
+
+  // Kernels and remote stores into the segments complete before they
+  // are read
+  Kokkos::fence();
+  memory_space().fence(v);
+
+  MPI_File fh;
+  if (MPI_File_open(comm, path.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                    MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+    Impl::checkpoint_error(NULL, "write_remote_view: cannot open " + path);
+  MPI_File_set_size(fh, 0);
+  if (my_pe == 0) {
+    MPI_File_write_at(fh, 0, &header, sizeof(header), MPI_BYTE,
+                      MPI_STATUS_IGNORE);
+    MPI_File_write_at(fh, sizeof(header), counts.data(),
+                      num_pes * sizeof(uint64_t), MPI_BYTE,
+                      MPI_STATUS_IGNORE);
+  }
+  Impl::checkpoint_transfer<memory_space>(
+      fh, comm, data_pos + MPI_Offset(before * sizeof(value_type)),
+      reinterpret_cast<char *>(const_cast<value_type *>(v.data())),
+      count * sizeof(value_type), true);
+  MPI_File_close(&fh);
+}
+
+/** \brief  Fills the segments of v from a file written by
+ *          write_remote_view, possibly by a different number of PEs */
+template <class ViewType>
+void read_remote_view(const ViewType &v, const std::string &path) {
+  typedef typename ViewType::memory_space memory_space;
+  typedef typename ViewType::non_const_value_type value_type;
+  static_assert(std::is_same<typename ViewType::value_type, value_type>::value,
+                "read_remote_view requires a non-const view");
+  Impl::check_checkpoint_view(v, "read_remote_view");
+  const MPI_Comm comm = Impl::scope_comm<memory_space>::comm(
+      v.impl_map().handle().scope);
+  int my_pe;
+  MPI_Comm_rank(comm, &my_pe);
+
+  MPI_File fh;
+  if (MPI_File_open(comm, path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL,
+                    &fh) != MPI_SUCCESS)
+    Impl::checkpoint_error(NULL, "read_remote_view: cannot open " + path);
+
+  // All PEs see the same header and fail alike
+  Impl::CheckpointHeader header;
+  memset(&header, 0, sizeof(header));
+  if (my_pe == 0)
+    MPI_File_read_at(fh, 0, &header, sizeof(header), MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+  MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, comm);
+  if (strncmp(header.magic, "KRSVIEW", sizeof(header.magic)) != 0 ||
+      header.version != 1)
+    Impl::checkpoint_error(&fh, "read_remote_view: " + path +
+                                    " is not a remote view checkpoint");
+  if (header.value_size != sizeof(value_type) ||
+      header.rank != uint64_t(ViewType::Rank))
+    Impl::checkpoint_error(&fh, "read_remote_view: value type or rank of " +
+                                    v.label() + " differ from " + path);
+
+  std::vector<uint64_t> counts(header.num_pes);
+  if (my_pe == 0)
+    MPI_File_read_at(fh, sizeof(header), counts.data(),
+                     int(header.num_pes * sizeof(uint64_t)), MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+  MPI_Bcast(counts.data(), int(header.num_pes), MPI_UINT64_T, 0, comm);
+  uint64_t total = 0;
+  for (uint64_t pe = 0; pe < header.num_pes; pe++)
+    total += counts[pe];
+
+  // Segments of v take consecutive parts of the stored sequence
+  uint64_t count = v.span();
+  uint64_t view_total = 0;
+  uint64_t before = 0;
+  MPI_Allreduce(&count, &view_total, 1, MPI_UINT64_T, MPI_SUM, comm);
+  MPI_Exscan(&count, &before, 1, MPI_UINT64_T, MPI_SUM, comm);
+  if (my_pe == 0)
+    before = 0;
+  if (view_total != total)
+    Impl::checkpoint_error(&fh, "read_remote_view: " + v.label() + " holds " +
+                                    std::to_string(view_total) +
+                                    " elements, " + path + " holds " +
+                                    std::to_string(total));
+
+  const MPI_Offset data_pos =
+      sizeof(header) + MPI_Offset(header.num_pes) * sizeof(uint64_t);
+  Kokkos::fence();
+  Impl::checkpoint_transfer<memory_space>(
+      fh, comm, data_pos + MPI_Offset(before * sizeof(value_type)),
+      reinterpret_cast<char *>(v.data()), count * sizeof(value_type), false);
+  MPI_File_close(&fh);
+
+  memory_space().fence(v);
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_CHECKPOINT_HPP_
@@ -0,0 +1,214 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef KOKKOS_REMOTESPACES_COLLECTIVES_HPP_
+#define KOKKOS_REMOTESPACES_COLLECTIVES_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <string>
+#include <type_traits>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Collectives over remote views, e.g. a global dot product
+ *
+ *    View<double **, RemoteSpace_t> v("Dot", num_pes, 1);
+ *    // ... store the local partial sum in v(my_pe, 0) ...
+ *    allreduce(v, v, OpSum); // v(my_pe, 0) now holds the global sum
+ *
+ *  All PEs of the communicator or team of the views (all PEs unless their
+ *  memory space instance was constructed with one) call the collective
+ *  with symmetric views. Each operates on the
+ *  calling PE's segment of its arguments (the elements selected by
+ *  v(my_pe, ...)). Subviews select a contiguous part of the segments.
+ *  Reductions combine segments element-wise with OpSum, OpProd, OpMin or
+ *  OpMax. They map to MPI collectives on MPISpace and to the team-based
+ *  SHMEM and NVSHMEM collectives otherwise.
+ *
+ *  The overloads taking an execution space instance are ordered after
+ *  work previously submitted to it. With NVSHMEMSpace and a Kokkos::Cuda
+ *  instance the collective is enqueued on the stream of the instance and
+ *  the call returns immediately; otherwise the call blocks until the
+ *  collective has completed on the calling PE.
+ *
+ *  The team_* variants are called from within a kernel by exactly one
+ *  team per PE, every thread of the team participating.
+ */
+
+namespace Impl {
+
+template <class ViewType>
+inline size_t collective_extent(const ViewType &v, const char *const name) {
+  if (v.impl_map().partition().is_partitioned())
+    Kokkos::abort("Kokkos::Experimental collectives require symmetric "
+                  "views.");
+  if (!v.span_is_contiguous()) {
+    std::string msg = std::string(name) + " requires contiguous segments.";
+    Kokkos::Impl::throw_runtime_exception(msg);
+  }
+  return v.span();
+}
+
+template <class DstType, class SrcType> struct collective_types {
+  typedef typename DstType::memory_space memory_space;
+  typedef typename DstType::non_const_value_type value_type;
+  typedef RemoteCollectives<memory_space> backend;
+
+  static_assert(std::is_same<memory_space,
+                             typename SrcType::memory_space>::value,
+                "Collectives require views of the same remote space.");
+  static_assert(
+      std::is_same<value_type, typename SrcType::non_const_value_type>::value,
+      "Collectives require views of the same value type.");
+};
+
+} // namespace Impl
+
+/** \brief  Element-wise reduction of the src segments of all PEs into
+ *          the dst segment of every PE. dst may equal src. */
+template <class ExecSpace, class DstType, class SrcType>
+void allreduce(const ExecSpace &exec, const DstType &dst, const SrcType &src,
+               const int op) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  const size_t n = Impl::collective_extent(src, "allreduce");
+  if (Impl::collective_extent(dst, "allreduce") != n)
+    Kokkos::abort("allreduce: segments of dst and src differ in size.");
+  types::backend::allreduce(exec, src.impl_map().handle().scope, dst.data(),
+                            src.data(), n, op);
+}
+
+template <class DstType, class SrcType>
+void allreduce(const DstType &dst, const SrcType &src, const int op) {
+  allreduce(typename DstType::execution_space(), dst, src, op);
+}
+
+/** \brief  As allreduce, the result is only guaranteed on root. The dst
+ *          segments of other PEs are unspecified afterwards. */
+template <class ExecSpace, class DstType, class SrcType>
+void reduce(const ExecSpace &exec, const DstType &dst, const SrcType &src,
+            const int op, const int root) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  const size_t n = Impl::collective_extent(src, "reduce");
+  if (Impl::collective_extent(dst, "reduce") != n)
+    Kokkos::abort("reduce: segments of dst and src differ in size.");
+  types::backend::reduce(exec, src.impl_map().handle().scope, dst.data(),
+                         src.data(), n, op, root);
+}
+
+template <class DstType, class SrcType>
+void reduce(const DstType &dst, const SrcType &src, const int op,
+            const int root) {
+  reduce(typename DstType::execution_space(), dst, src, op, root);
+}
+
+/** \brief  Copies the src segment of root into the dst segment of every
+ *          PE */
+template <class ExecSpace, class DstType, class SrcType>
+void broadcast(const ExecSpace &exec, const DstType &dst, const SrcType &src,
+               const int root) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  const size_t n = Impl::collective_extent(src, "broadcast");
+  if (Impl::collective_extent(dst, "broadcast") != n)
+    Kokkos::abort("broadcast: segments of dst and src differ in size.");
+  types::backend::broadcast(exec, src.impl_map().handle().scope, dst.data(),
+                            src.data(), n, root);
+}
+
+template <class DstType, class SrcType>
+void broadcast(const DstType &dst, const SrcType &src, const int root) {
+  broadcast(typename DstType::execution_space(), dst, src, root);
+}
+
+/** \brief  Concatenates the src segments of all PEs in PE order into the
+ *          dst segment of every PE, which holds num_pes times as many
+ *          elements */
+template <class ExecSpace, class DstType, class SrcType>
+void fcollect(const ExecSpace &exec, const DstType &dst, const SrcType &src) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  const int num_pes = types::memory_space::impl_num_pes(
+      src.impl_map().handle().scope);
+  const size_t n = Impl::collective_extent(src, "fcollect");
+  if (Impl::collective_extent(dst, "fcollect") != n * num_pes)
+    Kokkos::abort("fcollect: dst segment does not hold all src segments.");
+  types::backend::fcollect(exec, src.impl_map().handle().scope, dst.data(),
+                           src.data(), n);
+}
+
+template <class DstType, class SrcType>
+void fcollect(const DstType &dst, const SrcType &src) {
+  fcollect(typename DstType::execution_space(), dst, src);
+}
+
+template <class TeamType, class DstType, class SrcType>
+KOKKOS_INLINE_FUNCTION void team_allreduce(const TeamType &team,
+                                           const DstType &dst,
+                                           const SrcType &src, const int op) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  types::backend::team_allreduce(team, src.impl_map().handle().scope,
+                                 dst.data(), src.data(), src.span(), op);
+}
+
+template <class TeamType, class DstType, class SrcType>
+KOKKOS_INLINE_FUNCTION void team_broadcast(const TeamType &team,
+                                           const DstType &dst,
+                                           const SrcType &src,
+                                           const int root) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  types::backend::team_broadcast(team, src.impl_map().handle().scope,
+                                 dst.data(), src.data(), src.span(), root);
+}
+
+template <class TeamType, class DstType, class SrcType>
+KOKKOS_INLINE_FUNCTION void team_fcollect(const TeamType &team,
+                                          const DstType &dst,
+                                          const SrcType &src) {
+  typedef Impl::collective_types<DstType, SrcType> types;
+  types::backend::team_fcollect(team, src.impl_map().handle().scope, dst.data(),
+                                src.data(), src.span());
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_COLLECTIVES_HPP_
@@ -48,9 +48,86 @@
 namespace Kokkos {
 namespace Experimental{
 
+namespace Impl {
+
+/* Leading extent of the part of a view stored on the calling PE. Only
+ * Monolithic remote views differ from extent(0), their leading extent is
+ * global. */
+template <class ViewType>
+inline typename std::enable_if<
+    std::is_same<typename ViewType::traits::specialize,
+                 Kokkos::Experimental::RemoteSpaceSpecializeTag>::value,
+    size_t>::type
+local_extent_0(const ViewType &v) {
+  return v.impl_map().partition().is_monolithic
+             ? v.impl_map().partition().local_rows
+             : v.extent(0);
+}
+
+template <class ViewType>
+inline typename std::enable_if<
+    !std::is_same<typename ViewType::traits::specialize,
+                  Kokkos::Experimental::RemoteSpaceSpecializeTag>::value,
+    size_t>::type
+local_extent_0(const ViewType &v) {
+  return v.extent(0);
+}
+
+/* Extents and strides of a view of the default specialization */
+template <class ViewType>
+inline StridedLayout strided_layout(const ViewType &v) {
+  StridedLayout layout;
+  size_t strides[9];
+  v.stride(strides);
+  layout.rank = ViewType::Rank;
+  for (int r = 0; r < layout.rank; r++) {
+    layout.extent[r] = v.extent(r);
+    layout.stride[r] = strides[r];
+  }
+  return layout;
+}
+
+/* Extents and strides of the part of a remote view stored in the segment
+ * addressed by a whole-view deep_copy, relative to its first element.
+ * Without a fixed PE the leading index selects the segment, or the row
+ * within it for Monolithic views, which are spaced by the segment span. */
+template <class ViewType>
+inline StridedLayout segment_layout(const ViewType &v) {
+  StridedLayout layout = strided_layout(v);
+  if (!Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+          typename ViewType::memory_traits>::is_fixed_pe) {
+    const size_t rows = local_extent_0(v);
+    layout.extent[0] = rows;
+    layout.stride[0] = v.impl_map().partition().is_monolithic && rows
+                           ? v.impl_map().span() / rows
+                           : v.impl_map().span();
+  }
+  return layout;
+}
+
+/* PE owning the segment addressed by a whole-view deep_copy */
+template <class ViewType> inline int segment_pe(const ViewType &v) {
+  if (Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+          typename ViewType::memory_traits>::is_fixed_pe)
+    return v.impl_map().pe_offset();
+  return ViewType::memory_space::impl_my_pe(v.impl_map().handle().scope);
+}
+
+/* PE owning the segment addressed by a whole-view local_deep_copy */
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION int local_copy_pe(const ViewType &v) {
+  if (Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+          typename ViewType::memory_traits>::is_fixed_pe)
+    return v.impl_map().pe_offset();
+  return v.impl_map().handle().impl_my_pe();
+}
+
+} // namespace Impl
+
 //----------------------------------------------------------------------------
 /** \brief  A deep copy between views of the default specialization, compatible
- * type, same non-zero rank, same contiguous layout.
+ * type, same non-zero rank. Views of equal contiguous layout are copied
+ * byte-wise, others with a strided transfer.
  */
 template <class DT, class... DP, class ST, class... SP>
 inline void deep_copy(
@@ -92,7 +169,8 @@ inline void deep_copy(
     // do nothing
 #else
     // throw if dimension mismatch
-    if ((src.extent(0) != dst.extent(0)) || (src.extent(1) != dst.extent(1)) ||
+    if ((Impl::local_extent_0(src) != Impl::local_extent_0(dst)) ||
+        (src.extent(1) != dst.extent(1)) ||
         (src.extent(2) != dst.extent(2)) || (src.extent(3) != dst.extent(3)) ||
         (src.extent(4) != dst.extent(4)) || (src.extent(5) != dst.extent(5)) ||
         (src.extent(6) != dst.extent(6)) || (src.extent(7) != dst.extent(7))) {
@@ -177,7 +255,8 @@ inline void deep_copy(
   }
 
   // Check for same extents
-  if ((src.extent(0) != dst.extent(0)) || (src.extent(1) != dst.extent(1)) ||
+  if ((Impl::local_extent_0(src) != Impl::local_extent_0(dst)) ||
+      (src.extent(1) != dst.extent(1)) ||
       (src.extent(2) != dst.extent(2)) || (src.extent(3) != dst.extent(3)) ||
       (src.extent(4) != dst.extent(4)) || (src.extent(5) != dst.extent(5)) ||
       (src.extent(6) != dst.extent(6)) || (src.extent(7) != dst.extent(7))) {
@@ -246,16 +325,28 @@ inline void deep_copy(
       ((dst_type::rank < 8) || (dst.stride_7() == src.stride_7()))) {
     const size_t nbytes = sizeof(typename dst_type::value_type) * dst.span();
     Kokkos::fence();
-    if ((void*)dst.data() != (void*)src.data()) {
+    if (Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+            typename dst_type::memory_traits>::is_fixed_pe) {
+      // A subview at a fixed PE may address the segment of another PE
+      dst.impl_map().handle().put(src.data(), dst.impl_map().pe_offset(), 0,
+                                  dst.span());
+    } else if ((void*)dst.data() != (void*)src.data()) {
       Kokkos::Impl::DeepCopy<dst_memory_space, src_memory_space,Kokkos::Experimental::RemoteSpaceSpecializeTag>(
         dst.data(), src.data(), nbytes);
     }
     Kokkos::fence();
-  } else {
+  } else if (std::is_same<typename dst_type::value_type,
+                          typename src_type::non_const_value_type>::value) {
+    // Layouts or strides differ, the transfer is described by the strides
+    // of both sides
     Kokkos::fence();
-    //Kokkos::Impl::view_copy(dst, src); //not implemented
-    Kokkos::abort("Error: Not implemented.");
+    dst.impl_map().handle().put_strided(
+        (const typename dst_type::value_type*)src.data(),
+        Impl::strided_layout(src), Impl::segment_pe(dst), 0,
+        Impl::segment_layout(dst));
     Kokkos::fence();
+  } else {
+    Kokkos::abort("Error: deep_copy between value types not implemented.");
   }
 #if defined(KOKKOS_ENABLE_PROFILING)
   if (Kokkos::Profiling::profileLibraryLoaded()) {
@@ -266,7 +357,8 @@ inline void deep_copy(
 
 //----------------------------------------------------------------------------
 /** \brief  A deep copy between views of the default specialization, compatible
- * type, same non-zero rank, same contiguous layout.
+ * type, same non-zero rank. Views of equal contiguous layout are copied
+ * byte-wise, others with a strided transfer.
  */
 template <class DT, class... DP, class ST, class... SP>
 inline void deep_copy(
@@ -308,7 +400,8 @@ inline void deep_copy(
     // do nothing
 #else
     // throw if dimension mismatch
-    if ((src.extent(0) != dst.extent(0)) || (src.extent(1) != dst.extent(1)) ||
+    if ((Impl::local_extent_0(src) != Impl::local_extent_0(dst)) ||
+        (src.extent(1) != dst.extent(1)) ||
         (src.extent(2) != dst.extent(2)) || (src.extent(3) != dst.extent(3)) ||
         (src.extent(4) != dst.extent(4)) || (src.extent(5) != dst.extent(5)) ||
         (src.extent(6) != dst.extent(6)) || (src.extent(7) != dst.extent(7))) {
@@ -393,7 +486,8 @@ inline void deep_copy(
   }
 
   // Check for same extents
-  if ((src.extent(0) != dst.extent(0)) || (src.extent(1) != dst.extent(1)) ||
+  if ((Impl::local_extent_0(src) != Impl::local_extent_0(dst)) ||
+      (src.extent(1) != dst.extent(1)) ||
       (src.extent(2) != dst.extent(2)) || (src.extent(3) != dst.extent(3)) ||
       (src.extent(4) != dst.extent(4)) || (src.extent(5) != dst.extent(5)) ||
       (src.extent(6) != dst.extent(6)) || (src.extent(7) != dst.extent(7))) {
@@ -462,16 +556,28 @@ inline void deep_copy(
       ((dst_type::rank < 8) || (dst.stride_7() == src.stride_7()))) {
     const size_t nbytes = sizeof(typename dst_type::value_type) * dst.span();
     Kokkos::fence();
-    if ((void*)dst.data() != (void*)src.data()) {
+    if (Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+            typename src_type::memory_traits>::is_fixed_pe) {
+      // A subview at a fixed PE may address the segment of another PE
+      src.impl_map().handle().get(dst.data(), src.impl_map().pe_offset(), 0,
+                                  src.span());
+    } else if ((void*)dst.data() != (void*)src.data()) {
       Kokkos::Impl::DeepCopy<dst_memory_space, src_memory_space,Kokkos::Experimental::RemoteSpaceSpecializeTag>(
         dst.data(), src.data(), nbytes);
     }
     Kokkos::fence();
-  } else {
+  } else if (std::is_same<typename dst_type::value_type,
+                          typename src_type::non_const_value_type>::value) {
+    // Layouts or strides differ, the transfer is described by the strides
+    // of both sides
     Kokkos::fence();
-    //Kokkos::Impl::view_copy(dst, src); //not implemented
-    Kokkos::abort("Error: Not implemented.");
+    src.impl_map().handle().get_strided(
+        (typename src_type::non_const_value_type*)dst.data(),
+        Impl::strided_layout(dst), Impl::segment_pe(src), 0,
+        Impl::segment_layout(src));
     Kokkos::fence();
+  } else {
+    Kokkos::abort("Error: deep_copy between value types not implemented.");
   }
 #if defined(KOKKOS_ENABLE_PROFILING)
   if (Kokkos::Profiling::profileLibraryLoaded()) {
@@ -479,7 +585,370 @@ inline void deep_copy(
   }
 #endif
 }
-    
+
+namespace Impl {
+
+template <class LocalView, class RemoteView>
+inline void check_bulk_range(const LocalView &local, const RemoteView &remote,
+                             const int pe,
+                             const Kokkos::pair<size_t, size_t> &range) {
+  static_assert(!Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+                    typename RemoteView::memory_traits>::is_fixed_pe,
+                "Bulk copies by PE require a view with a PE dimension");
+  const Impl::PEPartition &partition = remote.impl_map().partition();
+  const int num_pes = partition.is_monolithic
+                          ? partition.num_pes
+                          : int(remote.impl_map().dimension_0());
+  // Segments of partitioned views differ in the number of leading rows
+  size_t remote_span = remote.span();
+  if (partition.is_partitioned() && partition.local_rows && pe >= 0 &&
+      pe < num_pes) {
+    const int target = remote.impl_map().pe_offset() + pe;
+    remote_span = remote_span / partition.local_rows *
+                  (partition.host_offsets[target + 1] -
+                   partition.host_offsets[target]);
+  }
+  if (pe < 0 || pe >= num_pes || range.second < range.first ||
+      range.second > remote_span || !local.span_is_contiguous() ||
+      local.span() < range.second - range.first) {
+    std::string message("Error: Kokkos::Experimental::deep_copy range of ");
+    message += remote.label();
+    message += " on PE ";
+    message += std::to_string(pe);
+    message += " [";
+    message += std::to_string(range.first);
+    message += ",";
+    message += std::to_string(range.second);
+    message += ") does not fit ";
+    message += local.label();
+    Kokkos::Impl::throw_runtime_exception(message);
+  }
+}
+
+} // namespace Impl
+
+//----------------------------------------------------------------------------
+/** \brief  Bulk copy between the contiguous element range [first, second)
+ *  of the segment owned by pe and a contiguous local view, issued as a
+ *  single transfer. The range indexes the flattened local segment of the
+ *  remote view, i.e. the span of v(pe, ...). Copies remote to local.
+ */
+template <class DT, class... DP, class ST, class... SP>
+inline void deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize, void>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr) {
+  typedef View<DT, DP...> dst_type;
+  typedef View<ST, SP...> src_type;
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename dst_type::non_const_value_type>::value,
+                "deep_copy requires non-const destination type");
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename src_type::non_const_value_type>::value,
+                "deep_copy requires Views of equal value type");
+
+  Impl::check_bulk_range(dst, src, pe, range);
+  if (range.second == range.first) return;
+
+  Kokkos::fence();
+  src.impl_map().handle().get(dst.data(), src.impl_map().pe_offset() + pe,
+                              range.first, range.second - range.first);
+  Kokkos::fence();
+}
+
+/** \brief  Copies local to remote, see above. */
+template <class DT, class... DP, class ST, class... SP>
+inline void deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        void>::value)>::type* = nullptr) {
+  typedef View<DT, DP...> dst_type;
+  typedef View<ST, SP...> src_type;
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename dst_type::non_const_value_type>::value,
+                "deep_copy requires non-const destination type");
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename src_type::non_const_value_type>::value,
+                "deep_copy requires Views of equal value type");
+
+  Impl::check_bulk_range(src, dst, pe, range);
+  if (range.second == range.first) return;
+
+  Kokkos::fence();
+  dst.impl_map().handle().put(src.data(), dst.impl_map().pe_offset() + pe,
+                              range.first, range.second - range.first);
+  Kokkos::fence();
+}
+
+//----------------------------------------------------------------------------
+/** \brief  Non-blocking bulk copy, see above. The transfer is ordered after
+ *  work previously submitted to exec and returns without waiting for its
+ *  completion. Neither view may be accessed before wait() or a successful
+ *  test() on the returned request. Copies remote to local.
+ */
+template <class ExecSpace, class DT, class... DP, class ST, class... SP>
+inline auto deep_copy(
+    const ExecSpace& exec, const View<DT, DP...>& dst,
+    const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        Kokkos::Impl::is_execution_space<ExecSpace>::value &&
+        std::is_same<typename ViewTraits<DT, DP...>::specialize, void>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr)
+    -> decltype(src.impl_map().handle().get_async(exec, dst.data(), pe,
+                                                  range.first, range.second)) {
+  typedef View<DT, DP...> dst_type;
+  typedef View<ST, SP...> src_type;
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename dst_type::non_const_value_type>::value,
+                "deep_copy requires non-const destination type");
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename src_type::non_const_value_type>::value,
+                "deep_copy requires Views of equal value type");
+
+  Impl::check_bulk_range(dst, src, pe, range);
+  exec.fence();
+  if (range.second == range.first)
+    return {};
+  return src.impl_map().handle().get_async(
+      exec, dst.data(), src.impl_map().pe_offset() + pe, range.first,
+      range.second - range.first);
+}
+
+/** \brief  Non-blocking copy of local to remote, see above. */
+template <class ExecSpace, class DT, class... DP, class ST, class... SP>
+inline auto deep_copy(
+    const ExecSpace& exec, const View<DT, DP...>& dst,
+    const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        Kokkos::Impl::is_execution_space<ExecSpace>::value &&
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        void>::value)>::type* = nullptr)
+    -> decltype(dst.impl_map().handle().put_async(exec, src.data(), pe,
+                                                  range.first, range.second)) {
+  typedef View<DT, DP...> dst_type;
+  typedef View<ST, SP...> src_type;
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename dst_type::non_const_value_type>::value,
+                "deep_copy requires non-const destination type");
+
+  static_assert(std::is_same<typename dst_type::value_type,
+                             typename src_type::non_const_value_type>::value,
+                "deep_copy requires Views of equal value type");
+
+  Impl::check_bulk_range(src, dst, pe, range);
+  exec.fence();
+  if (range.second == range.first)
+    return {};
+  return dst.impl_map().handle().put_async(
+      exec, src.data(), dst.impl_map().pe_offset() + pe, range.first,
+      range.second - range.first);
+}
+
+//----------------------------------------------------------------------------
+/** \brief  Team-level copy of the segment of src into the segment of dst.
+ *  Both views must be remote views of equal span. The segment is the local
+ *  one unless the view has a fixed PE, at most one side may address a
+ *  segment of another PE, which is then fetched or written in one block
+ *  transfer.
+ */
+template <class TeamType, class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const TeamType& team, const View<DT, DP...>& dst,
+    const View<ST, SP...>& src,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr) {
+  if (dst.data() == nullptr) return;
+  if (dst.span() != src.span())
+    Kokkos::abort("Error: local_deep_copy requires views of equal span.");
+
+  const size_t N = dst.span();
+  const int dst_pe = Impl::local_copy_pe(dst);
+  const int src_pe = Impl::local_copy_pe(src);
+  const bool dst_local = dst_pe == dst.impl_map().handle().impl_my_pe();
+  const bool src_local = src_pe == src.impl_map().handle().impl_my_pe();
+  if (!dst_local && !src_local)
+    Kokkos::abort("Error: local_deep_copy requires one view of the local PE.");
+  if (!src_local) {
+    src.impl_map().handle().team_get(team, dst.data(), src_pe, 0, N);
+  } else if (!dst_local) {
+    dst.impl_map().handle().team_put(team, src.data(), dst_pe, 0, N);
+  } else {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, N),
+                         [&](const int& i) { dst.data()[i] = src.data()[i]; });
+  }
+}
+
+/** \brief  Thread-level copy of the local segment, see above. */
+template <class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr) {
+  if (dst.data() == nullptr) return;
+  if (dst.span() != src.span())
+    Kokkos::abort("Error: local_deep_copy requires views of equal span.");
+
+  const size_t N = dst.span();
+  const int dst_pe = Impl::local_copy_pe(dst);
+  const int src_pe = Impl::local_copy_pe(src);
+  const bool dst_local = dst_pe == dst.impl_map().handle().impl_my_pe();
+  const bool src_local = src_pe == src.impl_map().handle().impl_my_pe();
+  if (!dst_local && !src_local)
+    Kokkos::abort("Error: local_deep_copy requires one view of the local PE.");
+  if (!src_local) {
+    src.impl_map().handle().thread_get(dst.data(), src_pe, 0, N);
+  } else if (!dst_local) {
+    dst.impl_map().handle().thread_put(src.data(), dst_pe, 0, N);
+  } else {
+    for (size_t i = 0; i < N; ++i) dst.data()[i] = src.data()[i];
+  }
+}
+
+/** \brief  Team-level block transfer between the contiguous element range
+ *  [first, second) of the segment owned by pe and a contiguous view local
+ *  to the executing team, e.g. team scratch. Must be called by all members
+ *  of the team. The data is complete for every member on return.
+ *  Copies remote to local.
+ */
+template <class TeamType, class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const TeamType& team, const View<DT, DP...>& dst,
+    const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize, void>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr) {
+  if (range.second <= range.first) return;
+  const int target = src.impl_map().pe_offset() + pe;
+  src.impl_map().handle().team_get(team, dst.data(), target, range.first,
+                                   range.second - range.first);
+}
+
+/** \brief  Copies local to remote, see above. */
+template <class TeamType, class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const TeamType& team, const View<DT, DP...>& dst,
+    const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        void>::value)>::type* = nullptr) {
+  if (range.second <= range.first) return;
+  const int target = dst.impl_map().pe_offset() + pe;
+  dst.impl_map().handle().team_put(team, src.data(), target, range.first,
+                                   range.second - range.first);
+}
+
+/** \brief  Thread-level block transfer, remote to local. */
+template <class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize, void>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value)>::type* =
+        nullptr) {
+  if (range.second <= range.first) return;
+  const int target = src.impl_map().pe_offset() + pe;
+  src.impl_map().handle().thread_get(dst.data(), target, range.first,
+                                     range.second - range.first);
+}
+
+/** \brief  Thread-level block transfer, local to remote. */
+template <class DT, class... DP, class ST, class... SP>
+void KOKKOS_INLINE_FUNCTION local_deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        void>::value)>::type* = nullptr) {
+  if (range.second <= range.first) return;
+  const int target = dst.impl_map().pe_offset() + pe;
+  dst.impl_map().handle().thread_put(src.data(), target, range.first,
+                                     range.second - range.first);
+}
+
+/** \brief  Team-level gather of scattered elements of the rank-2 remote
+ *  view src: dst(j) = src(pes(j), offsets(j)) for j < dst.extent(0).
+ *  pes, offsets and dst are contiguous views local to the executing team,
+ *  e.g. team scratch. Indices are grouped by PE and each group is fetched
+ *  with one indexed transfer (MPISpace) or as overlapping non-blocking
+ *  gets (SHMEM backends) instead of one blocking get per element. Must be
+ *  called by all members of the team. The data is complete for every
+ *  member on return.
+ */
+template <class TeamType, class ST, class... SP, class PT, class... PP,
+          class OT, class... OP, class DT, class... DP>
+void KOKKOS_INLINE_FUNCTION remote_gather(
+    const TeamType& team, const View<ST, SP...>& src,
+    const View<PT, PP...>& pes, const View<OT, OP...>& offsets,
+    const View<DT, DP...>& dst,
+    typename std::enable_if<(
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value &&
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+        void>::value)>::type* = nullptr) {
+  static_assert(ViewTraits<ST, SP...>::rank == 2,
+                "remote_gather requires a rank-2 remote view (pe, i)");
+  static_assert(std::is_same<typename ViewTraits<PT, PP...>::value_type,
+                             const int>::value ||
+                    std::is_same<typename ViewTraits<PT, PP...>::value_type,
+                                 int>::value,
+                "remote_gather requires PE indices of type int");
+  static_assert(std::is_same<typename ViewTraits<OT, OP...>::value_type,
+                             const size_t>::value ||
+                    std::is_same<typename ViewTraits<OT, OP...>::value_type,
+                                 size_t>::value,
+                "remote_gather requires offsets of type size_t");
+  const size_t n = dst.extent(0);
+  if (pes.extent(0) < n || offsets.extent(0) < n)
+    Kokkos::abort("Error: remote_gather requires an index per element.");
+  if (src.impl_map().partition().is_monolithic)
+    Kokkos::abort("Error: remote_gather does not support Monolithic views.");
+  if (src.impl_map().pe_offset() != 0)
+    Kokkos::abort("Error: remote_gather requires a view of all PEs.");
+  if (src.impl_map().stride_1() != 1)
+    Kokkos::abort("Error: remote_gather requires unit stride segments.");
+  src.impl_map().handle().team_gather(team, dst.data(), pes.data(),
+                                      offsets.data(), n);
+}
+
 } // Experimental
 } // Kokkos
 
@@ -0,0 +1,276 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_DISTRIBUTION_HPP_
+#define KOKKOS_REMOTESPACES_DISTRIBUTION_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <string>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Distribution policies of a GlobalView over all PEs.
+ *
+ *  Block:       contiguous blocks of BlockSize elements, one per PE.
+ *               BlockSize 0 selects ceil(N / num_pes) at run time.
+ *  Cyclic:      element i is owned by PE i % num_pes.
+ *  BlockCyclic: blocks of BlockSize elements dealt round robin.
+ *
+ *  Compile time block sizes that are powers of two reduce the PE and
+ *  offset computation to shifts and masks.
+ */
+template <size_t BlockSize = 0> struct Block {};
+struct Cyclic {};
+template <size_t BlockSize> struct BlockCyclic {};
+
+namespace Impl {
+
+template <size_t N> struct is_power_of_two {
+  enum : bool { value = (N != 0) && ((N & (N - 1)) == 0) };
+};
+
+template <size_t N> struct integral_log2 {
+  enum : unsigned { value = 1 + integral_log2<N / 2>::value };
+};
+
+template <> struct integral_log2<1> {
+  enum : unsigned { value = 0 };
+};
+
+/* Quotient and remainder by a divisor known at compile time */
+template <size_t D, bool = is_power_of_two<D>::value> struct static_divisor {
+  KOKKOS_INLINE_FUNCTION static size_t div(const size_t i) { return i / D; }
+  KOKKOS_INLINE_FUNCTION static size_t mod(const size_t i) { return i % D; }
+};
+
+template <size_t D> struct static_divisor<D, true> {
+  KOKKOS_INLINE_FUNCTION static size_t div(const size_t i) {
+    return i >> integral_log2<D>::value;
+  }
+  KOKKOS_INLINE_FUNCTION static size_t mod(const size_t i) {
+    return i & (D - 1);
+  }
+};
+
+/* Quotient and remainder by a divisor known at run time. Powers of two
+ * still avoid the division. */
+struct runtime_divisor {
+  size_t d;
+  size_t mask;
+  unsigned shift;
+  bool is_power_of_two;
+
+  KOKKOS_INLINE_FUNCTION
+  runtime_divisor() : d(1), mask(0), shift(0), is_power_of_two(true) {}
+
+  KOKKOS_INLINE_FUNCTION
+  explicit runtime_divisor(const size_t d_)
+      : d(d_ ? d_ : 1), mask(0), shift(0), is_power_of_two(false) {
+    is_power_of_two = (d & (d - 1)) == 0;
+    mask = d - 1;
+    while ((size_t(1) << shift) < d)
+      shift++;
+  }
+
+  KOKKOS_INLINE_FUNCTION size_t div(const size_t i) const {
+    return is_power_of_two ? i >> shift : i / d;
+  }
+  KOKKOS_INLINE_FUNCTION size_t mod(const size_t i) const {
+    return is_power_of_two ? i & mask : i % d;
+  }
+};
+
+} // namespace Impl
+
+/** \brief  Maps a global index to its owning PE and the offset within
+ *          that PE's segment, and back. */
+template <class Distribution> struct DistributionMap;
+
+template <> struct DistributionMap<Block<0>> {
+  Impl::runtime_divisor block;
+
+  DistributionMap() = default;
+  DistributionMap(const size_t n, const int num_pes)
+      : block((n + num_pes - 1) / num_pes) {}
+
+  size_t local_extent() const { return block.d; }
+  KOKKOS_INLINE_FUNCTION int pe(const size_t i) const { return block.div(i); }
+  KOKKOS_INLINE_FUNCTION size_t offset(const size_t i) const {
+    return block.mod(i);
+  }
+  KOKKOS_INLINE_FUNCTION size_t global_index(const int pe,
+                                             const size_t offset) const {
+    return pe * block.d + offset;
+  }
+};
+
+template <size_t BlockSize> struct DistributionMap<Block<BlockSize>> {
+  typedef Impl::static_divisor<BlockSize> block;
+
+  DistributionMap() = default;
+  DistributionMap(const size_t n, const int num_pes) {
+    if (n > BlockSize * num_pes)
+      Kokkos::Impl::throw_runtime_exception(
+          "Kokkos::Experimental::Block: global extent exceeds BlockSize "
+          "times the number of PEs");
+  }
+
+  size_t local_extent() const { return BlockSize; }
+  KOKKOS_INLINE_FUNCTION int pe(const size_t i) const {
+    return block::div(i);
+  }
+  KOKKOS_INLINE_FUNCTION size_t offset(const size_t i) const {
+    return block::mod(i);
+  }
+  KOKKOS_INLINE_FUNCTION size_t global_index(const int pe,
+                                             const size_t offset) const {
+    return pe * BlockSize + offset;
+  }
+};
+
+template <> struct DistributionMap<Cyclic> {
+  Impl::runtime_divisor pes;
+  size_t local;
+
+  DistributionMap() = default;
+  DistributionMap(const size_t n, const int num_pes)
+      : pes(num_pes), local((n + num_pes - 1) / num_pes) {}
+
+  size_t local_extent() const { return local; }
+  KOKKOS_INLINE_FUNCTION int pe(const size_t i) const { return pes.mod(i); }
+  KOKKOS_INLINE_FUNCTION size_t offset(const size_t i) const {
+    return pes.div(i);
+  }
+  KOKKOS_INLINE_FUNCTION size_t global_index(const int pe,
+                                             const size_t offset) const {
+    return offset * pes.d + pe;
+  }
+};
+
+template <size_t BlockSize> struct DistributionMap<BlockCyclic<BlockSize>> {
+  static_assert(BlockSize > 0, "BlockCyclic requires a non-zero BlockSize");
+  typedef Impl::static_divisor<BlockSize> block;
+  Impl::runtime_divisor pes;
+  size_t local;
+
+  DistributionMap() = default;
+  DistributionMap(const size_t n, const int num_pes) : pes(num_pes) {
+    const size_t num_blocks = (n + BlockSize - 1) / BlockSize;
+    local = (num_blocks + num_pes - 1) / num_pes * BlockSize;
+  }
+
+  size_t local_extent() const { return local; }
+  KOKKOS_INLINE_FUNCTION int pe(const size_t i) const {
+    return pes.mod(block::div(i));
+  }
+  KOKKOS_INLINE_FUNCTION size_t offset(const size_t i) const {
+    return pes.div(block::div(i)) * BlockSize + block::mod(i);
+  }
+  KOKKOS_INLINE_FUNCTION size_t global_index(const int pe,
+                                             const size_t offset) const {
+    return (block::div(offset) * pes.d + pe) * BlockSize + block::mod(offset);
+  }
+};
+
+/** \brief  Rank-1 remote view addressed by a global index.
+ *
+ *  The elements are distributed over all PEs according to Distribution
+ *  and stored in a symmetric view of extents (num_pes, local_extent()).
+ *  Segments may be padded; global indices at or past extent(0) must not
+ *  be accessed.
+ */
+template <class DataType, class Distribution,
+          class MemorySpace = DefaultRemoteMemorySpace,
+          class MemoryTraits = Kokkos::MemoryTraits<0>>
+class GlobalView {
+public:
+  typedef DistributionMap<Distribution> map_type;
+  typedef Kokkos::View<DataType **, MemorySpace, MemoryTraits> view_type;
+  typedef typename view_type::reference_type reference_type;
+  typedef typename view_type::memory_space memory_space;
+  typedef typename view_type::execution_space execution_space;
+
+  GlobalView() = default;
+
+  /** \brief  Allocates n elements distributed over the PEs of scope.
+   *          Collective over them. */
+  GlobalView(const std::string &label, const size_t n,
+             const memory_space &scope = memory_space())
+      : m_extent(n) {
+    const int num_pes = scope.impl_num_pes();
+    m_map = map_type(n, num_pes);
+    m_view = allocate_symmetric_remote_view<view_type>(
+        label.c_str(), scope, num_pes, m_map.local_extent());
+  }
+
+  KOKKOS_INLINE_FUNCTION reference_type operator()(const size_t i) const {
+    return m_view(m_map.pe(i), m_map.offset(i));
+  }
+
+  KOKKOS_INLINE_FUNCTION size_t extent(const int r) const {
+    return r == 0 ? m_extent : 1;
+  }
+  KOKKOS_INLINE_FUNCTION size_t size() const { return m_extent; }
+
+  /** \brief  Number of elements reserved in each PE's segment */
+  KOKKOS_INLINE_FUNCTION size_t local_extent() const {
+    return m_view.extent(1);
+  }
+
+  KOKKOS_INLINE_FUNCTION const map_type &map() const { return m_map; }
+  KOKKOS_INLINE_FUNCTION const view_type &view() const { return m_view; }
+  std::string label() const { return m_view.label(); }
+
+private:
+  view_type m_view;
+  map_type m_map;
+  size_t m_extent = 0;
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_DISTRIBUTION_HPP_
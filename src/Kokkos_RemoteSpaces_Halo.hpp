@@ -0,0 +1,217 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_HALO_HPP_
+#define KOKKOS_REMOTESPACES_HALO_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Inspector/executor exchange of a fixed set of elements of a
+ *          rank-2 remote view (pe, i) into a local ghost buffer.
+ *
+ *  The constructor (inspector) is given the elements a computation reads,
+ *  as a list of PE indices and segment offsets, e.g. the columns of a
+ *  sparse matrix. The list may repeat elements and reference the segment
+ *  of the calling PE. The inspector keeps every remote element once,
+ *  ordered by PE and offset, and merges consecutive offsets into a single
+ *  transfer. exchange() (executor) then refreshes values(), which holds
+ *  the local segment followed by the remote elements, with one transfer
+ *  per run. All runs are issued before any is waited for.
+ *
+ *  local_index()(k) is the position of the k-th listed element in
+ *  values(), so the computation can address it without remote accesses:
+ *
+ *    HaloPlan<RemoteView> plan(x, pes, offsets);
+ *    for (...) {
+ *      plan.exchange();
+ *      // x(pes(k), offsets(k)) == plan.values()(plan.local_index()(k))
+ *    }
+ *
+ *  exchange() is collective over the PEs of the view: it fences the
+ *  memory space before reading, so that prior writes of all PEs are
+ *  visible, and after reading, so that PEs may overwrite the exchanged
+ *  elements once it returns. Copies of a HaloPlan share its buffers.
+ */
+template <class ViewType> class HaloPlan {
+public:
+  typedef ViewType view_type;
+  typedef typename view_type::non_const_value_type value_type;
+  typedef typename view_type::memory_space memory_space;
+  typedef typename view_type::execution_space execution_space;
+  typedef Kokkos::View<value_type *, execution_space> values_type;
+  typedef Kokkos::View<size_t *, execution_space> index_type;
+
+  static_assert(view_type::Rank == 2,
+                "HaloPlan requires a rank-2 view indexed by (pe, i)");
+
+  HaloPlan() = default;
+
+  /** \brief  Inspects the elements (pes(k), offsets(k)) of v. pes and
+   *          offsets are rank-1 views of equal extent in any memory
+   *          space. */
+  template <class PEView, class OffsetView>
+  HaloPlan(const view_type &v, const PEView &pes, const OffsetView &offsets)
+      : m_view(v) {
+    if (v.impl_map().partition().is_monolithic)
+      Kokkos::abort("HaloPlan: Monolithic views are not supported.");
+    if (v.impl_map().stride_1() != 1)
+      Kokkos::abort("HaloPlan: requires unit stride segments.");
+    if (pes.extent(0) != offsets.extent(0))
+      Kokkos::abort("HaloPlan: requires a PE index per offset.");
+    m_my_pe = memory_space::impl_my_pe(v.impl_map().handle().scope) -
+              v.impl_map().pe_offset();
+    m_num_local = segment_extent(m_my_pe);
+
+    auto h_pes = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), pes);
+    auto h_offsets =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), offsets);
+    const size_t n = h_pes.extent(0);
+
+    typedef std::pair<int, size_t> element_type;
+    std::vector<element_type> ghosts;
+    for (size_t k = 0; k < n; k++)
+      if (int(h_pes(k)) != m_my_pe)
+        ghosts.push_back(element_type(h_pes(k), h_offsets(k)));
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    m_num_ghosts = ghosts.size();
+
+    for (size_t g = 0; g < ghosts.size(); g++) {
+      if (!m_runs.empty() && m_runs.back().pe == ghosts[g].first &&
+          m_runs.back().first + m_runs.back().count == ghosts[g].second) {
+        m_runs.back().count++;
+        continue;
+      }
+      Run run = {ghosts[g].first, ghosts[g].second, 1, m_num_local + g};
+      m_runs.push_back(run);
+    }
+
+    m_index = index_type(
+        Kokkos::view_alloc(v.label() + "_halo_index",
+                           Kokkos::WithoutInitializing),
+        n);
+    auto h_index = Kokkos::create_mirror_view(m_index);
+    for (size_t k = 0; k < n; k++) {
+      const element_type e(h_pes(k), h_offsets(k));
+      h_index(k) = e.first == m_my_pe
+                       ? e.second
+                       : m_num_local +
+                             (std::lower_bound(ghosts.begin(), ghosts.end(),
+                                               e) -
+                              ghosts.begin());
+    }
+    Kokkos::deep_copy(m_index, h_index);
+    m_values = values_type(v.label() + "_halo", m_num_local + m_num_ghosts);
+  }
+
+  /** \brief  Refreshes values() from the remote view. Collective. */
+  void exchange() const {
+    typedef typename Kokkos::Impl::ViewDataHandle<
+        typename view_type::traits>::handle_type::request_type request_type;
+    typedef Kokkos::View<const value_type *,
+                         typename execution_space::memory_space,
+                         Kokkos::MemoryUnmanaged>
+        segment_type;
+    memory_space().fence(m_view);
+    const Kokkos::pair<size_t, size_t> local(0, m_num_local);
+    Kokkos::deep_copy(Kokkos::subview(m_values, local),
+                      segment_type(m_view.data(), m_num_local));
+    execution_space exec;
+    std::vector<request_type> requests;
+    requests.reserve(m_runs.size());
+    for (const Run &run : m_runs)
+      requests.push_back(m_view.impl_map().handle().get_async(
+          exec, m_values.data() + run.pos,
+          m_view.impl_map().pe_offset() + run.pe, run.first, run.count));
+    for (request_type &req : requests)
+      req.wait();
+    memory_space().fence(m_view);
+  }
+
+  /** \brief  Local segment followed by the remote elements */
+  const values_type &values() const { return m_values; }
+  /** \brief  Position of each inspected element in values() */
+  const index_type &local_index() const { return m_index; }
+
+  size_t num_local() const { return m_num_local; }
+  size_t num_ghosts() const { return m_num_ghosts; }
+  /** \brief  Transfers issued by exchange() */
+  size_t num_transfers() const { return m_runs.size(); }
+
+private:
+  /* Consecutive remote elements, stored from position pos of values() */
+  struct Run {
+    int pe;
+    size_t first;
+    size_t count;
+    size_t pos;
+  };
+
+  /* Number of elements of the segment of pe, which differs across PEs
+   * for Asymmetric views */
+  size_t segment_extent(const int pe) const {
+    const Impl::PEPartition &partition = m_view.impl_map().partition();
+    if (partition.is_partitioned())
+      return partition.host_offsets[pe + 1] - partition.host_offsets[pe];
+    return m_view.impl_map().dimension_1();
+  }
+
+  view_type m_view;
+  values_type m_values;
+  index_type m_index;
+  std::vector<Run> m_runs;
+  size_t m_num_local = 0;
+  size_t m_num_ghosts = 0;
+  int m_my_pe = 0;
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_HALO_HPP_
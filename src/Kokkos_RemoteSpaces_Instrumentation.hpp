@@ -0,0 +1,351 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_INSTRUMENTATION_HPP_
+#define KOKKOS_REMOTESPACES_INSTRUMENTATION_HPP_
+
+#include <Kokkos_Core.hpp>
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+
+#include <Kokkos_Timer.hpp>
+#include <mpi.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+#include <cuda_runtime.h>
+#endif
+
+namespace Kokkos {
+namespace Experimental {
+namespace Impl {
+
+/** \brief  Access counters of one allocation of a remote memory space.
+ *
+ *  Element accesses and bulk transfers are counted per kind and target
+ *  PE, where the PE is the one passed to the communication layer.
+ *  Accesses of memory the calling PE can address directly, its own
+ *  segment or that of an on-node peer, are counted as local in the extra
+ *  slot num_pes. The counters live in memory accessible from the
+ *  execution spaces of the backend and are updated atomically.
+ */
+struct RemoteAccessCounters {
+  enum Kind : int { Get, Put, Atomic, num_kinds };
+
+  int num_pes;
+  // Indexed by kind * (num_pes + 1) + slot
+  unsigned long long *ops;
+  unsigned long long *bytes;
+
+  KOKKOS_INLINE_FUNCTION
+  void count(const int kind, const int pe, const bool is_local,
+             const size_t nbytes) const {
+    const int slot = kind * (num_pes + 1) + (is_local ? num_pes : pe);
+    Kokkos::atomic_add(&ops[slot], (unsigned long long)1);
+    Kokkos::atomic_add(&bytes[slot], (unsigned long long)nbytes);
+  }
+
+  size_t num_slots() const { return num_kinds * (num_pes + 1); }
+};
+
+/** \brief  Totals of the accesses to the allocations of one label,
+ *          indexed as in RemoteAccessCounters with world PEs. */
+struct RemoteAccessTotals {
+  std::vector<unsigned long long> ops;
+  std::vector<unsigned long long> bytes;
+};
+
+struct RemoteFenceTotals {
+  unsigned long long calls;
+  double seconds;
+  RemoteFenceTotals() : calls(0), seconds(0.0) {}
+};
+
+/** \brief  Per-rank registry of access counters and fence timings.
+ *
+ *  Counters of live allocations are folded into the totals of their
+ *  label when the allocation is released. The statistics are reported
+ *  at Kokkos::finalize, to the file <prefix>.<rank>.txt if the
+ *  environment variable KOKKOS_REMOTE_SPACES_STATISTICS is set to
+ *  <prefix> and to stdout otherwise.
+ */
+class RemoteAccessRegistry {
+  struct Entry {
+    std::string label;
+    // World PE of each counter slot
+    std::vector<int> world_pes;
+  };
+
+  std::mutex m_mutex;
+  int m_world_size;
+  std::map<RemoteAccessCounters *, Entry> m_live;
+  std::map<std::string, RemoteAccessTotals> m_totals;
+  std::map<std::string, RemoteFenceTotals> m_fences;
+
+  RemoteAccessRegistry() : m_world_size(0) {
+    Kokkos::push_finalize_hook([]() { instance().report(); });
+  }
+
+  static void sync_counters() {
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+    cudaDeviceSynchronize();
+#endif
+  }
+
+  void fold(RemoteAccessTotals &totals, const RemoteAccessCounters &c,
+            const std::vector<int> &world_pes) const {
+    const int n = m_world_size + 1;
+    if (totals.ops.empty()) {
+      totals.ops.assign(RemoteAccessCounters::num_kinds * n, 0);
+      totals.bytes.assign(RemoteAccessCounters::num_kinds * n, 0);
+    }
+    for (int kind = 0; kind < RemoteAccessCounters::num_kinds; kind++)
+      for (int slot = 0; slot <= c.num_pes; slot++) {
+        const int dst = kind * n + (slot == c.num_pes ? m_world_size
+                                                       : world_pes[slot]);
+        const int src = kind * (c.num_pes + 1) + slot;
+        totals.ops[dst] += c.ops[src];
+        totals.bytes[dst] += c.bytes[src];
+      }
+  }
+
+public:
+  static RemoteAccessRegistry &instance() {
+    static RemoteAccessRegistry registry;
+    return registry;
+  }
+
+  /* Counters of an allocation labeled label whose communication layer
+   * addresses PE p as world PE world_pes[p] */
+  RemoteAccessCounters *create(const std::string &label,
+                               const std::vector<int> &world_pes) {
+    RemoteAccessCounters *c = new RemoteAccessCounters;
+    c->num_pes = world_pes.size();
+    const size_t size = 2 * c->num_slots() * sizeof(unsigned long long);
+    void *data;
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+    cudaMallocManaged(&data, size);
+#else
+    data = std::malloc(size);
+#endif
+    std::memset(data, 0, size);
+    c->ops = static_cast<unsigned long long *>(data);
+    c->bytes = c->ops + c->num_slots();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_world_size == 0)
+      MPI_Comm_size(MPI_COMM_WORLD, &m_world_size);
+    Entry &entry = m_live[c];
+    entry.label = label;
+    entry.world_pes = world_pes;
+    return c;
+  }
+
+  /* Folds the counters into the totals of their label and frees them */
+  void retire(RemoteAccessCounters *c) {
+    if (!c)
+      return;
+    sync_counters();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_live.find(c);
+      fold(m_totals[it->second.label], *c, it->second.world_pes);
+      m_live.erase(it);
+    }
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+    cudaFree(c->ops);
+#else
+    std::free(c->ops);
+#endif
+    delete c;
+  }
+
+  void add_fence(const char *name, const double seconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RemoteFenceTotals &totals = m_fences[name];
+    totals.calls++;
+    totals.seconds += seconds;
+  }
+
+  /* Statistics of released and live allocations and of fences */
+  void print(std::ostream &os) {
+    sync_counters();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string, RemoteAccessTotals> totals = m_totals;
+    for (auto &live : m_live)
+      fold(totals[live.second.label], *live.first, live.second.world_pes);
+
+    const int n = m_world_size + 1;
+    const char *kind_names[] = {"get", "put", "atomic"};
+    for (auto &view : totals) {
+      const RemoteAccessTotals &t = view.second;
+      unsigned long long local_ops = 0, local_bytes = 0;
+      unsigned long long remote_ops = 0, remote_bytes = 0;
+      for (int kind = 0; kind < RemoteAccessCounters::num_kinds; kind++)
+        for (int slot = 0; slot < n; slot++) {
+          const int i = kind * n + slot;
+          if (slot == m_world_size) {
+            local_ops += t.ops[i];
+            local_bytes += t.bytes[i];
+          } else {
+            remote_ops += t.ops[i];
+            remote_bytes += t.bytes[i];
+          }
+        }
+      const unsigned long long all_ops = local_ops + remote_ops;
+      os << "view \"" << view.first << "\": local " << local_ops << " ops "
+         << local_bytes << " B, remote " << remote_ops << " ops "
+         << remote_bytes << " B, local ratio "
+         << (all_ops ? double(local_ops) / all_ops : 0.0) << "\n";
+      for (int pe = 0; pe < m_world_size; pe++) {
+        bool accessed = false;
+        for (int kind = 0; kind < RemoteAccessCounters::num_kinds; kind++)
+          accessed |= t.ops[kind * n + pe] != 0;
+        if (!accessed)
+          continue;
+        os << "  pe " << pe << ":";
+        for (int kind = 0; kind < RemoteAccessCounters::num_kinds; kind++)
+          os << " " << kind_names[kind] << " " << t.ops[kind * n + pe]
+             << " (" << t.bytes[kind * n + pe] << " B)";
+        os << "\n";
+      }
+    }
+    for (auto &fence : m_fences)
+      os << "fence " << fence.first << ": " << fence.second.calls
+         << " calls, " << fence.second.seconds << " s\n";
+  }
+
+  void report() {
+    int initialized, finalized, rank = 0;
+    MPI_Initialized(&initialized);
+    MPI_Finalized(&finalized);
+    if (initialized && !finalized)
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::ostringstream os;
+    print(os);
+    const char *prefix = std::getenv("KOKKOS_REMOTE_SPACES_STATISTICS");
+    if (prefix) {
+      std::ofstream file(std::string(prefix) + "." + std::to_string(rank) +
+                         ".txt");
+      file << os.str();
+    } else {
+      std::istringstream lines(os.str());
+      std::string line;
+      std::ostringstream out;
+      while (std::getline(lines, line))
+        out << "[" << rank << "] " << line << "\n";
+      std::cout << out.str() << std::flush;
+    }
+  }
+};
+
+/** \brief  Times a fence of a remote memory space for the registry. The
+ *          fence is also reported as a region to a loaded Kokkos Tools
+ *          library. */
+class RemoteFenceTimer {
+  const char *m_name;
+  Kokkos::Timer m_timer;
+
+public:
+  RemoteFenceTimer(const char *name) : m_name(name) {
+#if defined(KOKKOS_ENABLE_PROFILING)
+    if (Kokkos::Profiling::profileLibraryLoaded())
+      Kokkos::Profiling::pushRegion(name);
+#endif
+    m_timer.reset();
+  }
+
+  ~RemoteFenceTimer() {
+    const double seconds = m_timer.seconds();
+#if defined(KOKKOS_ENABLE_PROFILING)
+    if (Kokkos::Profiling::profileLibraryLoaded())
+      Kokkos::Profiling::popRegion();
+#endif
+    RemoteAccessRegistry::instance().add_fence(m_name, seconds);
+  }
+};
+
+} // namespace Impl
+
+/** \brief  Prints the access statistics of remote views and the fence
+ *          timings of the calling rank, as done at Kokkos::finalize. */
+inline void print_remote_access_statistics(std::ostream &os) {
+  Impl::RemoteAccessRegistry::instance().print(os);
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#define KOKKOS_REMOTE_SPACES_COUNT(counters, kind, pe, is_local, nbytes)       \
+  do {                                                                         \
+    if (counters)                                                              \
+      counters->count(                                                         \
+          Kokkos::Experimental::Impl::RemoteAccessCounters::kind, pe,          \
+          is_local, nbytes);                                                   \
+  } while (0)
+
+#define KOKKOS_REMOTE_SPACES_FENCE_TIMER(name)                                 \
+  Kokkos::Experimental::Impl::RemoteFenceTimer remote_fence_timer(name)
+
+#else
+
+#define KOKKOS_REMOTE_SPACES_COUNT(counters, kind, pe, is_local, nbytes)       \
+  do {                                                                         \
+  } while (0)
+
+#define KOKKOS_REMOTE_SPACES_FENCE_TIMER(name)                                 \
+  do {                                                                         \
+  } while (0)
+
+#endif // KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+
+#endif // KOKKOS_REMOTESPACES_INSTRUMENTATION_HPP_
@@ -0,0 +1,216 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_OPTIONS_HPP_
+#define KOKKOS_REMOTESPACES_OPTIONS_HPP_
+
+#include <Kokkos_Core.hpp>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Allocation policies of remote memory spaces.
+ *
+ *  Symmetric:       every PE owns a segment of the same extents. The
+ *                   leading view index selects the PE.
+ *  Asymmetric:      as Symmetric, but the first extent after the PE index
+ *                   may differ between PEs.
+ *  Monolithic:      the leading index is global; each PE owns a contiguous
+ *                   block of rows of its chosen size and the view maps a
+ *                   global row to its owner.
+ *  SymmetricShared: a symmetric allocation whose on-node segments are
+ *                   directly addressable by peers on the same node.
+ */
+enum { Monolithic, Symmetric, Asymmetric, SymmetricShared };
+
+/** \brief  Operations combining a new value with the value at a remote
+ *          location, used by aggregated updates and collectives. */
+enum RemoteSpaces_Op { OpReplace, OpSum, OpProd, OpMin, OpMax };
+
+/** \brief  Updates of a signal by put_signal and remote_signal. */
+enum RemoteSpaces_SignalOp { SignalSet, SignalAdd };
+
+/** \brief  Conditions a signal is waited for by signal_wait_until. */
+enum RemoteSpaces_Cmp { CmpEQ, CmpNE, CmpGT, CmpGE, CmpLT, CmpLE };
+
+/** \brief  Memory traits understood by remote spaces in addition to
+ *          Kokkos::MemoryTraitsFlags. Bits start above the Kokkos flags
+ *          and may be combined with them, e.g.
+ *          Kokkos::MemoryTraits<Kokkos::Unmanaged | DeferredPut>.
+ */
+enum RemoteSpaces_MemoryTraitsFlags : unsigned {
+  /* Element stores are only completed locally; remote completion
+   * is deferred to the next fence of the memory space. */
+  DeferredPut = 0x100,
+  /* Set on subviews taken at a single PE index. Such views address the
+   * segment of that PE only and their indices exclude the PE dimension. */
+  FixedPE = 0x200,
+  /* Accesses are known to target other PEs. Element access skips the
+   * local PE check and always goes through the communication layer. */
+  RemoteOnly = 0x400,
+  /* Elements are only read while the view is in use. Element access
+   * yields a reference that only converts to a value and may load
+   * through non-coherent paths. Implied by a const value type. */
+  ReadOnly = 0x800,
+  /* Elements are only written. Element access yields a reference that
+   * only supports assignment and whose stores complete remotely at the
+   * next fence of the memory space. */
+  WriteOnly = 0x1000,
+  /* Element stores and non-fetching updates are not ordered with other
+   * accesses of the calling PE until the next fence of the memory
+   * space. */
+  Relaxed = 0x2000
+};
+
+template <typename MemoryTraits> struct RemoteSpaces_MemoryTraits;
+
+template <unsigned T>
+struct RemoteSpaces_MemoryTraits<Kokkos::MemoryTraits<T>> {
+  enum : bool {
+    is_deferred_put = (unsigned(0) != (T & unsigned(DeferredPut))),
+    is_fixed_pe = (unsigned(0) != (T & unsigned(FixedPE))),
+    is_remote_only = (unsigned(0) != (T & unsigned(RemoteOnly))),
+    is_read_only = (unsigned(0) != (T & unsigned(ReadOnly))),
+    is_write_only = (unsigned(0) != (T & unsigned(WriteOnly))),
+    is_relaxed = (unsigned(0) != (T & unsigned(Relaxed)))
+  };
+  enum : unsigned { state = T };
+};
+
+namespace Impl {
+
+/** \brief  Extents and element strides of a possibly non-contiguous view.
+ *          Elements are enumerated with the last index running fastest;
+ *          offset(k) is the position of the k-th element relative to the
+ *          first one.
+ */
+struct StridedLayout {
+  int rank;
+  size_t extent[8];
+  size_t stride[8];
+
+  KOKKOS_INLINE_FUNCTION size_t size() const {
+    size_t n = 1;
+    for (int r = 0; r < rank; r++)
+      n *= extent[r];
+    return n;
+  }
+
+  KOKKOS_INLINE_FUNCTION size_t offset(size_t k) const {
+    size_t off = 0;
+    for (int r = rank - 1; r >= 0; r--) {
+      off += (k % extent[r]) * stride[r];
+      k /= extent[r];
+    }
+    return off;
+  }
+
+  /* One past the largest offset. Requires size() > 0. */
+  KOKKOS_INLINE_FUNCTION size_t span() const {
+    size_t last = 0;
+    for (int r = 0; r < rank; r++)
+      last += (extent[r] - 1) * stride[r];
+    return last + 1;
+  }
+
+  /* Elements cover [0, size()) without gaps, in some order */
+  KOKKOS_INLINE_FUNCTION bool is_contiguous() const {
+    return size() == 0 || span() == size();
+  }
+};
+
+/** \brief  Host copy between two strided buffers of equal extents */
+template <class T>
+inline void strided_copy(T *dst, const StridedLayout &dst_layout,
+                         const T *src, const StridedLayout &src_layout) {
+  const size_t n = src_layout.size();
+  for (size_t k = 0; k < n; k++)
+    dst[dst_layout.offset(k)] = src[src_layout.offset(k)];
+}
+
+/** \brief  Element reference type of a remote view: Read for views of a
+ *          const value type or with ReadOnly, Write for views with
+ *          WriteOnly and Full otherwise. Each space supplies its three
+ *          reference templates. */
+template <class T, class Traits, template <class, class> class Full,
+          template <class, class> class Read,
+          template <class, class> class Write>
+struct remote_element {
+  typedef RemoteSpaces_MemoryTraits<typename Traits::memory_traits>
+      traits_type;
+  enum : bool {
+    is_read = traits_type::is_read_only || std::is_const<T>::value,
+    is_write = traits_type::is_write_only
+  };
+  static_assert(!(is_read && is_write),
+                "Remote views cannot be both ReadOnly and WriteOnly");
+  typedef typename std::conditional<
+      is_read, Read<T, Traits>,
+      typename std::conditional<is_write, Write<T, Traits>,
+                                Full<T, Traits>>::type>::type type;
+};
+
+/** \brief  Evaluates the condition cmp of signal_wait_until */
+KOKKOS_INLINE_FUNCTION bool signal_compare(const uint64_t value, const int cmp,
+                                           const uint64_t cmp_value) {
+  switch (cmp) {
+  case CmpEQ: return value == cmp_value;
+  case CmpNE: return value != cmp_value;
+  case CmpGT: return value > cmp_value;
+  case CmpGE: return value >= cmp_value;
+  case CmpLT: return value < cmp_value;
+  default: return value <= cmp_value;
+  }
+}
+
+/** \brief  Collectives of a remote memory space over the local segments
+ *          of symmetric allocations. Specialized by each space. */
+template <class MemorySpace> struct RemoteCollectives;
+
+} // namespace Impl
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_OPTIONS_HPP_
@@ -0,0 +1,158 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_PARTITION_HPP_
+#define KOKKOS_REMOTESPACES_PARTITION_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <vector>
+
+namespace Kokkos {
+namespace Experimental {
+namespace Impl {
+
+/** \brief  Distribution of the leading rows of an Asymmetric or Monolithic
+ *          allocation. PE p owns rows [offsets[p], offsets[p+1]).
+ *
+ *  For Asymmetric views a row is an index of the first dimension after the
+ *  PE index, for Monolithic views an index of the global first dimension.
+ *  Symmetric views carry an empty partition.
+ */
+struct PEPartition {
+  // num_pes + 1 prefix offsets accessible from the execution space
+  const size_t *offsets;
+  // Same table in host memory
+  const size_t *host_offsets;
+  int num_pes;
+  bool is_monolithic;
+  size_t local_rows;
+  size_t global_rows;
+
+  KOKKOS_INLINE_FUNCTION
+  PEPartition()
+      : offsets(NULL), host_offsets(NULL), num_pes(0), is_monolithic(false),
+        local_rows(0), global_rows(0) {}
+
+  KOKKOS_INLINE_FUNCTION
+  PEPartition(const size_t *offsets_, const size_t *host_offsets_,
+              const int num_pes_, const bool is_monolithic_,
+              const size_t local_rows_, const size_t global_rows_)
+      : offsets(offsets_), host_offsets(host_offsets_), num_pes(num_pes_),
+        is_monolithic(is_monolithic_), local_rows(local_rows_),
+        global_rows(global_rows_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  bool is_partitioned() const { return offsets != NULL; }
+
+  /** \brief  PE owning global row i, by binary search of the offsets */
+  KOKKOS_INLINE_FUNCTION
+  int owner(const size_t i) const {
+    int lo = 0, hi = num_pes;
+    while (hi - lo > 1) {
+      const int mid = (lo + hi) / 2;
+      if (offsets[mid] <= i)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+};
+
+/** \brief  Exchanges the number of rows owned by every PE. Collective
+ *  over comm, whose ranks are the PEs. Returns the num_pes + 1 prefix
+ *  offsets in host memory allocated with new[].
+ */
+inline size_t *allgather_pe_offsets(const size_t local_rows,
+                                    MPI_Comm comm = MPI_COMM_WORLD) {
+  int num_pes;
+  MPI_Comm_size(comm, &num_pes);
+  unsigned long long rows = local_rows;
+  std::vector<unsigned long long> all_rows(num_pes);
+  MPI_Allgather(&rows, 1, MPI_UNSIGNED_LONG_LONG, all_rows.data(), 1,
+                MPI_UNSIGNED_LONG_LONG, comm);
+  size_t *offsets = new size_t[num_pes + 1];
+  offsets[0] = 0;
+  for (int pe = 0; pe < num_pes; pe++)
+    offsets[pe + 1] = offsets[pe] + all_rows[pe];
+  return offsets;
+}
+
+/** \brief  Largest allocation size requested by any PE. Used by backends
+ *  whose symmetric heap requires equal sizes on all PEs. */
+inline size_t allreduce_max_size(const size_t size) {
+  unsigned long long local = size, global = 0;
+  MPI_Allreduce(&local, &global, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+                MPI_COMM_WORLD);
+  return global;
+}
+
+} // namespace Impl
+
+/** \brief  Rows [first, second) owned by pe. For Monolithic views these
+ *  are indices of the global first dimension; for Asymmetric views the
+ *  position of the rows of pe in the concatenation of all PEs. */
+template <class ViewType>
+inline Kokkos::pair<size_t, size_t> get_range(const ViewType &v,
+                                              const int pe) {
+  const Impl::PEPartition &partition = v.impl_map().partition();
+  if (partition.is_partitioned())
+    return Kokkos::pair<size_t, size_t>(partition.host_offsets[pe],
+                                        partition.host_offsets[pe + 1]);
+  const size_t rows = v.impl_map().dimension_1();
+  return Kokkos::pair<size_t, size_t>(pe * rows, (pe + 1) * rows);
+}
+
+/** \brief  Rows owned by the calling PE, see get_range. */
+template <class ViewType>
+inline Kokkos::pair<size_t, size_t> get_local_range(const ViewType &v) {
+  return get_range(v, ViewType::memory_space::impl_my_pe(
+                          v.impl_map().handle().scope));
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_PARTITION_HPP_
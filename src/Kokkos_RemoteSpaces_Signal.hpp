@@ -0,0 +1,156 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_SIGNAL_HPP_
+#define KOKKOS_REMOTESPACES_SIGNAL_HPP_
+
+#include <Kokkos_Core.hpp>
+
+namespace Kokkos {
+namespace Experimental {
+
+/** \brief  Point-to-point notification between PEs through signal views,
+ *  e.g. a pipeline stage handing a block to the next PE:
+ *
+ *    typedef View<uint64_t **, RemoteSpace> SignalView;
+ *    SignalView sig = allocate_symmetric_remote_view<SignalView>(
+ *        "Signals", num_pes, num_slots);
+ *
+ *    // Producer
+ *    put_signal(data, block, next, range, sig, slot, iteration);
+ *    // Consumer
+ *    signal_wait_until(sig, slot, CmpGE, iteration);
+ *
+ *  A signal view holds one row of uint64_t slots per PE and must be
+ *  zero-initialized and fenced before first use. The data of put_signal
+ *  is complete at the target before its slot changes, so a consumer that
+ *  observed the signal may read the data from its local segment.
+ *  put_signal maps to shmem_putmem_signal and nvshmem_putmem_signal on
+ *  the SHMEM backends and to a flushed MPI_Put followed by an
+ *  MPI_Accumulate on the signal window on MPISpace. A get with signal is
+ *  expressed as a get followed by remote_signal.
+ *
+ *  All functions may be called on the host or by a single thread of a
+ *  kernel.
+ */
+
+/** \brief  Puts src into the element range [first, second) of the
+ *  segment of dst owned by pe, then updates slot of the row of pe in sig
+ *  with value using op (SignalSet or SignalAdd). src must be contiguous
+ *  and local to the caller.
+ */
+template <class DT, class... DP, class ST, class... SP, class SignalView>
+void KOKKOS_INLINE_FUNCTION
+put_signal(const View<DT, DP...> &dst, const View<ST, SP...> &src,
+           const int pe, const Kokkos::pair<size_t, size_t> &range,
+           const SignalView &sig, const size_t slot, const uint64_t value,
+           const int op = SignalSet) {
+  static_assert(std::is_same<typename ViewTraits<DT, DP...>::specialize,
+                             RemoteSpaceSpecializeTag>::value &&
+                    std::is_same<typename SignalView::traits::specialize,
+                                 RemoteSpaceSpecializeTag>::value,
+                "put_signal requires remote destination and signal views");
+  static_assert(std::is_same<typename SignalView::non_const_value_type,
+                             uint64_t>::value,
+                "Signals must be of type uint64_t");
+  if (range.second - range.first != src.span())
+    Kokkos::abort("Error: put_signal requires a source of the span of the "
+                  "range.");
+  const int target = dst.impl_map().pe_offset() + pe;
+  const int sig_pe = sig.impl_map().pe_offset() + pe;
+  if (target != sig_pe)
+    Kokkos::abort("Error: put_signal requires data and signal views of the "
+                  "same PE offset.");
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+  dst.impl_map().handle().put_signal(src.data(), target, range.first,
+                                     range.second - range.first,
+                                     sig.impl_map().handle(), slot, value, op);
+#else
+  dst.impl_map().handle().thread_put_signal(
+      src.data(), target, range.first, range.second - range.first,
+      sig.impl_map().handle(), slot, value, op);
+#endif
+}
+
+/** \brief  Updates slot of the row of pe in sig with value using op. The
+ *  update is ordered after all prior puts of the calling PE to pe.
+ */
+template <class SignalView>
+void KOKKOS_INLINE_FUNCTION remote_signal(const SignalView &sig, const int pe,
+                                          const size_t slot,
+                                          const uint64_t value,
+                                          const int op = SignalSet) {
+  static_assert(std::is_same<typename SignalView::non_const_value_type,
+                             uint64_t>::value,
+                "Signals must be of type uint64_t");
+  const int target = sig.impl_map().pe_offset() + pe;
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+  sig.impl_map().handle().signal(target, slot, value, op);
+#else
+  sig.impl_map().handle().thread_signal(target, slot, value, op);
+#endif
+}
+
+/** \brief  Blocks until slot of the row of the calling PE in sig
+ *  satisfies cmp against cmp_value and returns its value.
+ */
+template <class SignalView>
+uint64_t KOKKOS_INLINE_FUNCTION signal_wait_until(const SignalView &sig,
+                                                  const size_t slot,
+                                                  const int cmp,
+                                                  const uint64_t cmp_value) {
+  static_assert(std::is_same<typename SignalView::non_const_value_type,
+                             uint64_t>::value,
+                "Signals must be of type uint64_t");
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+  return sig.impl_map().handle().wait_until(slot, cmp, cmp_value);
+#else
+  return sig.impl_map().handle().thread_wait_until(slot, cmp, cmp_value);
+#endif
+}
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_SIGNAL_HPP_
@@ -0,0 +1,313 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_SUBVIEW_HPP_
+#define KOKKOS_REMOTESPACES_SUBVIEW_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces_Options.hpp>
+#include <type_traits>
+
+//----------------------------------------------------------------------------
+/** \brief  Subview and assignment mappings shared by all remote spaces.
+ *
+ *  The leading subview argument selects PEs, the remaining ones select
+ *  from the local segment, e.g. subview(v, pe, Kokkos::make_pair(0, n)).
+ *  An integral PE argument yields a view with a fixed PE whose indices
+ *  exclude the PE dimension. A range keeps the PE dimension with its
+ *  origin shifted by the range start.
+ */
+namespace Kokkos {
+namespace Impl {
+
+template <class SrcTraits, class... Args>
+struct ViewMapping<
+    typename std::enable_if<std::is_same<
+        typename SrcTraits::specialize,
+        Kokkos::Experimental::RemoteSpaceSpecializeTag>::value>::type,
+    SrcTraits, Args...> {
+private:
+  static_assert(SrcTraits::rank == sizeof...(Args),
+                "Subview must be given one argument per source View rank");
+
+  typedef Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+      typename SrcTraits::memory_traits>
+      src_memory_traits;
+
+  enum : bool { src_is_fixed_pe = src_memory_traits::is_fixed_pe };
+
+  template <class Arg0, class...> struct leading_arg { typedef Arg0 type; };
+
+  enum : bool {
+    fixes_pe = !src_is_fixed_pe &&
+               std::is_integral<typename leading_arg<Args...>::type>::value
+  };
+
+  // The local segment is laid out as the source with a PE extent of one.
+  // Kokkos' own subview mapping on an equivalent HostSpace view deduces
+  // the data type and layout of the subview.
+  typedef Kokkos::ViewTraits<typename SrcTraits::data_type,
+                             typename SrcTraits::array_layout,
+                             Kokkos::HostSpace>
+      local_traits;
+
+  template <class Arg>
+  using local_pe_arg_type =
+      typename std::conditional<std::is_integral<Arg>::value, int,
+                                Kokkos::Impl::ALL_t>::type;
+
+  template <bool SrcFixed, class Arg0, class... Rest> struct local_mapping {
+    typedef ViewMapping<void, local_traits, local_pe_arg_type<Arg0>, Rest...>
+        type;
+  };
+
+  template <class Arg0, class... Rest>
+  struct local_mapping<true, Arg0, Rest...> {
+    typedef ViewMapping<void, local_traits, Arg0, Rest...> type;
+  };
+
+  typedef typename local_mapping<src_is_fixed_pe, Args...>::type::type
+      local_view_type;
+
+  typedef typename local_view_type::data_type data_type;
+  typedef typename local_view_type::array_layout array_layout;
+
+  typedef Kokkos::MemoryTraits<
+      src_memory_traits::state |
+      (fixes_pe ? unsigned(Kokkos::Experimental::FixedPE) : 0u)>
+      memory_traits;
+
+public:
+  typedef Kokkos::ViewTraits<data_type, array_layout,
+                             typename SrcTraits::memory_space, memory_traits>
+      traits_type;
+
+  typedef Kokkos::View<data_type, array_layout,
+                       typename SrcTraits::memory_space, memory_traits>
+      type;
+
+  template <class DstTraits>
+  KOKKOS_INLINE_FUNCTION static void
+  assign(ViewMapping<DstTraits, Kokkos::Experimental::RemoteSpaceSpecializeTag>
+             &dst,
+         ViewMapping<SrcTraits,
+                     Kokkos::Experimental::RemoteSpaceSpecializeTag> const &src,
+         Args... args) {
+    static_assert(ViewMapping<DstTraits, traits_type,
+                              typename DstTraits::specialize>::is_assignable,
+                  "Subview destination type must be compatible with subview "
+                  "derived type");
+    // The leading index of a Monolithic view is global, not a PE index
+    if (src.m_partition.is_monolithic)
+      Kokkos::abort("Subviews of Monolithic remote views are not supported");
+    assign_impl(dst, src, std::integral_constant<bool, src_is_fixed_pe>(),
+                args...);
+    dst.m_partition = src.m_partition;
+  }
+
+private:
+  template <class Arg>
+  KOKKOS_INLINE_FUNCTION static
+      typename std::enable_if<std::is_integral<Arg>::value, int>::type
+      local_pe_arg(const Arg &) {
+    return 0;
+  }
+
+  template <class Arg>
+  KOKKOS_INLINE_FUNCTION static
+      typename std::enable_if<!std::is_integral<Arg>::value,
+                              Kokkos::Impl::ALL_t>::type
+      local_pe_arg(const Arg &) {
+    return Kokkos::Impl::ALL_t();
+  }
+
+  template <class DstMapping, class SrcMapping, class Arg>
+  KOKKOS_INLINE_FUNCTION static
+      typename std::enable_if<std::is_integral<Arg>::value>::type
+      assign_pes(DstMapping &dst, const SrcMapping &src, const Arg &pe) {
+    dst.m_pe_offset = src.m_pe_offset + pe;
+    dst.m_num_pes = 1;
+  }
+
+  template <class DstMapping, class SrcMapping>
+  KOKKOS_INLINE_FUNCTION static void assign_pes(DstMapping &dst,
+                                                const SrcMapping &src,
+                                                const Kokkos::Impl::ALL_t &) {
+    dst.m_pe_offset = src.m_pe_offset;
+    dst.m_num_pes = src.m_num_pes;
+  }
+
+  template <class DstMapping, class SrcMapping, class Arg>
+  KOKKOS_INLINE_FUNCTION static typename std::enable_if<
+      !std::is_integral<Arg>::value &&
+      !std::is_same<Arg, Kokkos::Impl::ALL_t>::value>::type
+  assign_pes(DstMapping &dst, const SrcMapping &src, const Arg &range) {
+    dst.m_pe_offset = src.m_pe_offset + range.first;
+    dst.m_num_pes = range.second - range.first;
+  }
+
+  template <class DstTraits, class SrcMapping, class... LocalArgs>
+  KOKKOS_INLINE_FUNCTION static void assign_local(
+      ViewMapping<DstTraits, Kokkos::Experimental::RemoteSpaceSpecializeTag>
+          &dst,
+      const SrcMapping &src, LocalArgs... args) {
+    typedef ViewMapping<DstTraits,
+                        Kokkos::Experimental::RemoteSpaceSpecializeTag>
+        DstType;
+    typedef typename DstType::offset_type dst_offset_type;
+
+    const SubviewExtents<SrcTraits::rank, traits_type::rank> extents(
+        src.m_offset.m_dim, args...);
+
+    dst.m_offset = dst_offset_type(src.m_offset, extents);
+    dst.m_handle = ViewDataHandle<DstTraits>::assign(
+        src.m_handle,
+        src.m_offset(extents.domain_offset(0), extents.domain_offset(1),
+                     extents.domain_offset(2), extents.domain_offset(3),
+                     extents.domain_offset(4), extents.domain_offset(5),
+                     extents.domain_offset(6), extents.domain_offset(7)));
+  }
+
+  // Leading argument selects PEs
+  template <class DstMapping, class SrcMapping, class PEArg,
+            class... LocalArgs>
+  KOKKOS_INLINE_FUNCTION static void
+  assign_impl(DstMapping &dst, const SrcMapping &src, std::false_type,
+              const PEArg &pe_arg, LocalArgs... args) {
+    assign_local(dst, src, local_pe_arg(pe_arg), args...);
+    assign_pes(dst, src, pe_arg);
+  }
+
+  // Source already has a fixed PE, all arguments select from its segment
+  template <class DstMapping, class SrcMapping>
+  KOKKOS_INLINE_FUNCTION static void assign_impl(DstMapping &dst,
+                                                 const SrcMapping &src,
+                                                 std::true_type,
+                                                 Args... args) {
+    assign_local(dst, src, args...);
+    dst.m_pe_offset = src.m_pe_offset;
+    dst.m_num_pes = src.m_num_pes;
+  }
+};
+
+//----------------------------------------------------------------------------
+/** \brief  Assignment between remote views of compatible type, e.g. a
+ *  subview into a view with a LayoutStride or runtime extents.
+ */
+template <class DstTraits, class SrcTraits>
+class ViewMapping<DstTraits, SrcTraits,
+                  Kokkos::Experimental::RemoteSpaceSpecializeTag> {
+private:
+  enum {
+    is_assignable_space = std::is_same<typename DstTraits::memory_space,
+                                       typename SrcTraits::memory_space>::value
+  };
+
+  enum {
+    is_assignable_value_type =
+        std::is_same<typename DstTraits::value_type,
+                     typename SrcTraits::value_type>::value ||
+        std::is_same<typename DstTraits::value_type,
+                     typename SrcTraits::const_value_type>::value
+  };
+
+  enum {
+    is_assignable_dimension =
+        ViewDimensionAssignable<typename DstTraits::dimension,
+                                typename SrcTraits::dimension>::value
+  };
+
+  enum {
+    is_assignable_layout =
+        std::is_same<typename DstTraits::array_layout,
+                     typename SrcTraits::array_layout>::value ||
+        std::is_same<typename DstTraits::array_layout,
+                     Kokkos::LayoutStride>::value
+  };
+
+  // Views with and without a fixed PE index differently
+  enum {
+    is_assignable_pe = bool(Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+                                typename DstTraits::memory_traits>::
+                                is_fixed_pe) ==
+                       bool(Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+                                typename SrcTraits::memory_traits>::
+                                is_fixed_pe)
+  };
+
+public:
+  enum {
+    is_assignable = is_assignable_space && is_assignable_value_type &&
+                    is_assignable_dimension && is_assignable_layout &&
+                    is_assignable_pe
+  };
+
+  typedef Kokkos::Impl::SharedAllocationTracker TrackType;
+  typedef ViewMapping<DstTraits, Kokkos::Experimental::RemoteSpaceSpecializeTag>
+      DstType;
+  typedef ViewMapping<SrcTraits, Kokkos::Experimental::RemoteSpaceSpecializeTag>
+      SrcType;
+
+  KOKKOS_INLINE_FUNCTION
+  static void assign(DstType &dst, const SrcType &src,
+                     const TrackType & /*src_track*/) {
+    static_assert(is_assignable,
+                  "View assignment must have compatible spaces, value types, "
+                  "dimensions, layouts and PE indexing");
+
+    typedef typename DstType::offset_type dst_offset_type;
+    typedef typename DstType::handle_type dst_handle_type;
+
+    dst.m_offset = dst_offset_type(src.m_offset);
+    dst.m_handle = dst_handle_type(src.m_handle);
+    dst.m_num_pes = src.m_num_pes;
+    dst.m_pe_offset = src.m_pe_offset;
+    dst.m_partition = src.m_partition;
+  }
+};
+
+} // namespace Impl
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_SUBVIEW_HPP_
@@ -0,0 +1,379 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOS_REMOTESPACES_TOPOLOGY_HPP_
+#define KOKKOS_REMOTESPACES_TOPOLOGY_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#ifdef KOKKOS_ENABLE_MPISPACE
+#include <Kokkos_MPISpace.hpp>
+#endif
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_QUO
+#include <quo.h>
+#endif
+
+namespace Kokkos {
+namespace Experimental {
+
+namespace Impl {
+
+/* Communicator whose ranks are the PEs of a scope. The SHMEM backends
+ * number the PEs of their world team like MPI_COMM_WORLD. */
+template <class MemorySpace> struct scope_comm {
+  static MPI_Comm comm(const typename MemorySpace::scope_type &scope) {
+    int world_size;
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+    if (MemorySpace::impl_num_pes(scope) != world_size)
+      Kokkos::abort("Kokkos::Experimental: MPI communication over a SHMEM "
+                    "team requires a team of all PEs.");
+    return MPI_COMM_WORLD;
+  }
+};
+
+#ifdef KOKKOS_ENABLE_MPISPACE
+template <> struct scope_comm<Kokkos::Experimental::MPISpace> {
+  static MPI_Comm comm(const MPI_Comm &scope) { return scope; }
+};
+#endif
+
+/* Memory space instance whose views span the PEs of a scope */
+template <class MemorySpace> struct scope_space {
+  static MemorySpace space(const typename MemorySpace::scope_type &scope) {
+    return MemorySpace(scope);
+  }
+};
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+template <> struct scope_space<Kokkos::Experimental::NVSHMEMSpace> {
+  static Kokkos::Experimental::NVSHMEMSpace
+  space(const nvshmem_team_t &scope) {
+    return Kokkos::Experimental::NVSHMEMSpace::team_space(scope);
+  }
+};
+#endif
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_QUO
+/* Process-wide QUO context and the NUMA domain that host segments of the
+ * calling process are placed in: the domain the process is bound to, or
+ * one chosen by its node-local rank if it spans several. */
+struct NumaPlacement {
+  QUO_context ctx = NULL;
+  bool initialized = false;
+  int domain = -1;
+
+  static NumaPlacement &instance() {
+    static NumaPlacement placement;
+    return placement;
+  }
+
+  /* The first initialization is collective over MPI_COMM_WORLD and only
+   * happens if may_create is set */
+  bool init(const bool may_create) {
+    if (initialized || !may_create)
+      return domain >= 0;
+    initialized = true;
+    if (QUO_create(&ctx, MPI_COMM_WORLD) != QUO_SUCCESS) {
+      ctx = NULL;
+      return false;
+    }
+    int num_domains = 0, qid = 0, num_qids = 1;
+    QUO_nnumanodes(ctx, &num_domains);
+    QUO_id(ctx, &qid);
+    QUO_nqids(ctx, &num_qids);
+    for (int d = 0; d < num_domains && domain < 0; d++) {
+      int inside = 0;
+      QUO_cur_cpuset_in_type(ctx, QUO_OBJ_NUMANODE, d, &inside);
+      if (inside)
+        domain = d;
+    }
+    if (domain < 0 && num_domains > 0)
+      domain = qid * num_domains / num_qids;
+    Kokkos::push_finalize_hook([]() {
+      NumaPlacement &placement = instance();
+      if (placement.ctx)
+        QUO_free(placement.ctx);
+      placement.ctx = NULL;
+    });
+    return domain >= 0;
+  }
+};
+#endif
+
+/* Places the pages of a new host segment in the NUMA domain of the
+ * calling process by touching them while bound to it. Called by the
+ * host backends at allocation. collective is set where the allocation is
+ * collective over MPI_COMM_WORLD and may then set up QUO. Without QUO
+ * the pages are placed on first touch by their initialization. */
+inline void numa_first_touch(void *ptr, const size_t size,
+                             const bool collective) {
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_QUO
+  NumaPlacement &placement = NumaPlacement::instance();
+  if (!placement.init(collective) || !ptr || !size)
+    return;
+  const bool bound =
+      QUO_bind_push(placement.ctx, QUO_BIND_PUSH_OBJ, QUO_OBJ_NUMANODE,
+                    placement.domain) == QUO_SUCCESS;
+  volatile char *bytes = static_cast<volatile char *>(ptr);
+  const size_t page = 4096;
+  for (size_t off = 0; off < size; off += page)
+    bytes[off] = 0;
+  if (bound)
+    QUO_bind_pop(placement.ctx);
+#else
+  (void)ptr;
+  (void)size;
+  (void)collective;
+#endif
+}
+
+/* NUMA domain of the segments of the calling process, -1 if unknown */
+inline int numa_domain() {
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_QUO
+  NumaPlacement &placement = NumaPlacement::instance();
+  return placement.initialized ? placement.domain : -1;
+#else
+  return -1;
+#endif
+}
+
+} // namespace Impl
+
+/** \brief  Node structure of the PEs of a remote memory space
+ *
+ *    PETopology<RemoteSpace_t> topo(RemoteSpace_t());
+ *    parallel_for(..., KOKKOS_LAMBDA(const int i) {
+ *      for (int k = 0; k < topo.num_pes(); k++) {
+ *        const int pe = topo.order(k); // PEs of the own node first
+ *        ... v(pe, i) ...
+ *      }
+ *    });
+ *
+ *  PE indices of remote views stay flat ranks of the scope. The topology
+ *  maps each of them to a node and a rank within that node and back.
+ *  Nodes are numbered by their lowest PE, the PEs of a node by rank.
+ *  order() enumerates all PEs starting with those of the calling PE's
+ *  node, so that kernels can serve node-local accesses first and spread
+ *  the remaining ones over the other nodes.
+ *
+ *  Construction is collective over the PEs of the scope. Queries are
+ *  callable on the host and in kernels of the execution space of the
+ *  memory space. With QUO (Kokkos_ENABLE_REMOTE_SPACES_QUO) the host
+ *  segments of MPISpace and SHMEMSpace allocations are first touched in
+ *  the NUMA domain of their owner, which numa_domain() reports.
+ */
+template <class MemorySpace> class PETopology {
+public:
+  typedef MemorySpace memory_space;
+  typedef typename MemorySpace::execution_space execution_space;
+  typedef Kokkos::View<int *, typename execution_space::memory_space>
+      table_type;
+  typedef typename table_type::HostMirror host_table_type;
+
+private:
+  int m_my_pe;
+  int m_my_node;
+  int m_num_pes;
+  int m_num_nodes;
+  // Node, rank within the node and NUMA domain of each PE
+  table_type m_node, m_local_rank, m_numa;
+  // PEs grouped by node, those of node n start at m_node_offsets(n)
+  table_type m_node_offsets, m_node_pes;
+  // Access order of the calling PE
+  table_type m_order;
+  host_table_type h_node, h_local_rank, h_numa, h_node_offsets, h_node_pes,
+      h_order;
+
+  KOKKOS_INLINE_FUNCTION
+  static int at(const table_type &device, const host_table_type &host,
+                const int i) {
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+    (void)device;
+    return host(i);
+#else
+    (void)host;
+    return device(i);
+#endif
+  }
+
+  void init(const MPI_Comm comm) {
+    MPI_Comm_rank(comm, &m_my_pe);
+    MPI_Comm_size(comm, &m_num_pes);
+
+    MPI_Comm node_comm, leader_comm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, m_my_pe, MPI_INFO_NULL,
+                        &node_comm);
+    int local_rank;
+    MPI_Comm_rank(node_comm, &local_rank);
+    // The lowest PE of each node numbers it among the others
+    MPI_Comm_split(comm, local_rank == 0 ? 0 : MPI_UNDEFINED, m_my_pe,
+                   &leader_comm);
+    m_my_node = 0;
+    if (leader_comm != MPI_COMM_NULL) {
+      MPI_Comm_rank(leader_comm, &m_my_node);
+      MPI_Comm_free(&leader_comm);
+    }
+    MPI_Bcast(&m_my_node, 1, MPI_INT, 0, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    int mine[3] = {m_my_node, local_rank, Impl::numa_domain()};
+    std::vector<int> all(3 * m_num_pes);
+    MPI_Allgather(mine, 3, MPI_INT, all.data(), 3, MPI_INT, comm);
+
+    m_num_nodes = 0;
+    for (int pe = 0; pe < m_num_pes; pe++)
+      m_num_nodes = std::max(m_num_nodes, all[3 * pe] + 1);
+
+    h_node = host_table_type("PETopology::node", m_num_pes);
+    h_local_rank = host_table_type("PETopology::local_rank", m_num_pes);
+    h_numa = host_table_type("PETopology::numa", m_num_pes);
+    h_node_offsets =
+        host_table_type("PETopology::node_offsets", m_num_nodes + 1);
+    h_node_pes = host_table_type("PETopology::node_pes", m_num_pes);
+    h_order = host_table_type("PETopology::order", m_num_pes);
+    for (int pe = 0; pe < m_num_pes; pe++) {
+      h_node(pe) = all[3 * pe];
+      h_local_rank(pe) = all[3 * pe + 1];
+      h_numa(pe) = all[3 * pe + 2];
+      h_node_offsets(h_node(pe) + 1)++;
+    }
+    for (int n = 0; n < m_num_nodes; n++)
+      h_node_offsets(n + 1) += h_node_offsets(n);
+    for (int pe = 0; pe < m_num_pes; pe++)
+      h_node_pes(h_node_offsets(h_node(pe)) + h_local_rank(pe)) = pe;
+
+    // Own node first, then the following nodes. Each node is entered at
+    // the calling PE's local rank so that its PEs see different peers
+    // first.
+    int k = 0;
+    for (int j = 0; j < m_num_nodes; j++) {
+      const int n = (m_my_node + j) % m_num_nodes;
+      const int size = h_node_offsets(n + 1) - h_node_offsets(n);
+      for (int r = 0; r < size; r++)
+        h_order(k++) = h_node_pes(h_node_offsets(n) + (local_rank + r) % size);
+    }
+
+    m_node = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_node);
+    m_local_rank = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_local_rank);
+    m_numa = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_numa);
+    m_node_offsets = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_node_offsets);
+    m_node_pes = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_node_pes);
+    m_order = Kokkos::create_mirror_view_and_copy(
+        typename table_type::memory_space(), h_order);
+  }
+
+public:
+  /* Topology of the PEs of the scope of space */
+  explicit PETopology(const MemorySpace &space) {
+    init(Impl::scope_comm<MemorySpace>::comm(space.scope));
+  }
+
+  /* Topology of the PEs of remote view v */
+  template <class ViewType>
+  explicit PETopology(
+      const ViewType &v,
+      typename std::enable_if<Kokkos::is_view<ViewType>::value>::type * =
+          nullptr) {
+    static_assert(
+        std::is_same<typename ViewType::memory_space, MemorySpace>::value,
+        "PETopology requires a view of its memory space");
+    init(Impl::scope_comm<MemorySpace>::comm(v.impl_map().handle().scope));
+  }
+
+  KOKKOS_INLINE_FUNCTION int num_pes() const { return m_num_pes; }
+  KOKKOS_INLINE_FUNCTION int num_nodes() const { return m_num_nodes; }
+  KOKKOS_INLINE_FUNCTION int my_pe() const { return m_my_pe; }
+  KOKKOS_INLINE_FUNCTION int my_node() const { return m_my_node; }
+
+  /* Node of pe and its rank among the PEs of that node */
+  KOKKOS_INLINE_FUNCTION int node(const int pe) const {
+    return at(m_node, h_node, pe);
+  }
+  KOKKOS_INLINE_FUNCTION int local_rank(const int pe) const {
+    return at(m_local_rank, h_local_rank, pe);
+  }
+
+  /* Number of PEs of node n and the PE of rank r within it */
+  KOKKOS_INLINE_FUNCTION int node_size(const int n) const {
+    return at(m_node_offsets, h_node_offsets, n + 1) -
+           at(m_node_offsets, h_node_offsets, n);
+  }
+  KOKKOS_INLINE_FUNCTION int node_pe(const int n, const int r) const {
+    return at(m_node_pes, h_node_pes, at(m_node_offsets, h_node_offsets, n) + r);
+  }
+
+  /* pe shares the node of the calling PE */
+  KOKKOS_INLINE_FUNCTION bool is_node_local(const int pe) const {
+    return node(pe) == m_my_node;
+  }
+  KOKKOS_INLINE_FUNCTION int num_node_local() const {
+    return node_size(m_my_node);
+  }
+
+  /* NUMA domain of the segments of pe, -1 if unknown. Only meaningful
+   * between PEs of the same node. */
+  KOKKOS_INLINE_FUNCTION int numa_domain(const int pe) const {
+    return at(m_numa, h_numa, pe);
+  }
+
+  /* k-th PE in the access order of the calling PE. The first
+   * num_node_local() entries are the PEs of its node. */
+  KOKKOS_INLINE_FUNCTION int order(const int k) const {
+    return at(m_order, h_order, k);
+  }
+};
+
+} // namespace Experimental
+} // namespace Kokkos
+
+#endif // KOKKOS_REMOTESPACES_TOPOLOGY_HPP_
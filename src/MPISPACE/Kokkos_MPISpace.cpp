@@ -44,16 +44,164 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_MPISpace.hpp>
+#include <Kokkos_RemoteSpaces_Topology.hpp>
+#include <cstring>
 #include <mpi.h>
 
 namespace Kokkos {
 namespace Experimental {
 
 MPI_Win MPISpace::current_win;
+MPI_Aint MPISpace::current_win_disp = 0;
+MPI_Win MPISpace::current_shared_win = MPI_WIN_NULL;
+void **MPISpace::current_node_ptrs = NULL;
+MPI_Comm MPISpace::node_comm = MPI_COMM_NULL;
 std::vector<MPI_Win> MPISpace::mpi_windows;
+Impl::MPIDynamicAllocation *MPISpace::current_dynamic = NULL;
+MPI_Win MPISpace::dynamic_win = MPI_WIN_NULL;
+MPI_Win MPISpace::directory_win = MPI_WIN_NULL;
+
+namespace {
+
+/* Each rank publishes the address of dynamic allocation id in slot
+ * id % directory_slots of its directory as the pair (id + 1, address)
+ * until the allocation is freed. At most directory_slots dynamic
+ * allocations can therefore be live at once. */
+constexpr uint64_t directory_slots = 4096;
+MPI_Aint *directory = NULL;
+uint64_t dynamic_count = 0;
+
+void register_window(std::vector<MPI_Win> &windows, MPI_Win win) {
+  int i = -1;
+  for (i = 0; i < windows.size(); i++)
+    if (windows[i] == MPI_WIN_NULL)
+      break;
+  if (i == windows.size())
+    windows.push_back(win);
+  else
+    windows[i] = win;
+}
+
+/* Same processes in the same order */
+bool is_congruent(MPI_Comm a, MPI_Comm b) {
+  int result;
+  MPI_Comm_compare(a, b, &result);
+  return result == MPI_IDENT || result == MPI_CONGRUENT;
+}
+
+/* Returns the allocation base of every on-node peer of win, indexed by
+ * rank in comm. Off-node entries are NULL. */
+void **query_node_ptrs(MPI_Comm comm, MPI_Comm node_comm, MPI_Win win) {
+  int num_ranks, node_size;
+  MPI_Comm_size(comm, &num_ranks);
+  MPI_Comm_size(node_comm, &node_size);
+
+  MPI_Group comm_group, node_group;
+  MPI_Comm_group(comm, &comm_group);
+  MPI_Comm_group(node_comm, &node_group);
+  std::vector<int> node_ranks(node_size), comm_ranks(node_size);
+  for (int r = 0; r < node_size; r++)
+    node_ranks[r] = r;
+  MPI_Group_translate_ranks(node_group, node_size, node_ranks.data(),
+                            comm_group, comm_ranks.data());
+  MPI_Group_free(&node_group);
+  MPI_Group_free(&comm_group);
+
+  void **node_ptrs = new void *[num_ranks]();
+  for (int r = 0; r < node_size; r++) {
+    MPI_Aint size;
+    int disp_unit;
+    void *base;
+    MPI_Win_shared_query(win, r, &size, &disp_unit, &base);
+    node_ptrs[comm_ranks[r]] = base;
+  }
+  return node_ptrs;
+}
+
+void create_dynamic_window(MPI_Win &dynamic_win, MPI_Win &directory_win) {
+  MPI_Win_create_dynamic(MPI_INFO_NULL, MPI_COMM_WORLD, &dynamic_win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, dynamic_win);
+  MPI_Win_allocate(2 * directory_slots * sizeof(MPI_Aint), sizeof(MPI_Aint),
+                   MPI_INFO_NULL, MPI_COMM_WORLD, &directory, &directory_win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, directory_win);
+  memset(directory, 0, 2 * directory_slots * sizeof(MPI_Aint));
+  MPI_Win_sync(directory_win);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/* Attaches a new allocation of size bytes to the dynamic window without
+ * communication and publishes its address */
+void *attach_dynamic(MPI_Win dynamic_win, MPI_Win directory_win,
+                     const size_t size, Impl::MPIDynamicAllocation *&dyn) {
+  int my_rank, num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+  void *ptr;
+  MPI_Alloc_mem(size, MPI_INFO_NULL, &ptr);
+  MPI_Win_attach(dynamic_win, ptr, size);
+
+  dyn = new Impl::MPIDynamicAllocation;
+  dyn->id = dynamic_count++;
+  dyn->bases = new MPI_Aint[num_ranks]();
+  MPI_Get_address(ptr, &dyn->bases[my_rank]);
+
+  // A slot is cleared when its allocation is freed, an occupied slot
+  // belongs to an allocation directory_slots ids older that is still live
+  const uint64_t slot = dyn->id % directory_slots;
+  if (directory[2 * slot] != 0)
+    Kokkos::abort("MPISpace: more than 4096 allocations attached to the "
+                  "dynamic window at once, free views or disable "
+                  "Kokkos_ENABLE_MPISPACE_DYNAMIC_WINDOW.");
+  directory[2 * slot + 1] = dyn->bases[my_rank];
+  directory[2 * slot] = dyn->id + 1;
+  MPI_Win_sync(directory_win);
+  return ptr;
+}
+
+/* Frees the directory slot of dynamic allocation id */
+void release_dynamic_slot(const uint64_t id) {
+  const uint64_t slot = id % directory_slots;
+  if (directory[2 * slot] == MPI_Aint(id + 1)) {
+    directory[2 * slot] = 0;
+    MPI_Win_sync(MPISpace::directory_win);
+  }
+}
+
+} // namespace
+
+namespace Impl {
+
+MPI_Aint mpi_fetch_dynamic_base(const uint64_t id, const int pe) {
+  MPI_Aint entry[2];
+  const uint64_t slot = id % directory_slots;
+  MPI_Get(entry, 2, MPI_AINT, pe, 2 * slot, 2, MPI_AINT,
+          MPISpace::directory_win);
+  MPI_Win_flush(pe, MPISpace::directory_win);
+  if (entry[0] != MPI_Aint(id + 1))
+    Kokkos::abort("MPISpace: allocation not yet attached on the target "
+                  "rank, synchronize after allocating.");
+  return entry[1];
+}
+
+} // namespace Impl
 
 /* Default allocation mechanism */
-MPISpace::MPISpace() : allocation_mode(Symmetric) {}
+MPISpace::MPISpace() : allocation_mode(Symmetric), scope(MPI_COMM_WORLD) {}
+
+MPISpace::MPISpace(const MPI_Comm &comm)
+    : allocation_mode(Symmetric), scope(comm) {}
+
+int MPISpace::impl_my_pe(const scope_type &scope) {
+  int rank;
+  MPI_Comm_rank(scope, &rank);
+  return rank;
+}
+
+int MPISpace::impl_num_pes(const scope_type &scope) {
+  int size;
+  MPI_Comm_size(scope, &size);
+  return size;
+}
 
 void MPISpace::impl_set_allocation_mode(const int allocation_mode_) {
   allocation_mode = allocation_mode_;
@@ -61,6 +209,11 @@ void MPISpace::impl_set_allocation_mode(const int allocation_mode_) {
 
 void MPISpace::impl_set_extent(const int64_t extent_) { extent = extent_; }
 
+void MPISpace::impl_set_arena(
+    const std::shared_ptr<Impl::RemoteArenaState> &arena_) {
+  arena = arena_;
+}
+
 void *MPISpace::allocate(const size_t arg_alloc_size) const {
   static_assert(sizeof(void *) == sizeof(uintptr_t),
                 "Error sizeof(void*) != sizeof(uintptr_t)");
@@ -70,28 +223,122 @@ void *MPISpace::allocate(const size_t arg_alloc_size) const {
       "Memory alignment must be power of two");
 
   void *ptr = 0;
-  if (arg_alloc_size) {
-    if (allocation_mode == Symmetric) {
+  current_shared_win = MPI_WIN_NULL;
+  current_node_ptrs = NULL;
+  current_win_disp = 0;
+  current_dynamic = NULL;
+  if (arg_alloc_size && arena) {
+    // Blocks of the arena are addressed through the window of its
+    // backing allocation, no window is created
+    if (allocation_mode != Symmetric)
+      Kokkos::abort("MPISpace: RemoteArena only supports Symmetric views.");
+    auto *record = arena->tracker.get_record<MPISpace>();
+    if (!is_congruent(record->m_space.scope, scope))
+      Kokkos::abort("MPISpace: views of a RemoteArena must use the "
+                    "communicator of the arena.");
+    char *win_base = reinterpret_cast<char *>(record->data()) -
+                     sizeof(Kokkos::Impl::SharedAllocationHeader);
+    ptr = arena->allocate_ptr(arg_alloc_size, name());
+    current_win = record->win;
+    current_win_disp = static_cast<char *>(ptr) - win_base;
+    current_dynamic = record->dynamic;
+  } else if (arg_alloc_size) {
+    // Segments of Asymmetric and Monolithic allocations differ in size,
+    // which MPI_Win_allocate supports directly
+    if (allocation_mode == Symmetric || allocation_mode == Asymmetric ||
+        allocation_mode == Monolithic) {
+#ifdef KOKKOS_ENABLE_MPISPACE_DYNAMIC_WINDOW
+      // The dynamic window spans MPI_COMM_WORLD, instances over other
+      // communicators create a window per allocation
+      const bool use_dynamic = is_congruent(scope, MPI_COMM_WORLD);
+#else
+      const bool use_dynamic = false;
+#endif
+      if (use_dynamic) {
+        if (dynamic_win == MPI_WIN_NULL) {
+          create_dynamic_window(dynamic_win, directory_win);
+          register_window(mpi_windows, dynamic_win);
+        }
+        ptr = attach_dynamic(dynamic_win, directory_win, arg_alloc_size,
+                             current_dynamic);
+        current_win = dynamic_win;
+        Kokkos::Experimental::Impl::numa_first_touch(ptr, arg_alloc_size,
+                                                     false);
+      } else {
+        current_win = MPI_WIN_NULL;
+        MPI_Win_allocate(arg_alloc_size, 1, MPI_INFO_NULL, scope, &ptr,
+                         &current_win);
+        Kokkos::Experimental::Impl::numa_first_touch(
+            ptr, arg_alloc_size, is_congruent(scope, MPI_COMM_WORLD));
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, current_win);
+        register_window(mpi_windows, current_win);
+      }
+    } else if (allocation_mode == SymmetricShared) {
+      MPI_Comm scope_node_comm = MPI_COMM_NULL;
+      if (is_congruent(scope, MPI_COMM_WORLD)) {
+        if (node_comm == MPI_COMM_NULL)
+          MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                              MPI_INFO_NULL, &node_comm);
+      } else {
+        MPI_Comm_split_type(scope, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                            &scope_node_comm);
+      }
+      MPI_Comm shared_comm =
+          scope_node_comm != MPI_COMM_NULL ? scope_node_comm : node_comm;
+      // Segments of a node are backed by one shared memory window. A
+      // second window over the same memory serves RMA across nodes.
+      MPI_Info info;
+      MPI_Info_create(&info);
+      MPI_Info_set(info, "alloc_shared_noncontig", "true");
+      MPI_Win_allocate_shared(arg_alloc_size, 1, info, shared_comm, &ptr,
+                              &current_shared_win);
+      MPI_Info_free(&info);
+      // Each segment is placed with its owner before peers map it
+      Kokkos::Experimental::Impl::numa_first_touch(
+          ptr, arg_alloc_size, is_congruent(scope, MPI_COMM_WORLD));
+      current_node_ptrs =
+          query_node_ptrs(scope, shared_comm, current_shared_win);
+      // The window keeps its own reference to the group
+      if (scope_node_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&scope_node_comm);
+
       current_win = MPI_WIN_NULL;
-      MPI_Win_allocate(arg_alloc_size, 1, MPI_INFO_NULL, MPI_COMM_WORLD, &ptr,
-                       &current_win);
+      MPI_Win_create(ptr, arg_alloc_size, 1, MPI_INFO_NULL, scope,
+                     &current_win);
       MPI_Win_lock_all(MPI_MODE_NOCHECK, current_win);
-      int i = -1;
-      for (i = 0; i < mpi_windows.size(); i++)
-        if (mpi_windows[i] == MPI_WIN_NULL)
-          break;
-      if (i == mpi_windows.size())
-        mpi_windows.push_back(current_win);
-      else
-        mpi_windows[i] = current_win;
+      register_window(mpi_windows, current_win);
     } else {
-      Kokkos::abort("MPISpace only supports symmetric allocation policy.");
+      Kokkos::abort("MPISpace: unknown allocation policy.");
     }
   }
   return ptr;
 }
 
-void MPISpace::deallocate(void *const, const size_t) const {
+void MPISpace::deallocate(void *const arg_alloc_ptr,
+                          const size_t arg_alloc_size) const {
+  if (arena) {
+    arena->deallocate_ptr(arg_alloc_ptr, arg_alloc_size);
+    current_win = MPI_WIN_NULL;
+    current_dynamic = NULL;
+    return;
+  }
+
+  // Deallocation is collective like the allocation: no peer may still
+  // access the allocation or look up its directory slot once it is
+  // detached and its memory reused
+  if (current_dynamic) {
+    MPI_Win_flush_all(dynamic_win);
+    MPI_Barrier(scope);
+    MPI_Win_detach(dynamic_win, arg_alloc_ptr);
+    MPI_Free_mem(arg_alloc_ptr);
+    release_dynamic_slot(current_dynamic->id);
+    delete[] current_dynamic->bases;
+    delete current_dynamic;
+    current_dynamic = NULL;
+    current_win = MPI_WIN_NULL;
+    return;
+  }
+
   int last_valid = -1;
   for (last_valid = 0; last_valid < mpi_windows.size(); last_valid++)
     if (mpi_windows[last_valid] == MPI_WIN_NULL)
@@ -107,18 +354,54 @@ void MPISpace::deallocate(void *const, const size_t) const {
   MPI_Win_unlock_all(current_win);
   MPI_Win_free(&current_win);
   current_win = MPI_WIN_NULL;
+
+  if (current_shared_win != MPI_WIN_NULL) {
+    MPI_Win_free(&current_shared_win);
+    current_shared_win = MPI_WIN_NULL;
+  }
+  delete[] current_node_ptrs;
+  current_node_ptrs = NULL;
 }
 
 void MPISpace::fence() {
-
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("MPISpace::fence");
   for (int i = 0; i < mpi_windows.size(); i++) {
     if (mpi_windows[i] != MPI_WIN_NULL) {
       MPI_Win_flush_all(mpi_windows[i]);
+      // Order local stores to window memory with respect to RMA
+      MPI_Win_sync(mpi_windows[i]);
     } else {
       break;
     }
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(scope);
+}
+
+void MPISpace::fence_local() {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("MPISpace::fence_local");
+  for (int i = 0; i < mpi_windows.size(); i++) {
+    if (mpi_windows[i] != MPI_WIN_NULL) {
+      MPI_Win_flush_local_all(mpi_windows[i]);
+    } else {
+      break;
+    }
+  }
+}
+
+void MPISpace::fence_window(MPI_Win win, const bool barrier, MPI_Comm comm) {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("MPISpace::fence(view)");
+  if (win != MPI_WIN_NULL) {
+    MPI_Win_flush_all(win);
+    MPI_Win_sync(win);
+  }
+  if (barrier)
+    MPI_Barrier(comm);
+}
+
+void MPISpace::fence_window_local(MPI_Win win) {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("MPISpace::fence_local(view)");
+  if (win != MPI_WIN_NULL)
+    MPI_Win_flush_local_all(win);
 }
 } // namespace Experimental
 
@@ -163,7 +446,15 @@ SharedAllocationRecord<Kokkos::Experimental::MPISpace,
         header.m_label, data(), size());
   }
 #endif
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessRegistry::instance().retire(
+      counters);
+#endif
+  delete[] pe_offsets;
   m_space.current_win = win;
+  m_space.current_dynamic = dynamic;
+  m_space.current_shared_win = shared_win;
+  m_space.current_node_ptrs = node_ptrs;
   m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
                      SharedAllocationRecord<void, void>::m_alloc_size);
 }
@@ -197,6 +488,28 @@ SharedAllocationRecord<Kokkos::Experimental::MPISpace, void>::
   strncpy(RecordBase::m_alloc_ptr->m_label, arg_label.c_str(),
           SharedAllocationHeader::maximum_label_length);
   win = m_space.current_win;
+  win_disp = m_space.current_win_disp;
+  dynamic = m_space.current_dynamic;
+  shared_win = m_space.current_shared_win;
+  node_ptrs = m_space.current_node_ptrs;
+  pe_offsets = NULL;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  {
+    const int num_pes = m_space.impl_num_pes();
+    std::vector<int> ranks(num_pes), world_pes(num_pes);
+    for (int pe = 0; pe < num_pes; pe++)
+      ranks[pe] = pe;
+    MPI_Group group, world_group;
+    MPI_Comm_group(m_space.scope, &group);
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Group_translate_ranks(group, num_pes, ranks.data(), world_group,
+                              world_pes.data());
+    MPI_Group_free(&group);
+    MPI_Group_free(&world_group);
+    counters = Kokkos::Experimental::Impl::RemoteAccessRegistry::instance()
+                   .create(arg_label, world_pes);
+  }
+#endif
 }
 
 //----------------------------------------------------------------------------
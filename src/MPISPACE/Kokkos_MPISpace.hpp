@@ -47,6 +47,8 @@
 
 #include <cstring>
 #include <iosfwd>
+#include <memory>
+#include <stdint.h>
 #include <string>
 #include <typeinfo>
 #include <impl/Kokkos_Traits.hpp>
@@ -64,6 +66,28 @@ namespace Experimental {
 
 struct RemoteSpaceSpecializeTag {};
 
+namespace Impl {
+
+MPI_Aint mpi_fetch_dynamic_base(const uint64_t id, const int pe);
+
+/* An allocation attached to the dynamic window of MPISpace. Ranks
+ * attach at different addresses; the address on each rank is fetched
+ * from the directory window of that rank on first use and cached. */
+struct MPIDynamicAllocation {
+  // Position in the sequence of dynamic allocations, equal on all ranks
+  uint64_t id;
+  // Address of the allocation on each rank, 0 until fetched
+  MPI_Aint *bases;
+
+  MPI_Aint base(const int pe) const {
+    if (!bases[pe])
+      bases[pe] = mpi_fetch_dynamic_base(id, pe);
+    return bases[pe];
+  }
+};
+
+} // namespace Impl
+
 class MPISpace {
 public:
   typedef MPISpace memory_space;
@@ -86,6 +110,9 @@ public:
 
   typedef Kokkos::Device<execution_space, memory_space> device_type;
 
+  /* Ranks addressed by views of an instance */
+  typedef MPI_Comm scope_type;
+
   MPISpace();
   MPISpace(MPISpace &&rhs) = default;
   MPISpace(const MPISpace &rhs) = default;
@@ -93,7 +120,10 @@ public:
   MPISpace &operator=(const MPISpace &) = default;
   ~MPISpace() = default;
 
-  explicit MPISpace(const MPI_Comm &);
+  /**\brief Views allocated with this instance span the ranks of comm
+   *         only. Their PE index is the rank in comm; allocations and
+   *         fences are collective over comm. comm must outlive them. */
+  explicit MPISpace(const MPI_Comm &comm);
 
   void *allocate(const size_t arg_alloc_size) const;
 
@@ -107,19 +137,83 @@ public:
   /**\brief Return Name of the MemorySpace */
   static constexpr const char *name() { return m_name; }
 
+  /**\brief Complete all outstanding one-sided operations, including
+   *         puts issued through DeferredPut views, and synchronize the
+   *         ranks of the communicator of this instance */
   void fence();
 
+  /**\brief Complete outstanding one-sided operations on the allocation of
+   *         view v only. Remote writes are visible at their targets on
+   *         return; with barrier, the ranks of the communicator of v
+   *         synchronize afterwards */
+  template <class ViewType>
+  void fence(const ViewType &v, const bool barrier = true) const {
+    fence_window(v.impl_map().handle().win, barrier,
+                 v.impl_map().handle().scope);
+  }
+
+  /**\brief Complete outstanding operations on the allocation of view v
+   *         locally only: source buffers of puts may be reused and results
+   *         of gets are available, remote visibility is not implied */
+  template <class ViewType> void fence_local(const ViewType &v) const {
+    fence_window_local(v.impl_map().handle().win);
+  }
+
+  /**\brief Local completion of outstanding operations on all windows */
+  void fence_local();
+
+  static void fence_window(MPI_Win win, const bool barrier,
+                           MPI_Comm comm = MPI_COMM_WORLD);
+  static void fence_window_local(MPI_Win win);
+
+  /**\brief Rank of the calling process in and size of scope */
+  static int impl_my_pe(const scope_type &scope);
+  static int impl_num_pes(const scope_type &scope);
+  int impl_my_pe() const { return impl_my_pe(scope); }
+  int impl_num_pes() const { return impl_num_pes(scope); }
+
   int *rank_list;
   int allocation_mode;
   int64_t extent;
 
+  /* Communicator of the allocations, MPI_COMM_WORLD by default */
+  scope_type scope;
+
   static std::vector<MPI_Win> mpi_windows;
 
   static MPI_Win current_win;
 
+  /* Byte displacement of the last allocation in current_win, non-zero
+   * for allocations carved from a RemoteArena */
+  static MPI_Aint current_win_disp;
+
+  /* Set if the last allocation is attached to the dynamic window */
+  static Impl::MPIDynamicAllocation *current_dynamic;
+
+  /* With KOKKOS_ENABLE_MPISPACE_DYNAMIC_WINDOW, Symmetric, Asymmetric and
+   * Monolithic allocations are attached to a single dynamic window
+   * created by the first allocation, instead of creating a window each.
+   * The directory window publishes their addresses. */
+  static MPI_Win dynamic_win;
+  static MPI_Win directory_win;
+
+  /* Node-local window and on-node peer table of the last allocation in
+   * SymmetricShared mode, MPI_WIN_NULL and NULL otherwise */
+  static MPI_Win current_shared_win;
+  static void **current_node_ptrs;
+
+  /* Ranks of MPI_COMM_WORLD sharing memory with this rank. Instances
+   * over other communicators split their scope per allocation. */
+  static MPI_Comm node_comm;
+
+  /* Set on instances returned by RemoteArena::space(). Allocations are
+   * then carved from the window of the arena. */
+  std::shared_ptr<Impl::RemoteArenaState> arena;
+
   void impl_set_rank_list(int *const);
   void impl_set_allocation_mode(const int);
   void impl_set_extent(int64_t N);
+  void impl_set_arena(const std::shared_ptr<Impl::RemoteArenaState> &);
 
 private:
   static constexpr const char *m_name = "MPI";
@@ -178,6 +272,28 @@ public:
 
   MPI_Win win;
 
+  /* Byte displacement of the allocation in win */
+  MPI_Aint win_disp;
+
+  /* Set if the allocation is attached to the dynamic window, win_disp is
+   * then relative to the address of the allocation on each rank */
+  Kokkos::Experimental::Impl::MPIDynamicAllocation *dynamic;
+
+  /* Set for SymmetricShared allocations: the node-local window and the
+   * allocation base of every on-node peer, indexed by rank in the
+   * communicator of m_space */
+  MPI_Win shared_win;
+  void **node_ptrs;
+
+  /* Row offsets of Asymmetric and Monolithic allocations, see
+   * Kokkos::Experimental::Impl::PEPartition. Owned by the record. */
+  size_t *pe_offsets;
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  /* Access counters of the allocation. Owned by the record. */
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters;
+#endif
+
   inline std::string get_label() const {
     return std::string(RecordBase::head()->m_label);
   }
@@ -271,7 +387,9 @@ struct DeepCopy<Kokkos::Experimental::MPISpace, Kokkos::Experimental::MPISpace,
 
 } // namespace Kokkos
 
+#include <Kokkos_RemoteSpaces_Partition.hpp>
 #include <Kokkos_MPISpace_ViewMapping.hpp>
+#include <Kokkos_RemoteSpaces_Subview.hpp>
 #include <Kokkos_RemoteSpaces_DeepCopy.hpp>
 
 #endif // #define KOKKOS_MPISPACE_HPP
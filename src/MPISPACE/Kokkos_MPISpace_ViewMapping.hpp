@@ -42,7 +42,12 @@
 //@HEADER
 */
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 //----------------------------------------------------------------------------
 /** \brief  View mapping for non-specialized data type and standard layout */
 namespace Kokkos {
@@ -57,6 +62,7 @@ MPI_TYPE_MAP(char, MPI_SIGNED_CHAR)
 MPI_TYPE_MAP(unsigned char, MPI_UNSIGNED_CHAR)
 MPI_TYPE_MAP(short, MPI_SHORT)
 MPI_TYPE_MAP(unsigned short, MPI_UNSIGNED_SHORT)
+MPI_TYPE_MAP(int, MPI_INT)
 MPI_TYPE_MAP(float, MPI_FLOAT)
 MPI_TYPE_MAP(double, MPI_DOUBLE)
 MPI_TYPE_MAP(long, MPI_LONG)
@@ -65,355 +71,1105 @@ MPI_TYPE_MAP(unsigned, MPI_UNSIGNED)
 MPI_TYPE_MAP(unsigned long, MPI_UNSIGNED_LONG)
 MPI_TYPE_MAP(unsigned long long, MPI_UNSIGNED_LONG_LONG)
 
+inline MPI_Op get_mpi_op(const int op) {
+  switch (op) {
+  case Kokkos::Experimental::OpReplace:
+    return MPI_REPLACE;
+  case Kokkos::Experimental::OpSum:
+    return MPI_SUM;
+  case Kokkos::Experimental::OpProd:
+    return MPI_PROD;
+  case Kokkos::Experimental::OpMin:
+    return MPI_MIN;
+  case Kokkos::Experimental::OpMax:
+    return MPI_MAX;
+  default:
+    Kokkos::abort("MPISpace: unknown operation.");
+  }
+  return MPI_OP_NULL;
+}
+
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+void mpi_type_p(const T val, const MPI_Aint disp, const int pe, const MPI_Win& win)
+{
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  auto dtype = get_mpi_type<T>();
+  MPI_Put(&val, 1, dtype, pe,
+          disp, 1, dtype,
+          win);
+  MPI_Win_flush(pe, win);
+#endif
+  return;
+}
+
+/* Deferred variant of mpi_type_p. Only local completion is awaited
+ * since the origin buffer does not outlive the call; remote completion
+ * is established by the next MPISpace::fence(). */
 template <typename T>
 KOKKOS_DEFAULTED_FUNCTION
-void mpi_type_p(const T val, int offset, const int pe, const MPI_Win& win)
+void mpi_type_p_deferred(const T val, const MPI_Aint disp, const int pe,
+                         const MPI_Win& win)
 {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
   auto dtype = get_mpi_type<T>();
   MPI_Put(&val, 1, dtype, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(T), 1, dtype,
+          disp, 1, dtype,
           win);
-  MPI_Win_flush(0, win);
+  MPI_Win_flush_local(pe, win);
 #endif
   return;
 }
 
 template <typename T>
 KOKKOS_DEFAULTED_FUNCTION
-T mpi_type_g(T& val, int offset, const int pe, const MPI_Win& win)
+T mpi_type_g(T& val, const MPI_Aint disp, const int pe, const MPI_Win& win)
 {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
   auto dtype = get_mpi_type<T>();
   MPI_Get(&val, 1, dtype, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(T), 1,
+          disp, 1,
           dtype, win);
-  MPI_Win_flush(0, win);
+  MPI_Win_flush(pe, win);
 #endif
   return 0;
 }
 
-template <class T> 
+/* Variant of mpi_type_g for ReadOnly elements. Local completion of a
+ * get already delivers the value, it is not ordered with respect to
+ * other operations of the origin. */
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+void mpi_type_g_local(T& val, const MPI_Aint disp, const int pe,
+                      const MPI_Win& win)
+{
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  auto dtype = get_mpi_type<T>();
+  MPI_Get(&val, 1, dtype, pe,
+          disp, 1,
+          dtype, win);
+  MPI_Win_flush_local(pe, win);
+#endif
+  return;
+}
+
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+T mpi_type_fetch_op(const T val, const MPI_Op op, const MPI_Aint disp, const int pe,
+                    const MPI_Win& win)
+{
+  T ret = T();
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  auto dtype = get_mpi_type<T>();
+  MPI_Fetch_and_op(&val, &ret, dtype, pe,
+                   disp, op,
+                   win);
+  MPI_Win_flush(pe, win);
+#endif
+  return ret;
+}
+
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+void mpi_type_acc(const T val, const MPI_Op op, const MPI_Aint disp, const int pe,
+                  const MPI_Win& win)
+{
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  auto dtype = get_mpi_type<T>();
+  MPI_Accumulate(&val, 1, dtype, pe,
+                 disp, 1,
+                 dtype, op, win);
+  MPI_Win_flush(pe, win);
+#endif
+  return;
+}
+
+/* Deferred variant of mpi_type_acc for Relaxed elements, see
+ * mpi_type_p_deferred */
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+void mpi_type_acc_deferred(const T val, const MPI_Op op, const MPI_Aint disp,
+                           const int pe, const MPI_Win& win)
+{
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  auto dtype = get_mpi_type<T>();
+  MPI_Accumulate(&val, 1, dtype, pe,
+                 disp, 1,
+                 dtype, op, win);
+  MPI_Win_flush_local(pe, win);
+#endif
+  return;
+}
+
+// MPI_Compare_and_swap only accepts integer types, so values are swapped
+// through an unsigned integer of the same width.
+template <int N> struct mpi_cas_type;
+
+template <> struct mpi_cas_type<1> {
+  typedef uint8_t type;
+  static MPI_Datatype get() { return MPI_UINT8_T; }
+};
+
+template <> struct mpi_cas_type<2> {
+  typedef uint16_t type;
+  static MPI_Datatype get() { return MPI_UINT16_T; }
+};
+
+template <> struct mpi_cas_type<4> {
+  typedef uint32_t type;
+  static MPI_Datatype get() { return MPI_UINT32_T; }
+};
+
+template <> struct mpi_cas_type<8> {
+  typedef uint64_t type;
+  static MPI_Datatype get() { return MPI_UINT64_T; }
+};
+
+/* Atomically replaces the target with desired if it equals expected.
+ * Returns the value found at the target. */
+template <typename T>
+KOKKOS_DEFAULTED_FUNCTION
+T mpi_type_compare_swap(const T expected, const T desired, const MPI_Aint disp,
+                        const int pe, const MPI_Win& win)
+{
+  T ret = T();
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  typedef mpi_cas_type<sizeof(T)> cas_type;
+  typedef typename cas_type::type bits_type;
+  bits_type desired_bits, expected_bits, result_bits;
+  memcpy(&desired_bits, &desired, sizeof(T));
+  memcpy(&expected_bits, &expected, sizeof(T));
+  MPI_Compare_and_swap(&desired_bits, &expected_bits, &result_bits,
+                       cas_type::get(), pe,
+                       disp,
+                       win);
+  MPI_Win_flush(pe, win);
+  memcpy(&ret, &result_bits, sizeof(T));
+#endif
+  return ret;
+}
+
+/* Apply an update without a matching MPI_Op (e.g. /=, <<=) atomically
+ * by retrying MPI_Compare_and_swap until no other origin intervened.
+ * Returns the value found at the target before the update. */
+template <typename T, class UpdateType>
+KOKKOS_DEFAULTED_FUNCTION
+T mpi_type_cas_update(const UpdateType &update, const MPI_Aint disp, const int pe,
+                      const MPI_Win& win)
+{
+  T expected = T();
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  typedef mpi_cas_type<sizeof(T)> cas_type;
+  typedef typename cas_type::type bits_type;
+  expected = mpi_type_fetch_op(T(), MPI_NO_OP, disp, pe, win);
+  while (true) {
+    const T desired = update(expected);
+    bits_type desired_bits, expected_bits, result_bits;
+    memcpy(&desired_bits, &desired, sizeof(T));
+    memcpy(&expected_bits, &expected, sizeof(T));
+    MPI_Compare_and_swap(&desired_bits, &expected_bits, &result_bits,
+                         cas_type::get(), pe, disp, win);
+    MPI_Win_flush(pe, win);
+    if (result_bits == expected_bits)
+      break;
+    memcpy(&expected, &result_bits, sizeof(T));
+  }
+#endif
+  return expected;
+}
+
+template <class T, class Traits>
 struct MPIDataElement {
   typedef const T const_value_type;
   typedef T non_const_value_type;
+  typedef Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+      typename Traits::memory_traits>
+      memory_traits;
+  enum : bool {
+    is_relaxed = memory_traits::is_relaxed,
+    is_deferred_put = memory_traits::is_deferred_put || is_relaxed
+  };
   const MPI_Win * win;
-  int offset;
+  // Byte displacement of the element in the window of its allocation
+  MPI_Aint disp;
   int pe;
-  MPIDataElement(MPI_Win * win_, int pe_, int i_)
-      : win(win_), offset(i_), pe(pe_) {}
+  T *ptr;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+  MPIDataElement(MPI_Win * win_, int pe_, MPI_Aint disp_, T *ptr_,
+                 bool is_local_)
+      : win(win_), disp(disp_), pe(pe_), ptr(ptr_), is_local(is_local_) {}
+
+  /* Plain loads and stores of an element in local window memory bypass
+   * RMA. Read-modify-write operators always go through MPI so that they
+   * stay atomic with respect to accumulates from other ranks. */
+  KOKKOS_INLINE_FUNCTION
+  T get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    if (is_local)
+      return *ptr;
+    T tmp = T();
+    mpi_type_g(tmp, disp, pe, *win);
+    return tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (is_local)
+      *ptr = val;
+    else if (is_deferred_put)
+      mpi_type_p_deferred<T>(val, disp, pe, *win);
+    else
+      mpi_type_p<T>(val, disp, pe, *win);
+  }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator=(const_value_type &val) const {
-    mpi_type_p<T>(val, offset, pe, *win);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   void inc() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val++;
-    mpi_type_p(val, offset, pe, *win);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    if (is_relaxed)
+      mpi_type_acc_deferred(T(1), MPI_SUM, disp, pe, *win);
+    else
+      mpi_type_acc(T(1), MPI_SUM, disp, pe, *win);
   }
 
   KOKKOS_INLINE_FUNCTION
   void dec() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val--;
-    mpi_type_p(val, offset, pe, *win);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    if (is_relaxed)
+      mpi_type_acc_deferred(T(T(0) - T(1)), MPI_SUM, disp, pe, *win);
+    else
+      mpi_type_acc(T(T(0) - T(1)), MPI_SUM, disp, pe, *win);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator++() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val++;
-    mpi_type_p(val, offset, pe, *win);
-    return val;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_fetch_op(T(1), MPI_SUM, disp, pe, *win) + T(1));
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator--() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val--;
-    mpi_type_p(val, offset, pe, *win);
-    return val;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_fetch_op(T(T(0) - T(1)), MPI_SUM, disp, pe, *win) -
+             T(1));
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator++(int) const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val++;
-    mpi_type_p(val, offset, pe, *win);
-    return val;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return mpi_type_fetch_op(T(1), MPI_SUM, disp, pe, *win);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator--(int) const {
-    T val = T();
-    mpi_type_g(val, offset, pe, *win);
-    val--;
-    mpi_type_p(val, offset, pe, *win);
-    return val;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return mpi_type_fetch_op(T(T(0) - T(1)), MPI_SUM, disp, pe, *win);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator+=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp += val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_fetch_op(val, MPI_SUM, disp, pe, *win) + val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator-=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp -= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_fetch_op(T(T(0) - val), MPI_SUM, disp, pe, *win) -
+             val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator*=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp *= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_fetch_op(val, MPI_PROD, disp, pe, *win) * val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator/=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp /= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_cas_update<T>([=](const T x) { return T(x / val); },
+                                    disp, pe, *win) /
+             val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator%=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp %= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_cas_update<T>([=](const T x) { return T(x % val); },
+                                    disp, pe, *win) %
+             val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp &= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise operators require an integral value type");
+    return T(mpi_type_fetch_op(val, MPI_BAND, disp, pe, *win) & val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator^=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp ^= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise operators require an integral value type");
+    return T(mpi_type_fetch_op(val, MPI_BXOR, disp, pe, *win) ^ val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator|=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp |= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise operators require an integral value type");
+    return T(mpi_type_fetch_op(val, MPI_BOR, disp, pe, *win) | val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator<<=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp <<= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_cas_update<T>([=](const T x) { return T(x << val); },
+                                    disp, pe, *win)
+             << val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator>>=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    tmp >>= val;
-    mpi_type_p(tmp, offset, pe, *win);
-    return tmp;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return T(mpi_type_cas_update<T>([=](const T x) { return T(x >> val); },
+                                    disp, pe, *win) >>
+             val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator+(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp + val;
+    return get() + val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator-(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp - val;
+    return get() - val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator*(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp * val;
+    return get() * val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator/(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp / val;
+    return get() / val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator%(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp % val;
+    return get() % val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator!() const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return !tmp;
+    return !get();
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&&(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp && val;
+    return get() && val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator||(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp || val;
+    return get() || val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp & val;
+    return get() & val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator|(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp | val;
+    return get() | val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator^(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp ^ val;
+    return get() ^ val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator~() const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return ~tmp;
+    return ~get();
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator<<(const unsigned int &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp << val;
+    return get() << val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator>>(const unsigned int &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp >> val;
+    return get() >> val;
+  }
+
+  /* Remote atomics. Each returns the value found at the target before
+   * the update and is atomic with respect to all other atomics and
+   * compound operators on the element, including those issued by the
+   * owning rank. */
+  KOKKOS_INLINE_FUNCTION
+  T fetch_add(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return mpi_type_fetch_op(val, MPI_SUM, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_and(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise atomics require an integral value type");
+    return mpi_type_fetch_op(val, MPI_BAND, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_or(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise atomics require an integral value type");
+    return mpi_type_fetch_op(val, MPI_BOR, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_xor(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    static_assert(std::is_integral<T>::value,
+                  "Bitwise atomics require an integral value type");
+    return mpi_type_fetch_op(val, MPI_BXOR, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T exchange(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return mpi_type_fetch_op(val, MPI_REPLACE, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T compare_exchange(const_value_type &expected,
+                     const_value_type &desired) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return mpi_type_compare_swap(expected, desired, disp, pe, *win);
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator==(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp == val;
+    return get() == val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator!=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp != val;
+    return get() != val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator>=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp >= val;
+    return get() >= val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator<=(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp <= val;
+    return get() <= val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator<(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp < val;
+    return get() < val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator>(const_value_type &val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
-    return tmp > val;
+    return get() > val;
   }
 
   KOKKOS_INLINE_FUNCTION
   operator const_value_type() const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, *win);
+    return get();
+  }
+};
+
+/* Reference to an element of a ReadOnly view or a view of const value
+ * type. It only converts to the value of the element. */
+template <class T, class Traits>
+struct MPIReadElement {
+  typedef typename std::remove_const<T>::type non_const_value_type;
+  typedef const non_const_value_type const_value_type;
+  const MPI_Win * win;
+  MPI_Aint disp;
+  int pe;
+  const non_const_value_type *ptr;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+  MPIReadElement(MPI_Win * win_, int pe_, MPI_Aint disp_, T *ptr_,
+                 bool is_local_)
+      : win(win_), disp(disp_), pe(pe_), ptr(ptr_), is_local(is_local_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  non_const_value_type get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    if (is_local)
+      return *ptr;
+    non_const_value_type tmp = non_const_value_type();
+    mpi_type_g_local(tmp, disp, pe, *win);
     return tmp;
   }
+
+  KOKKOS_INLINE_FUNCTION
+  operator const_value_type() const {
+    return get();
+  }
+};
+
+/* Reference to an element of a WriteOnly view. It only supports
+ * assignment, stores complete remotely at the next MPISpace::fence(). */
+template <class T, class Traits>
+struct MPIWriteElement {
+  typedef const T const_value_type;
+  typedef T non_const_value_type;
+  const MPI_Win * win;
+  MPI_Aint disp;
+  int pe;
+  T *ptr;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+  MPIWriteElement(MPI_Win * win_, int pe_, MPI_Aint disp_, T *ptr_,
+                  bool is_local_)
+      : win(win_), disp(disp_), pe(pe_), ptr(ptr_), is_local(is_local_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (is_local)
+      *ptr = val;
+    else
+      mpi_type_p_deferred<T>(val, disp, pe, *win);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator=(const_value_type &val) const {
+    put(val);
+    return val;
+  }
+};
+
+template <class T, class Traits>
+using MPIElement = typename Kokkos::Experimental::Impl::remote_element<
+    T, Traits, MPIDataElement, MPIReadElement, MPIWriteElement>::type;
+
+/* Datatype of the elements of a strided layout in enumeration order */
+template <class T>
+inline MPI_Datatype
+mpi_strided_type(const Kokkos::Experimental::Impl::StridedLayout &layout) {
+  MPI_Datatype type;
+  MPI_Type_contiguous(sizeof(T), MPI_BYTE, &type);
+  for (int r = layout.rank - 1; r >= 0; r--) {
+    MPI_Datatype outer;
+    MPI_Type_create_hvector(layout.extent[r], 1, layout.stride[r] * sizeof(T),
+                            type, &outer);
+    MPI_Type_free(&type);
+    type = outer;
+  }
+  MPI_Type_commit(&type);
+  return type;
+}
+
+/* Datatype and count describing nbytes contiguous bytes. The counts of
+ * MPI calls are int, so transfers of INT_MAX bytes or more are described
+ * as one element of a type made of 1 GiB blocks and a remainder. */
+struct MPIBulkType {
+  enum : size_t { block_size = size_t(1) << 30 };
+
+  MPI_Datatype type;
+  int count;
+
+  explicit MPIBulkType(const size_t nbytes) : type(MPI_BYTE), count(0) {
+    if (nbytes < size_t(INT_MAX)) {
+      count = int(nbytes);
+      return;
+    }
+    MPI_Datatype block;
+    MPI_Type_contiguous(int(block_size), MPI_BYTE, &block);
+    int lengths[2] = {int(nbytes / block_size), int(nbytes % block_size)};
+    MPI_Aint displs[2] = {0, MPI_Aint(nbytes - nbytes % block_size)};
+    MPI_Datatype types[2] = {block, MPI_BYTE};
+    MPI_Type_create_struct(2, lengths, displs, types, &type);
+    MPI_Type_commit(&type);
+    MPI_Type_free(&block);
+    count = 1;
+  }
+
+  // Types may be freed while operations using them are pending
+  ~MPIBulkType() {
+    if (type != MPI_BYTE)
+      MPI_Type_free(&type);
+  }
+
+  MPIBulkType(const MPIBulkType &) = delete;
+  MPIBulkType &operator=(const MPIBulkType &) = delete;
+};
+
+/* Completion handle of a non-blocking bulk transfer. Puts are only
+ * locally complete when their request completes, wait() and test()
+ * additionally flush them to the target. */
+struct MPIRemoteRequest {
+  MPI_Request request;
+  MPI_Win win;
+  // Target of a put awaiting remote completion, -1 otherwise
+  int pe;
+
+  MPIRemoteRequest()
+      : request(MPI_REQUEST_NULL), win(MPI_WIN_NULL), pe(-1) {}
+
+  /* Blocks until the transfer completed */
+  void wait() {
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    complete_put();
+  }
+
+  /* Returns true once the transfer completed */
+  bool test() {
+    int flag = 1;
+    MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+    if (flag)
+      complete_put();
+    return flag;
+  }
+
+private:
+  void complete_put() {
+    if (pe >= 0) {
+      MPI_Win_flush(pe, win);
+      pe = -1;
+    }
+  }
 };
 
-template <class T> 
+template <class T, class Traits>
 struct MPIDataHandle {
+  enum : bool {
+    is_remote_only = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_remote_only
+  };
   T *ptr;
   mutable MPI_Win win;
+  // Element offset of ptr within the segment, non-zero for subviews
+  size_t offset;
+  int my_rank;
+  // Allocation bases of on-node peers, NULL unless SymmetricShared
+  void *const *node_ptrs;
+  // Byte displacement of the start of the segment in win. Allocations
+  // carved from a RemoteArena share the window of the arena.
+  MPI_Aint disp;
+  // Set for allocations in the dynamic window, disp is then relative to
+  // the address of the allocation on the target rank
+  const Kokkos::Experimental::Impl::MPIDynamicAllocation *dynamic;
+  // Communicator of the allocation, PE indices are ranks in it
+  MPI_Comm scope;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  // Access counters of the allocation, NULL if untracked
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
   KOKKOS_INLINE_FUNCTION
-  MPIDataHandle() : ptr(NULL) {}
+  MPIDataHandle()
+      : ptr(NULL), win(MPI_WIN_NULL), offset(0), my_rank(-1),
+        node_ptrs(NULL), disp(sizeof(SharedAllocationHeader)),
+        dynamic(NULL), scope(MPI_COMM_WORLD) {}
   KOKKOS_INLINE_FUNCTION
-  MPIDataHandle(T *ptr_, MPI_Win &win_) : ptr(ptr_), win(win_) {}
+  MPIDataHandle(T *ptr_)
+      : ptr(ptr_), win(MPI_WIN_NULL), offset(0), my_rank(-1),
+        node_ptrs(NULL), disp(sizeof(SharedAllocationHeader)),
+        dynamic(NULL), scope(MPI_COMM_WORLD) {}
+  KOKKOS_INLINE_FUNCTION
+  MPIDataHandle(
+      T *ptr_, MPI_Win &win_, size_t offset_ = 0, int my_rank_ = -1,
+      void *const *node_ptrs_ = NULL,
+      MPI_Aint disp_ = sizeof(SharedAllocationHeader),
+      const Kokkos::Experimental::Impl::MPIDynamicAllocation *dynamic_ = NULL,
+      MPI_Comm scope_ = MPI_COMM_WORLD)
+      : ptr(ptr_), win(win_), offset(offset_), my_rank(my_rank_),
+        node_ptrs(node_ptrs_), disp(disp_), dynamic(dynamic_),
+        scope(scope_) {}
+
+  // Also converts handles of T to handles of const T
+  template <class SrcT, class SrcTraits>
+  KOKKOS_INLINE_FUNCTION
+  MPIDataHandle(const MPIDataHandle<SrcT, SrcTraits> &rhs)
+      : ptr(rhs.ptr), win(rhs.win), offset(rhs.offset),
+        my_rank(rhs.my_rank), node_ptrs(rhs.node_ptrs), disp(rhs.disp),
+        dynamic(rhs.dynamic), scope(rhs.scope) {
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    counters = rhs.counters;
+#endif
+  }
+
+  /* Rank of the calling process in scope */
+  KOKKOS_INLINE_FUNCTION int impl_my_pe() const { return my_rank; }
+
+  /* Displacement of element i of the segment of pe in win */
+  KOKKOS_INLINE_FUNCTION
+  MPI_Aint target_disp(const int pe, const size_t i) const {
+    return (dynamic ? dynamic->base(pe) : 0) + disp +
+           (offset + i) * sizeof(T);
+  }
+
+  /* Address of element i of the segment of pe if it can be reached by
+   * load/store from this rank, NULL otherwise. */
+  KOKKOS_INLINE_FUNCTION
+  T *local_ptr(const int pe, const size_t i) const {
+    if (is_remote_only)
+      return NULL;
+    if (pe == my_rank)
+      return ptr + i;
+    if (node_ptrs && node_ptrs[pe])
+      return reinterpret_cast<T *>(static_cast<char *>(node_ptrs[pe]) +
+                                   disp) +
+             offset + i;
+    return NULL;
+  }
 
   template <typename iType>
-  KOKKOS_INLINE_FUNCTION MPIDataElement<T> 
+  KOKKOS_INLINE_FUNCTION MPIElement<T, Traits>
   operator()(const int &pe, const iType &i) const {
-    MPIDataElement<T> element(&win, pe, i);
+    T *lptr = local_ptr(pe, i);
+    MPIElement<T, Traits> element(&win, pe, target_disp(pe, i), lptr,
+                                  lptr != NULL);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    element.counters = counters;
+#endif
     return element;
   }
+
+  /* Bulk transfers of n contiguous elements starting at element first
+   * of the segment owned by pe. Both complete before returning. */
+  void get(T *dst, const int pe, const size_t first, const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe,
+                               local_ptr(pe, first) != NULL, nbytes);
+    if (T *lptr = local_ptr(pe, first)) {
+      memcpy(dst, lptr, nbytes);
+      return;
+    }
+    const MPIBulkType bytes(nbytes);
+    MPI_Get(dst, bytes.count, bytes.type, pe,
+            target_disp(pe, first),
+            bytes.count, bytes.type, win);
+    MPI_Win_flush(pe, win);
+  }
+
+  void put(const T *src, const int pe, const size_t first,
+           const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe,
+                               local_ptr(pe, first) != NULL, nbytes);
+    if (T *lptr = local_ptr(pe, first)) {
+      memcpy(lptr, src, nbytes);
+      return;
+    }
+    const MPIBulkType bytes(nbytes);
+    MPI_Put(src, bytes.count, bytes.type, pe,
+            target_disp(pe, first),
+            bytes.count, bytes.type, win);
+    MPI_Win_flush(pe, win);
+  }
+
+  /* Transfers between a strided local buffer and the strided region of
+   * the segment owned by pe that starts at element first, issued as one
+   * RMA operation with derived datatypes on both sides. Both complete
+   * before returning. */
+  void get_strided(
+      T *dst, const Kokkos::Experimental::Impl::StridedLayout &dst_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &src_layout) const {
+    if (src_layout.size() == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe,
+                               local_ptr(pe, first) != NULL,
+                               src_layout.size() * sizeof(T));
+    if (T *lptr = local_ptr(pe, first)) {
+      Kokkos::Experimental::Impl::strided_copy(dst, dst_layout,
+                                               (const T *)lptr, src_layout);
+      return;
+    }
+    MPI_Datatype origin = mpi_strided_type<T>(dst_layout);
+    MPI_Datatype target = mpi_strided_type<T>(src_layout);
+    MPI_Get(dst, 1, origin, pe,
+            target_disp(pe, first), 1,
+            target, win);
+    MPI_Win_flush(pe, win);
+    MPI_Type_free(&origin);
+    MPI_Type_free(&target);
+  }
+
+  void put_strided(
+      const T *src, const Kokkos::Experimental::Impl::StridedLayout &src_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &dst_layout) const {
+    if (src_layout.size() == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe,
+                               local_ptr(pe, first) != NULL,
+                               src_layout.size() * sizeof(T));
+    if (T *lptr = local_ptr(pe, first)) {
+      Kokkos::Experimental::Impl::strided_copy(lptr, dst_layout, src,
+                                               src_layout);
+      return;
+    }
+    MPI_Datatype origin = mpi_strided_type<T>(src_layout);
+    MPI_Datatype target = mpi_strided_type<T>(dst_layout);
+    MPI_Put(src, 1, origin, pe,
+            target_disp(pe, first), 1,
+            target, win);
+    MPI_Win_flush(pe, win);
+    MPI_Type_free(&origin);
+    MPI_Type_free(&target);
+  }
+
+  typedef MPIRemoteRequest request_type;
+
+  /* Non-blocking counterparts of get/put. The transfer is complete once
+   * the returned request is. Local segments are copied immediately. */
+  template <class ExecSpace>
+  request_type get_async(const ExecSpace &, T *dst, const int pe,
+                         const size_t first, const size_t n) const {
+    request_type req;
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe,
+                               local_ptr(pe, first) != NULL, nbytes);
+    if (T *lptr = local_ptr(pe, first)) {
+      memcpy(dst, lptr, nbytes);
+      return req;
+    }
+    const MPIBulkType bytes(nbytes);
+    MPI_Rget(dst, bytes.count, bytes.type, pe,
+             target_disp(pe, first),
+             bytes.count, bytes.type, win, &req.request);
+    return req;
+  }
+
+  template <class ExecSpace>
+  request_type put_async(const ExecSpace &, const T *src, const int pe,
+                         const size_t first, const size_t n) const {
+    request_type req;
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe,
+                               local_ptr(pe, first) != NULL, nbytes);
+    if (T *lptr = local_ptr(pe, first)) {
+      memcpy(lptr, src, nbytes);
+      return req;
+    }
+    const MPIBulkType bytes(nbytes);
+    MPI_Rput(src, bytes.count, bytes.type, pe,
+             target_disp(pe, first),
+             bytes.count, bytes.type, win, &req.request);
+    req.win = win;
+    req.pe = pe;
+    return req;
+  }
+
+  /* Combines values[j] into element offsets[j] of the segment owned by
+   * pe with op, issued as a single accumulate. Offsets must be distinct.
+   * Completes before returning. */
+  void scatter(const int pe, const size_t *offsets, const T *values,
+               const size_t n, const MPI_Op op) const {
+    if (n == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, false, n * sizeof(T));
+    std::vector<MPI_Aint> displs(n);
+    for (size_t j = 0; j < n; j++)
+      displs[j] = offsets[j] * sizeof(T);
+    MPI_Datatype dtype = get_mpi_type<T>();
+    MPI_Datatype target;
+    MPI_Type_create_hindexed_block(n, 1, displs.data(), dtype, &target);
+    MPI_Type_commit(&target);
+    MPI_Accumulate(values, n, dtype, pe, target_disp(pe, 0), 1, target, op,
+                   win);
+    MPI_Win_flush(pe, win);
+    MPI_Type_free(&target);
+  }
+
+  /* Reads element offsets[j] of the segment owned by pes[j] into dst[j]
+   * for j < n. Elements are grouped by PE and each group is read with a
+   * single MPI_Get over indexed datatypes on both sides. Completes before
+   * returning. */
+  void gather(T *dst, const int *pes, const size_t *offsets,
+              const size_t n) const {
+    if (n == 0)
+      return;
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&](const size_t a, const size_t b) {
+                       return pes[a] < pes[b];
+                     });
+    MPI_Datatype elem;
+    MPI_Type_contiguous(sizeof(T), MPI_BYTE, &elem);
+    std::vector<MPI_Datatype> types;
+    std::vector<MPI_Aint> origin_displs, target_displs;
+    for (size_t b = 0; b < n;) {
+      const int pe = pes[order[b]];
+      size_t e = b;
+      while (e < n && pes[order[e]] == pe)
+        e++;
+      T *lptr = local_ptr(pe, 0);
+      KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, lptr != NULL,
+                                 (e - b) * sizeof(T));
+      if (lptr) {
+        for (size_t j = b; j < e; j++)
+          dst[order[j]] = lptr[offsets[order[j]]];
+      } else {
+        origin_displs.resize(e - b);
+        target_displs.resize(e - b);
+        for (size_t j = b; j < e; j++) {
+          origin_displs[j - b] = order[j] * sizeof(T);
+          target_displs[j - b] = offsets[order[j]] * sizeof(T);
+        }
+        MPI_Datatype origin, target;
+        MPI_Type_create_hindexed_block(e - b, 1, origin_displs.data(), elem,
+                                       &origin);
+        MPI_Type_create_hindexed_block(e - b, 1, target_displs.data(), elem,
+                                       &target);
+        MPI_Type_commit(&origin);
+        MPI_Type_commit(&target);
+        MPI_Get(dst, 1, origin, pe, target_disp(pe, 0), 1, target, win);
+        types.push_back(origin);
+        types.push_back(target);
+      }
+      b = e;
+    }
+    if (!types.empty())
+      MPI_Win_flush_all(win);
+    for (MPI_Datatype &type : types)
+      MPI_Type_free(&type);
+    MPI_Type_free(&elem);
+  }
+
+  /* Puts n elements like put, then updates element sig_index of the
+   * segment of pe in the signal allocation of sig with value. The data
+   * is complete at pe before the signal changes. */
+  template <class SigHandle>
+  void put_signal(const T *src, const int pe, const size_t first,
+                  const size_t n, const SigHandle &sig,
+                  const size_t sig_index, const uint64_t value,
+                  const int sig_op) const {
+    put(src, pe, first, n);
+    sig.signal(pe, sig_index, value, sig_op);
+  }
+
+  /* Atomically sets or adds value to element i of the segment of pe of
+   * a signal allocation. Completes before returning. */
+  void signal(const int pe, const size_t i, const uint64_t value,
+              const int sig_op) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe,
+                               local_ptr(pe, i) != NULL, sizeof(T));
+    MPI_Accumulate(&value, 1, MPI_UINT64_T, pe, target_disp(pe, i), 1,
+                   MPI_UINT64_T,
+                   sig_op == Kokkos::Experimental::SignalAdd ? MPI_SUM
+                                                             : MPI_REPLACE,
+                   win);
+    MPI_Win_flush(pe, win);
+  }
+
+  /* Blocks until element i of the local segment of a signal allocation
+   * satisfies cmp against cmp_value and returns it. Stores completed at
+   * this rank before the signal changed are visible afterwards. */
+  uint64_t wait_until(const size_t i, const int cmp,
+                      const uint64_t cmp_value) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    const int pe = Kokkos::Experimental::MPISpace::impl_my_pe(scope);
+    uint64_t value;
+    do {
+      MPI_Fetch_and_op(NULL, &value, MPI_UINT64_T, pe, target_disp(pe, i),
+                       MPI_NO_OP, win);
+      MPI_Win_flush(pe, win);
+    } while (
+        !Kokkos::Experimental::Impl::signal_compare(value, cmp, cmp_value));
+    MPI_Win_sync(win);
+    return value;
+  }
+
+  /* Device-side counterparts of get/put for team- and thread-level
+   * local_deep_copy. One member of the team issues the transfer. */
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_get(const TeamType &team, T *dst,
+                                       const int pe, const size_t first,
+                                       const size_t n) const {
+    Kokkos::single(Kokkos::PerTeam(team), [&]() { get(dst, pe, first, n); });
+    team.team_barrier();
+  }
+
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_put(const TeamType &team, const T *src,
+                                       const int pe, const size_t first,
+                                       const size_t n) const {
+    team.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(team), [&]() { put(src, pe, first, n); });
+  }
+
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_gather(const TeamType &team, T *dst,
+                                          const int *pes,
+                                          const size_t *offsets,
+                                          const size_t n) const {
+    team.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { gather(dst, pes, offsets, n); });
+    team.team_barrier();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_get(T *dst, const int pe, const size_t first,
+                  const size_t n) const {
+    get(dst, pe, first, n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_put(const T *src, const int pe, const size_t first,
+                  const size_t n) const {
+    put(src, pe, first, n);
+  }
+
+  template <class SigHandle>
+  KOKKOS_INLINE_FUNCTION void
+  thread_put_signal(const T *src, const int pe, const size_t first,
+                    const size_t n, const SigHandle &sig,
+                    const size_t sig_index, const uint64_t value,
+                    const int sig_op) const {
+    put_signal(src, pe, first, n, sig, sig_index, value, sig_op);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_signal(const int pe, const size_t i, const uint64_t value,
+                     const int sig_op) const {
+    signal(pe, i, value, sig_op);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  uint64_t thread_wait_until(const size_t i, const int cmp,
+                             const uint64_t cmp_value) const {
+    return wait_until(i, cmp, cmp_value);
+  }
 };
 
 template <class Traits>
@@ -423,16 +1179,34 @@ struct ViewDataHandle<
                                          Kokkos::Experimental::RemoteSpaceSpecializeTag>::value>::type> {
 
   typedef typename Traits::value_type value_type;
-  typedef MPIDataHandle<value_type> handle_type;
-  typedef MPIDataElement<value_type> return_type;
+  typedef MPIDataHandle<value_type, Traits> handle_type;
+  typedef MPIElement<value_type, Traits> return_type;
   typedef Kokkos::Impl::SharedAllocationTracker track_type;
 
   KOKKOS_INLINE_FUNCTION
   static handle_type assign(value_type *arg_data_ptr,
                             track_type const &arg_tracker) {
-    return handle_type(
-        arg_data_ptr,
-        arg_tracker.template get_record<Kokkos::Experimental::MPISpace>()->win);
+    auto *record =
+        arg_tracker.template get_record<Kokkos::Experimental::MPISpace>();
+    handle_type handle(arg_data_ptr, record->win, 0, -1, record->node_ptrs,
+                       record->win_disp + sizeof(SharedAllocationHeader),
+                       record->dynamic, record->m_space.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    handle.counters = record->counters;
+#endif
+    return handle;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static handle_type assign(handle_type const arg_handle, size_t offset) {
+    handle_type handle(arg_handle.ptr + offset, arg_handle.win,
+                       arg_handle.offset + offset, arg_handle.my_rank,
+                       arg_handle.node_ptrs, arg_handle.disp,
+                       arg_handle.dynamic, arg_handle.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    handle.counters = arg_handle.counters;
+#endif
+    return handle;
   }
 };
 
@@ -477,13 +1251,23 @@ private:
 
   typedef typename ViewDataHandle<Traits>::handle_type handle_type;
 
+  enum : bool {
+    is_fixed_pe = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_fixed_pe
+  };
+
   handle_type m_handle;
   offset_type m_offset;
   int m_num_pes;
+  // First PE addressed by the view, non-zero for subviews
+  int m_pe_offset;
+  // Row distribution of Asymmetric and Monolithic allocations
+  Kokkos::Experimental::Impl::PEPartition m_partition;
 
   KOKKOS_INLINE_FUNCTION
   ViewMapping(const handle_type &arg_handle, const offset_type &arg_offset)
-      : m_handle(arg_handle), m_offset(arg_offset) {}
+      : m_handle(arg_handle), m_offset(arg_offset), m_num_pes(0),
+        m_pe_offset(0) {}
 
 public:
   typedef void printable_label_typedef;
@@ -496,7 +1280,8 @@ public:
 
   template <typename iType>
   KOKKOS_INLINE_FUNCTION constexpr size_t extent(const iType &r) const {
-    return m_offset.m_dim.extent(r);
+    return (r == 0 && m_partition.is_monolithic) ? m_partition.global_rows
+                                                 : m_offset.m_dim.extent(r);
   }
 
   KOKKOS_INLINE_FUNCTION constexpr typename Traits::array_layout
@@ -505,7 +1290,9 @@ public:
   }
 
   KOKKOS_INLINE_FUNCTION constexpr size_t dimension_0() const {
-    return m_num_pes;
+    return is_fixed_pe ? m_offset.dimension_0()
+                       : m_partition.is_monolithic ? m_partition.global_rows
+                                                   : m_num_pes;
   }
   KOKKOS_INLINE_FUNCTION constexpr size_t dimension_1() const {
     return m_offset.dimension_1();
@@ -565,9 +1352,10 @@ public:
   //----------------------------------------
   // Range span
 
-  /** \brief  Span of the mapped range */
+  /** \brief  Span of the mapped range in the local segment */
   KOKKOS_INLINE_FUNCTION constexpr size_t span() const {
-    return m_offset.span();
+    return m_partition.is_monolithic ? m_offset.span() * m_partition.local_rows
+                                     : m_offset.span();
   }
 
   /** \brief  Is the mapped range span contiguous */
@@ -583,60 +1371,77 @@ public:
     return m_handle.ptr;
   }
 
+  /** \brief  Query the remote data handle */
+  KOKKOS_INLINE_FUNCTION const handle_type &handle() const { return m_handle; }
+
+  /** \brief  Query the first PE addressed by the view */
+  KOKKOS_INLINE_FUNCTION int pe_offset() const { return m_pe_offset; }
+
+  /** \brief  Query the row distribution of the allocation */
+  KOKKOS_INLINE_FUNCTION
+  const Kokkos::Experimental::Impl::PEPartition &partition() const {
+    return m_partition;
+  }
+
   //----------------------------------------
   // The View class performs all rank and bounds checking before
   // calling these element reference methods.
 
   KOKKOS_FORCEINLINE_FUNCTION
-  reference_type reference() const { return m_handle[0]; }
+  reference_type reference() const { return m_handle(m_pe_offset, 0); }
 
-  template <typename I0>
+  /* Element i of the segment selected by the leading index i0. For
+   * Monolithic views i0 is a global row, otherwise a PE relative to
+   * m_pe_offset. */
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  !std::is_same<typename Traits::array_layout,
-                                                Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+  reference_type pe_reference(const size_t i0, const size_t i) const {
+    if (!m_partition.is_monolithic)
+      return m_handle(m_pe_offset + i0, i);
+    const int pe = m_partition.owner(i0);
+    return m_handle(pe, (i0 - m_partition.offsets[pe]) * m_offset.span() + i);
   }
 
+  // Views with a fixed PE address the segment of PE m_pe_offset only,
+  // otherwise the leading index selects the segment, see pe_reference.
   template <typename I0>
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  std::is_same<typename Traits::array_layout,
-                                               Kokkos::LayoutStride>::value,
-                              reference_type>::type
+      typename std::enable_if<std::is_integral<I0>::value, reference_type>::type
       reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+    return is_fixed_pe ? m_handle(m_pe_offset, m_offset(i0))
+                       : pe_reference(i0, 0);
   }
 
   template <typename I0, typename I1>
-  KOKKOS_FORCEINLINE_FUNCTION const reference_type
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1) const {
-    const reference_type element = m_handle(i0, m_offset(0, i1));
-    return element;
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1))
+               : pe_reference(i0, m_offset(0, i1));
   }
 
   template <typename I0, typename I1, typename I2>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2) const {
-    return m_handle(i0, m_offset(0, i1, i2));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2))
+               : pe_reference(i0, m_offset(0, i1, i2));
   }
 
   template <typename I0, typename I1, typename I2, typename I3>
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3))
+               : pe_reference(i0, m_offset(0, i1, i2, i3));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2,
-                                                       const I3 &i3,
-                                                       const I4 &i4) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
+            const I4 &i4) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -644,7 +1449,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -652,7 +1459,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -660,7 +1469,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6, const I7 &i7) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6, i7))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
   }
 
   //----------------------------------------
@@ -672,32 +1483,38 @@ private:
 public:
   /** \brief  Span, in bytes, of the referenced memory */
   KOKKOS_INLINE_FUNCTION constexpr size_t memory_span() const {
-    return (m_offset.span() * sizeof(typename Traits::value_type) +
-            MemorySpanMask) &
+    return (span() * sizeof(typename Traits::value_type) + MemorySpanMask) &
            ~size_t(MemorySpanMask);
   }
 
   //----------------------------------------
 
   KOKKOS_INLINE_FUNCTION ~ViewMapping() {}
-  KOKKOS_INLINE_FUNCTION ViewMapping() : m_handle(), m_offset(), m_num_pes(0) {}
+  KOKKOS_INLINE_FUNCTION ViewMapping()
+      : m_handle(), m_offset(), m_num_pes(0), m_pe_offset(0) {}
   KOKKOS_INLINE_FUNCTION ViewMapping(const ViewMapping &rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_INLINE_FUNCTION ViewMapping &operator=(const ViewMapping &rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
   KOKKOS_INLINE_FUNCTION ViewMapping(ViewMapping &&rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_INLINE_FUNCTION ViewMapping &operator=(ViewMapping &&rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
@@ -734,6 +1551,7 @@ public:
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
     MPI_Comm_size(MPI_COMM_WORLD, &m_num_pes);
+    m_pe_offset = 0;
   }
 
   /**\brief  Assign data */
@@ -758,6 +1576,9 @@ public:
     typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
         record_type;
 
+    static_assert(!is_fixed_pe,
+                  "Views with a fixed PE can only be created as subviews");
+
     // Query the mapping for byte-size of allocation.
     // If padding is allowed then pass in sizeof value type
     // for padding computation.
@@ -770,23 +1591,56 @@ public:
       layout.dimension[i] = arg_layout.dimension[i];
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
-    MPI_Comm_size(MPI_COMM_WORLD, &m_num_pes);
+    const memory_space &space =
+        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
+            .value;
+    m_num_pes = space.impl_num_pes();
+    m_pe_offset = 0;
+
+    const int allocation_mode = space.allocation_mode;
+    size_t *pe_offsets = NULL;
+    if (allocation_mode == Kokkos::Experimental::Asymmetric ||
+        allocation_mode == Kokkos::Experimental::Monolithic) {
+      const bool is_monolithic =
+          allocation_mode == Kokkos::Experimental::Monolithic;
+      // Offsets within a segment only agree across PEs of different extents
+      // if the varying extent is the slowest running one
+      if (!is_monolithic && Traits::rank > 2 &&
+          !std::is_same<typename Traits::array_layout,
+                        Kokkos::LayoutRight>::value)
+        Kokkos::abort("Asymmetric views of rank > 2 require LayoutRight");
+      const size_t local_rows =
+          is_monolithic ? arg_layout.dimension[0]
+                        : (Traits::rank > 1 ? arg_layout.dimension[1] : 1);
+      pe_offsets = Kokkos::Experimental::Impl::allgather_pe_offsets(
+          local_rows, space.scope);
+      m_partition = Kokkos::Experimental::Impl::PEPartition(
+          pe_offsets, pe_offsets, m_num_pes, is_monolithic, local_rows,
+          pe_offsets[m_num_pes]);
+    }
 
     const size_t alloc_size = memory_span();
 
     // Create shared memory tracking record with allocate memory from the memory
     // space
     record_type *const record = record_type::allocate(
-        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
-            .value,
+        space,
         ((Kokkos::Impl::ViewCtorProp<void, std::string> const &)arg_prop).value,
         alloc_size);
+    record->pe_offsets = pe_offsets;
 
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     if (alloc_size) {
 #endif
       m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()),
-                             record->win);
+                             record->win, 0, space.impl_my_pe(),
+                             record->node_ptrs,
+                             record->win_disp +
+                                 sizeof(SharedAllocationHeader),
+                             record->dynamic, space.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+      m_handle.counters = record->counters;
+#endif
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     }
 #endif
@@ -804,4 +1658,123 @@ public:
 
 } // namespace Impl
 
+namespace Experimental {
+namespace Impl {
+
+/* Collectives over the local segments of symmetric allocations. The
+ * segments are plain local memory of the window, so MPI collectives on
+ * the communicator of the allocation operate on them directly. Execution
+ * space instances are only used to order the collective after preceding
+ * work. */
+template <> struct RemoteCollectives<Kokkos::Experimental::MPISpace> {
+  typedef Kokkos::Experimental::MPISpace::scope_type scope_type;
+
+  // Reductions are element-wise and issued in chunks of at most INT_MAX
+  // elements, broadcast and fcollect move bytes with an MPIBulkType
+  template <class T>
+  static void allreduce(scope_type scope, T *dst, const T *src,
+                        const size_t n, const int op) {
+    for (size_t first = 0; first < n; first += size_t(INT_MAX)) {
+      const int count = int(std::min(n - first, size_t(INT_MAX)));
+      MPI_Allreduce(dst == src ? MPI_IN_PLACE : src + first, dst + first,
+                    count, Kokkos::Impl::get_mpi_type<T>(),
+                    Kokkos::Impl::get_mpi_op(op), scope);
+    }
+  }
+
+  template <class T>
+  static void reduce(scope_type scope, T *dst, const T *src, const size_t n,
+                     const int op, const int root) {
+    int rank;
+    MPI_Comm_rank(scope, &rank);
+    for (size_t first = 0; first < n; first += size_t(INT_MAX)) {
+      const int count = int(std::min(n - first, size_t(INT_MAX)));
+      MPI_Reduce((dst == src && rank == root) ? MPI_IN_PLACE : src + first,
+                 dst + first, count, Kokkos::Impl::get_mpi_type<T>(),
+                 Kokkos::Impl::get_mpi_op(op), root, scope);
+    }
+  }
+
+  template <class T>
+  static void broadcast(scope_type scope, T *dst, const T *src,
+                        const size_t n, const int root) {
+    int rank;
+    MPI_Comm_rank(scope, &rank);
+    if (rank == root && dst != src)
+      std::memcpy(dst, src, n * sizeof(T));
+    const Kokkos::Impl::MPIBulkType bytes(n * sizeof(T));
+    MPI_Bcast(dst, bytes.count, bytes.type, root, scope);
+  }
+
+  template <class T>
+  static void fcollect(scope_type scope, T *dst, const T *src,
+                       const size_t n) {
+    const Kokkos::Impl::MPIBulkType bytes(n * sizeof(T));
+    MPI_Allgather(src, bytes.count, bytes.type, dst, bytes.count, bytes.type,
+                  scope);
+  }
+
+  template <class ExecSpace, class T>
+  static void allreduce(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int op) {
+    exec.fence();
+    allreduce(scope, dst, src, n, op);
+  }
+
+  template <class ExecSpace, class T>
+  static void reduce(const ExecSpace &exec, scope_type scope, T *dst,
+                     const T *src, const size_t n, const int op,
+                     const int root) {
+    exec.fence();
+    reduce(scope, dst, src, n, op, root);
+  }
+
+  template <class ExecSpace, class T>
+  static void broadcast(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int root) {
+    exec.fence();
+    broadcast(scope, dst, src, n, root);
+  }
+
+  template <class ExecSpace, class T>
+  static void fcollect(const ExecSpace &exec, scope_type scope, T *dst,
+                       const T *src, const size_t n) {
+    exec.fence();
+    fcollect(scope, dst, src, n);
+  }
+
+  /* Called by one team per PE. A single thread of the team issues the
+   * collective, which requires MPI_THREAD_SERIALIZED or higher when the
+   * team does not run on the main thread. */
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_allreduce(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int op) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { allreduce(scope, dst, src, n, op); });
+    team.team_barrier();
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_broadcast(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int root) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { broadcast(scope, dst, src, n, root); });
+    team.team_barrier();
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_fcollect(const TeamType &team, scope_type scope, T *dst, const T *src,
+                const size_t n) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { fcollect(scope, dst, src, n); });
+    team.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace Experimental
+
 } // namespace Kokkos
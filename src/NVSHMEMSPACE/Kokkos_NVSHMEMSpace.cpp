@@ -44,6 +44,7 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_NVSHMEMSpace.hpp>
+#include <map>
 #include <nvshmem.h>
 
 #if defined(KOKKOS_ENABLE_PROFILING)
@@ -53,8 +54,69 @@
 namespace Kokkos {
 namespace Experimental {
 
+namespace {
+
+/* Translation tables of the teams used so far, readable from kernels */
+const int *team_pe_map(nvshmem_team_t team) {
+  static std::map<nvshmem_team_t, int *> maps;
+  if (team == NVSHMEM_TEAM_WORLD)
+    return NULL;
+  int *&map = maps[team];
+  if (!map) {
+    const int num_pes = nvshmem_team_n_pes(team);
+    cudaMallocManaged(&map, num_pes * sizeof(int));
+    for (int pe = 0; pe < num_pes; pe++)
+      map[pe] = nvshmem_team_translate_pe(team, pe, NVSHMEM_TEAM_WORLD);
+  }
+  return map;
+}
+
+/* Peer table of an allocation, see the peer_ptrs member of its record.
+ * nvshmem_ptr returns NULL for PEs that are only reachable through the
+ * network. */
+void **query_peer_ptrs(const NVSHMEMSpace &space, void *ptr) {
+  if (!ptr)
+    return NULL;
+  const int num_pes = space.impl_num_pes();
+  const int my_pe = space.impl_my_pe();
+  void **peer_ptrs = NULL;
+  cudaMallocManaged(&peer_ptrs, num_pes * sizeof(void *));
+  bool any_peer = false;
+  for (int pe = 0; pe < num_pes; pe++) {
+    const int world_pe = space.pe_map ? space.pe_map[pe] : pe;
+    peer_ptrs[pe] = pe == my_pe ? NULL : nvshmem_ptr(ptr, world_pe);
+    any_peer = any_peer || peer_ptrs[pe] != NULL;
+  }
+  if (!any_peer) {
+    cudaFree(peer_ptrs);
+    return NULL;
+  }
+  return peer_ptrs;
+}
+
+} // namespace
+
 /* Default allocation mechanism */
-NVSHMEMSpace::NVSHMEMSpace() : allocation_mode(Symmetric) {}
+NVSHMEMSpace::NVSHMEMSpace()
+    : allocation_mode(Symmetric), scope(NVSHMEM_TEAM_WORLD), pe_map(NULL) {}
+
+NVSHMEMSpace::NVSHMEMSpace(const MPI_Comm &comm)
+    : allocation_mode(Symmetric), scope(NVSHMEM_TEAM_WORLD), pe_map(NULL) {
+  int result;
+  MPI_Comm_compare(comm, MPI_COMM_WORLD, &result);
+  if (result != MPI_IDENT && result != MPI_CONGRUENT)
+    Kokkos::abort("NVSHMEMSpace: communicators must span all PEs, use "
+                  "NVSHMEMSpace::team_space instead.");
+}
+
+NVSHMEMSpace NVSHMEMSpace::team_space(const scope_type &team) {
+  if (team == NVSHMEM_TEAM_INVALID)
+    Kokkos::abort("NVSHMEMSpace: invalid team.");
+  NVSHMEMSpace space;
+  space.scope = team;
+  space.pe_map = team_pe_map(team);
+  return space;
+}
 
 void NVSHMEMSpace::impl_set_allocation_mode(const int allocation_mode_) {
   allocation_mode = allocation_mode_;
@@ -62,6 +124,11 @@ void NVSHMEMSpace::impl_set_allocation_mode(const int allocation_mode_) {
 
 void NVSHMEMSpace::impl_set_extent(const int64_t extent_) { extent = extent_; }
 
+void NVSHMEMSpace::impl_set_arena(
+    const std::shared_ptr<Impl::RemoteArenaState> &arena_) {
+  arena = arena_;
+}
+
 void *NVSHMEMSpace::allocate(const size_t arg_alloc_size) const {
   static_assert(sizeof(void *) == sizeof(uintptr_t),
                 "Error sizeof(void*) != sizeof(uintptr_t)");
@@ -71,25 +138,70 @@ void *NVSHMEMSpace::allocate(const size_t arg_alloc_size) const {
       "Memory alignment must be power of two");
 
   void *ptr = 0;
-  if (arg_alloc_size) {
-    if (allocation_mode == Kokkos::Experimental::Symmetric) {
+  if (arg_alloc_size && arena) {
+    // Blocks lie at the same offset of the arena on all PEs and are
+    // therefore symmetric
+    if (allocation_mode != Kokkos::Experimental::Symmetric)
+      Kokkos::abort(
+          "NVSHMEMSpace: RemoteArena only supports Symmetric views.");
+    ptr = arena->allocate_ptr(arg_alloc_size, name());
+  } else if (arg_alloc_size) {
+    if (impl_num_pes() != nvshmem_n_pes())
+      Kokkos::abort("NVSHMEMSpace: allocations of a team of a subset of the "
+                    "PEs require a RemoteArena.");
+    // The runtime already maps on-node peers to load/store
+    if (allocation_mode == Kokkos::Experimental::Symmetric ||
+        allocation_mode == Kokkos::Experimental::SymmetricShared) {
       int num_pes = nvshmem_n_pes();
       int my_id = nvshmem_my_pe();
       ptr = nvshmem_malloc(arg_alloc_size);
+    } else if (allocation_mode == Kokkos::Experimental::Asymmetric ||
+               allocation_mode == Kokkos::Experimental::Monolithic) {
+      // The symmetric heap requires the same size on all PEs
+      ptr = nvshmem_malloc(
+          Kokkos::Experimental::Impl::allreduce_max_size(arg_alloc_size));
     } else {
-      Kokkos::abort("NVSHMEMSpace only supports symmetric allocation policy.");
+      Kokkos::abort("NVSHMEMSpace: unknown allocation policy.");
     }
   }
   return ptr;
 }
 
-void NVSHMEMSpace::deallocate(void *const arg_alloc_ptr, const size_t) const {
-  nvshmem_free(arg_alloc_ptr);
+void NVSHMEMSpace::deallocate(void *const arg_alloc_ptr,
+                              const size_t arg_alloc_size) const {
+  if (arena)
+    arena->deallocate_ptr(arg_alloc_ptr, arg_alloc_size);
+  else
+    nvshmem_free(arg_alloc_ptr);
 }
 
 void NVSHMEMSpace::fence() {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("NVSHMEMSpace::fence");
+  Kokkos::fence();
+  nvshmem_quiet();
+  nvshmem_team_sync(scope);
+}
+
+/* Device-initiated operations are blocking, completing the kernels that
+ * issued them completes them locally */
+void NVSHMEMSpace::fence_local() const {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("NVSHMEMSpace::fence_local");
   Kokkos::fence();
-  nvshmem_barrier_all();
+}
+
+void NVSHMEMSpace::fence(const Kokkos::Cuda &exec, const bool barrier) const {
+  cudaStream_t stream = exec.cuda_stream();
+  nvshmemx_quiet_on_stream(stream);
+  if (barrier)
+    nvshmemx_team_sync_on_stream(scope, stream);
+}
+
+void NVSHMEMSpace::fence_all(const bool barrier, const scope_type &team) {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("NVSHMEMSpace::fence(view)");
+  Kokkos::fence();
+  nvshmem_quiet();
+  if (barrier)
+    nvshmem_team_sync(team);
 }
 
 } // namespace Experimental
@@ -153,6 +265,17 @@ SharedAllocationRecord<Kokkos::Experimental::NVSHMEMSpace, void>::
   // Copy to device memory
   Kokkos::Impl::DeepCopy<CudaSpace, HostSpace>(RecordBase::m_alloc_ptr, &header,
                                                sizeof(SharedAllocationHeader));
+  pe_offsets = NULL;
+  pe_offsets_device = NULL;
+  peer_ptrs = Kokkos::Experimental::query_peer_ptrs(m_space, data());
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  // Elements address world PEs
+  std::vector<int> world_pes(nvshmem_n_pes());
+  for (int pe = 0; pe < int(world_pes.size()); pe++)
+    world_pes[pe] = pe;
+  counters = Kokkos::Experimental::Impl::RemoteAccessRegistry::instance()
+                 .create(arg_label, world_pes);
+#endif
 }
 
 SharedAllocationRecord<Kokkos::Experimental::NVSHMEMSpace,
@@ -170,6 +293,15 @@ SharedAllocationRecord<Kokkos::Experimental::NVSHMEMSpace,
   }
 #endif
 
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessRegistry::instance().retire(
+      counters);
+#endif
+  delete[] pe_offsets;
+  if (pe_offsets_device)
+    cudaFree(pe_offsets_device);
+  if (peer_ptrs)
+    cudaFree(peer_ptrs);
   m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
                      SharedAllocationRecord<void, void>::m_alloc_size);
 }
@@ -47,6 +47,7 @@
 
 #include <cstring>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <typeinfo>
 
@@ -88,6 +89,9 @@ public:
 
   typedef Kokkos::Device<execution_space, memory_space> device_type;
 
+  /* PEs addressed by views of an instance */
+  typedef nvshmem_team_t scope_type;
+
   NVSHMEMSpace();
   NVSHMEMSpace(NVSHMEMSpace &&rhs) = default;
   NVSHMEMSpace(const NVSHMEMSpace &rhs) = default;
@@ -95,7 +99,19 @@ public:
   NVSHMEMSpace &operator=(const NVSHMEMSpace &) = default;
   ~NVSHMEMSpace() = default;
 
-  explicit NVSHMEMSpace(const MPI_Comm &);
+  /**\brief NVSHMEM teams cannot be derived from a communicator without
+   *         involving all PEs, comm must therefore span all PEs in
+   *         order. Use team_space for teams of a subset of the PEs. */
+  explicit NVSHMEMSpace(const MPI_Comm &comm);
+
+  /**\brief Views allocated with the returned instance span the PEs of
+   *         team only. Their PE index is the rank in team and fences
+   *         synchronize the team. The symmetric heap is collective over
+   *         all PEs, so views of a team spanning a subset of the PEs are
+   *         allocated from a RemoteArena, see
+   *         RemoteArena::space(const memory_space &). Not a constructor,
+   *         as nvshmem_team_t and MPI_Comm may both be integers. */
+  static NVSHMEMSpace team_space(const scope_type &team);
 
   void *allocate(const size_t arg_alloc_size) const;
 
@@ -109,13 +125,71 @@ public:
   /**\brief Return Name of the MemorySpace */
   static constexpr const char *name() { return m_name; }
 
+  /**\brief Complete all outstanding one-sided operations and synchronize
+   *         the PEs of the team of this instance */
   void fence();
 
+  /**\brief Complete outstanding one-sided operations issued by this PE.
+   *         NVSHMEM has no per-allocation completion, so this completes
+   *         operations on all allocations; with barrier, the PEs of the
+   *         team of v synchronize afterwards */
+  template <class ViewType>
+  void fence(const ViewType &v, const bool barrier = true) const {
+    fence_all(barrier, v.impl_map().handle().scope);
+  }
+
+  /**\brief Local completion of outstanding operations */
+  template <class ViewType> void fence_local(const ViewType &) const {
+    fence_local();
+  }
+  void fence_local() const;
+
+  static void fence_all(const bool barrier,
+                        const scope_type &team = NVSHMEM_TEAM_WORLD);
+
+  /**\brief Stream-ordered fence on the stream of exec. Remote operations
+   *         of work enqueued on exec before complete before work enqueued
+   *         after it starts; with barrier, the PEs of the team of this
+   *         instance also synchronize on their streams. Neither blocks the host nor other streams */
+  void fence(const Kokkos::Cuda &exec, const bool barrier = true) const;
+
+  /**\brief Completes remote operations issued by the calling thread.
+   *         Callable from kernels and from the host */
+  KOKKOS_INLINE_FUNCTION static void quiet() { nvshmem_quiet(); }
+
+  /**\brief Orders remote stores of the calling thread to each PE without
+   *         awaiting their completion. Callable from kernels and from the
+   *         host */
+  KOKKOS_INLINE_FUNCTION static void ordering_fence() { nvshmem_fence(); }
+
+  /**\brief Rank of the calling PE in and size of team */
+  static int impl_my_pe(const scope_type &team) {
+    return nvshmem_team_my_pe(team);
+  }
+  static int impl_num_pes(const scope_type &team) {
+    return nvshmem_team_n_pes(team);
+  }
+  int impl_my_pe() const { return impl_my_pe(scope); }
+  int impl_num_pes() const { return impl_num_pes(scope); }
+
   int allocation_mode;
   int64_t extent;
 
+  /* Team of the allocations, NVSHMEM_TEAM_WORLD by default */
+  scope_type scope;
+
+  /* World PE of each rank of scope in managed memory, NULL for
+   * NVSHMEM_TEAM_WORLD. Shared by all instances of a team and never
+   * freed. */
+  const int *pe_map;
+
+  /* Set on instances returned by RemoteArena::space(). Allocations are
+   * then carved from the arena instead of the symmetric heap. */
+  std::shared_ptr<Impl::RemoteArenaState> arena;
+
   void impl_set_allocation_mode(const int);
   void impl_set_extent(int64_t N);
+  void impl_set_arena(const std::shared_ptr<Impl::RemoteArenaState> &);
 
 private:
   static constexpr const char *m_name = "NVSHMEM";
@@ -188,6 +262,24 @@ protected:
       const RecordBase::function_type arg_dealloc = &deallocate);
 
 public:
+  /* Row offsets of Asymmetric and Monolithic allocations in host and
+   * device memory, see Kokkos::Experimental::Impl::PEPartition. Owned by
+   * the record. */
+  size_t *pe_offsets;
+  size_t *pe_offsets_device;
+
+  /* Address of data() on each rank of the scope that the calling PE can
+   * reach by load/store, usually NVLink or PCIe peers on the same node,
+   * in managed memory. Entries of the calling PE and of unreachable
+   * ranks are NULL, the table itself is NULL without any such peer.
+   * Owned by the record. */
+  void **peer_ptrs;
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  /* Access counters of the allocation. Owned by the record. */
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters;
+#endif
+
   inline std::string get_label() const {
     SharedAllocationHeader header;
     Kokkos::Impl::DeepCopy<Kokkos::HostSpace, Kokkos::CudaSpace>(
@@ -263,7 +355,9 @@ struct DeepCopy<Kokkos::Experimental::NVSHMEMSpace,
 
 } // namespace Kokkos
 
+#include <Kokkos_RemoteSpaces_Partition.hpp>
 #include <Kokkos_NVSHMEMSpace_ViewMapping.hpp>
+#include <Kokkos_RemoteSpaces_Subview.hpp>
 #include <Kokkos_RemoteSpaces_DeepCopy.hpp>
 
 #endif // #define KOKKOS_NVSHMEMSPACE_HPP
@@ -45,6 +45,10 @@
 #ifndef NVSHMEM_VIEW_MAPPING_HPP_
 #define NVSHMEM_VIEW_MAPPING_HPP_
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <nvshmem.h>
 #include <type_traits>
 //----------------------------------------------------------------------------
@@ -53,6 +57,77 @@
 namespace Kokkos {
 namespace Impl {
 
+/* Pinned host buffer through which host buffers of blocking transfers
+ * are staged. Host-initiated NVSHMEM transfers over remote transports
+ * require local buffers registered with NVSHMEM, which arbitrary host
+ * memory is not. The buffer is allocated and registered once, reused by
+ * all transfers and host element accesses under its mutex and released
+ * at Kokkos::finalize. */
+struct NVSHMEMHostStaging {
+  enum : size_t { size = size_t(1) << 24 };
+
+  std::mutex mutex;
+  void *buf = NULL;
+
+  static NVSHMEMHostStaging &instance() {
+    static NVSHMEMHostStaging staging;
+    return staging;
+  }
+
+  /* Requires mutex to be held */
+  void *get() {
+    if (!buf) {
+      cudaMallocHost(&buf, size);
+      nvshmemx_buffer_register(buf, size);
+      Kokkos::push_finalize_hook([]() { instance().release(); });
+    }
+    return buf;
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (buf) {
+      nvshmemx_buffer_unregister(buf);
+      cudaFreeHost(buf);
+    }
+    buf = NULL;
+  }
+};
+
+/* Element accesses from the host. Values are staged through the pinned
+ * buffer of NVSHMEMHostStaging, which is registered with NVSHMEM and
+ * therefore valid for remote transports, without a copy to or from the
+ * device. Puts complete remotely at the next fence, as in kernels. */
+template <class T>
+inline void nvshmem_host_p(T *ptr, const T &val, const int pe) {
+  NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+  std::lock_guard<std::mutex> lock(staging.mutex);
+  void *buf = staging.get();
+  memcpy(buf, &val, sizeof(T));
+  nvshmem_putmem(ptr, buf, sizeof(T), pe);
+}
+
+template <class T> inline T nvshmem_host_g(const T *ptr, const int pe) {
+  NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+  std::lock_guard<std::mutex> lock(staging.mutex);
+  void *buf = staging.get();
+  T val;
+  nvshmem_getmem(buf, ptr, sizeof(T), pe);
+  memcpy(&val, buf, sizeof(T));
+  return val;
+}
+
+/* Direct element addresses are device addresses and are only used in
+ * device code */
+template <class T> KOKKOS_INLINE_FUNCTION T *nvshmem_direct_ptr(T *lptr) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+  return lptr;
+#else
+  (void)lptr;
+  return NULL;
+#endif
+}
+
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
 #define KOKKOS_SHMEM_P(type, fxn)                                              \
   static KOKKOS_INLINE_FUNCTION void shmem_type_p(type *ptr, const type &val,  \
@@ -62,7 +137,7 @@ namespace Impl {
 #else
 #define KOKKOS_SHMEM_P(type, fxn)                                              \
   static inline void shmem_type_p(type *ptr, const type &val, int pe) {        \
-    *ptr = val;                                                                \
+    nvshmem_host_p(ptr, val, pe);                                              \
   }
 #endif
 
@@ -88,7 +163,9 @@ KOKKOS_SHMEM_P(double, nvshmem_double_p)
   }
 #else
 #define KOKKOS_SHMEM_G(type, fxn)                                              \
-  static inline type shmem_type_g(type *ptr, int pe) { return *ptr; }
+  static inline type shmem_type_g(type *ptr, int pe) {                         \
+    return nvshmem_host_g(ptr, pe);                                            \
+  }
 #endif
 
 KOKKOS_SHMEM_G(char, nvshmem_char_g)
@@ -106,283 +183,1144 @@ KOKKOS_SHMEM_G(double, nvshmem_double_g)
 
 #undef KOKKOS_SHMEM_G
 
-template <class T> struct NVSHMEMDataElement {
+/* Remote atomics. Typed NVSHMEM atomics exist for the integer types,
+ * swap additionally for float and double. They are only callable on the
+ * device, so atomics issued from the host run in a single-thread kernel
+ * that returns the fetched value through the pinned buffer of
+ * NVSHMEMHostStaging. The kernels are defined in both compilation
+ * passes, their NVSHMEM call only in the device pass. */
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+#define KOKKOS_NVSHMEM_DEVICE_ONLY(...) __VA_ARGS__
+#else
+#define KOKKOS_NVSHMEM_DEVICE_ONLY(...)
+#endif
+
+template <class T, class F> inline T nvshmem_host_atomic(const F &f) {
+  NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+  std::lock_guard<std::mutex> lock(staging.mutex);
+  T *result = static_cast<T *>(staging.get());
+  Kokkos::parallel_for(
+      "NVSHMEM::host_atomic", Kokkos::RangePolicy<Kokkos::Cuda>(0, 1),
+      KOKKOS_LAMBDA(const int) { f(result); });
+  Kokkos::fence();
+  return *result;
+}
+
+#define KOKKOS_SHMEM_HOST_ATOMIC(op, type, ctype, fxn)                         \
+  static inline type shmem_host_atomic_##op(type *ptr, const type &val,        \
+                                            int pe) {                          \
+    return nvshmem_host_atomic<type>(KOKKOS_LAMBDA(type * result) {            \
+      KOKKOS_NVSHMEM_DEVICE_ONLY(                                              \
+          *result = (type)fxn((ctype *)ptr, (ctype)val, pe);)                  \
+    });                                                                        \
+  }
+#define KOKKOS_SHMEM_HOST_ATOMIC_CSWAP(type, fxn)                              \
+  static inline type shmem_host_atomic_compare_swap(                           \
+      type *ptr, const type &cond, const type &val, int pe) {                  \
+    return nvshmem_host_atomic<type>(KOKKOS_LAMBDA(type * result) {            \
+      KOKKOS_NVSHMEM_DEVICE_ONLY(*result = fxn(ptr, cond, val, pe);)           \
+    });                                                                        \
+  }
+
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+#define KOKKOS_SHMEM_ATOMIC(op, type, ctype, fxn)                              \
+  KOKKOS_SHMEM_HOST_ATOMIC(op, type, ctype, fxn)                               \
+  static KOKKOS_INLINE_FUNCTION type shmem_type_atomic_##op(                   \
+      type *ptr, const type &val, int pe) {                                    \
+    return (type)fxn((ctype *)ptr, (ctype)val, pe);                            \
+  }
+#define KOKKOS_SHMEM_ATOMIC_CSWAP(type, fxn)                                   \
+  KOKKOS_SHMEM_HOST_ATOMIC_CSWAP(type, fxn)                                    \
+  static KOKKOS_INLINE_FUNCTION type shmem_type_atomic_compare_swap(           \
+      type *ptr, const type &cond, const type &val, int pe) {                  \
+    return fxn(ptr, cond, val, pe);                                            \
+  }
+#else
+#define KOKKOS_SHMEM_ATOMIC(op, type, ctype, fxn)                              \
+  KOKKOS_SHMEM_HOST_ATOMIC(op, type, ctype, fxn)                               \
+  static inline type shmem_type_atomic_##op(type *ptr, const type &val,        \
+                                            int pe) {                          \
+    return shmem_host_atomic_##op(ptr, val, pe);                               \
+  }
+#define KOKKOS_SHMEM_ATOMIC_CSWAP(type, fxn)                                   \
+  KOKKOS_SHMEM_HOST_ATOMIC_CSWAP(type, fxn)                                    \
+  static inline type shmem_type_atomic_compare_swap(                           \
+      type *ptr, const type &cond, const type &val, int pe) {                  \
+    return shmem_host_atomic_compare_swap(ptr, cond, val, pe);                 \
+  }
+#endif
+
+KOKKOS_SHMEM_ATOMIC(fetch_add, int, int, nvshmem_int_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, unsigned int, unsigned int,
+                    nvshmem_uint_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, long, long, nvshmem_long_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, unsigned long, unsigned long,
+                    nvshmem_ulong_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, long long, long long,
+                    nvshmem_longlong_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, unsigned long long,
+                    unsigned long long, nvshmem_ulonglong_atomic_fetch_add)
+
+KOKKOS_SHMEM_ATOMIC(fetch_and, int, int32_t, nvshmem_int32_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, unsigned int, unsigned int,
+                    nvshmem_uint_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, long, int64_t, nvshmem_int64_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, unsigned long, unsigned long,
+                    nvshmem_ulong_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, long long, int64_t,
+                    nvshmem_int64_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, unsigned long long,
+                    unsigned long long, nvshmem_ulonglong_atomic_fetch_and)
+
+KOKKOS_SHMEM_ATOMIC(fetch_or, int, int32_t, nvshmem_int32_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, unsigned int, unsigned int,
+                    nvshmem_uint_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, long, int64_t, nvshmem_int64_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, unsigned long, unsigned long,
+                    nvshmem_ulong_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, long long, int64_t, nvshmem_int64_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, unsigned long long,
+                    unsigned long long, nvshmem_ulonglong_atomic_fetch_or)
+
+KOKKOS_SHMEM_ATOMIC(fetch_xor, int, int32_t, nvshmem_int32_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, unsigned int, unsigned int,
+                    nvshmem_uint_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, long, int64_t, nvshmem_int64_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, unsigned long, unsigned long,
+                    nvshmem_ulong_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, long long, int64_t,
+                    nvshmem_int64_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, unsigned long long,
+                    unsigned long long, nvshmem_ulonglong_atomic_fetch_xor)
+
+KOKKOS_SHMEM_ATOMIC(swap, int, int, nvshmem_int_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, unsigned int, unsigned int, nvshmem_uint_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, long, long, nvshmem_long_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, unsigned long, unsigned long,
+                    nvshmem_ulong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, long long, long long, nvshmem_longlong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, unsigned long long,
+                    unsigned long long, nvshmem_ulonglong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, float, float, nvshmem_float_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, double, double, nvshmem_double_atomic_swap)
+
+KOKKOS_SHMEM_ATOMIC_CSWAP(int, nvshmem_int_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned int, nvshmem_uint_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(long, nvshmem_long_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned long, nvshmem_ulong_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(long long, nvshmem_longlong_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned long long,
+                          nvshmem_ulonglong_atomic_compare_swap)
+
+#undef KOKKOS_SHMEM_ATOMIC
+#undef KOKKOS_SHMEM_ATOMIC_CSWAP
+#undef KOKKOS_SHMEM_HOST_ATOMIC
+#undef KOKKOS_SHMEM_HOST_ATOMIC_CSWAP
+#undef KOKKOS_NVSHMEM_DEVICE_ONLY
+
+template <class T, class Traits>
+struct NVSHMEMDataElement {
   typedef const T const_value_type;
   typedef T non_const_value_type;
   T *ptr;
+  // Address of the element if it can be reached by load/store, NULL
+  // otherwise
+  T *lptr;
   int pe;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  KOKKOS_INLINE_FUNCTION
+  NVSHMEMDataElement(T *ptr_, int pe_, int i_, T *lptr_)
+      : ptr(ptr_ + i_), lptr(nvshmem_direct_ptr(lptr_)), pe(pe_),
+        is_local(lptr_ != NULL) {}
 
+  // Elements in the local segment or of peers are accessed directly
   KOKKOS_INLINE_FUNCTION
-  NVSHMEMDataElement(T *ptr_, int pe_, int i_) : ptr(ptr_ + i_), pe(pe_) {}
+  T get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    return lptr ? *lptr : shmem_type_g(ptr, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (lptr)
+      *lptr = val;
+    else
+      shmem_type_p(ptr, val, pe);
+  }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator=(const_value_type &val) const {
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   void inc() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
   }
 
   KOKKOS_INLINE_FUNCTION
   void dec() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator++() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator--() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator++(int) const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator--(int) const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator+=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp += val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator-=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp -= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator*=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp *= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator/=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp /= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator%=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp %= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp &= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator^=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp ^= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator|=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp |= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator<<=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp <<= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator>>=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp >>= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator+(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp + val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator-(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp - val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator*(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp * val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator/(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp / val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator%(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp % val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator!() const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return !tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&&(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp && val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator||(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp || val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator&(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp & val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator|(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp | val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator^(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp ^ val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator~() const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return ~tmp;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator<<(const unsigned int &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp << val;
   }
 
   KOKKOS_INLINE_FUNCTION
   const_value_type operator>>(const unsigned int &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp >> val;
   }
 
+  /* Remote atomics. Each returns the value found at the target before
+   * the update. They are issued through NVSHMEM even for the local
+   * segment so that they stay atomic with respect to other PEs. */
+  KOKKOS_INLINE_FUNCTION
+  T fetch_add(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_add(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_and(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_and(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_or(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_or(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T fetch_xor(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_xor(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T exchange(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_swap(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  T compare_exchange(const_value_type &expected,
+                     const_value_type &desired) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_compare_swap(ptr, expected, desired, pe);
+  }
+
   KOKKOS_INLINE_FUNCTION
   bool operator==(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp == val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator!=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp != val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator>=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp >= val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator<=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp <= val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator<(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp < val;
   }
 
   KOKKOS_INLINE_FUNCTION
   bool operator>(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp > val;
   }
 
   KOKKOS_INLINE_FUNCTION
-  operator const_value_type() const { return shmem_type_g(ptr, pe); }
+  operator const_value_type() const { return get(); }
+};
+
+/* Non-coherent load of a local element that is not written while it is
+ * read, served by the read-only data cache of the device */
+template <int N> struct nvshmem_ldg_bits;
+template <> struct nvshmem_ldg_bits<1> { typedef unsigned char type; };
+template <> struct nvshmem_ldg_bits<2> { typedef unsigned short type; };
+template <> struct nvshmem_ldg_bits<4> { typedef unsigned int type; };
+template <> struct nvshmem_ldg_bits<8> { typedef unsigned long long type; };
+
+template <class T>
+KOKKOS_INLINE_FUNCTION
+typename std::enable_if<(sizeof(T) == 1 || sizeof(T) == 2 ||
+                         sizeof(T) == 4 || sizeof(T) == 8),
+                        T>::type
+nvshmem_ldg(const T *ptr) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+  typedef typename nvshmem_ldg_bits<sizeof(T)>::type bits_type;
+  const bits_type bits = __ldg(reinterpret_cast<const bits_type *>(ptr));
+  T val;
+  memcpy(&val, &bits, sizeof(T));
+  return val;
+#else
+  return *ptr;
+#endif
+}
+
+template <class T>
+KOKKOS_INLINE_FUNCTION
+typename std::enable_if<!(sizeof(T) == 1 || sizeof(T) == 2 ||
+                          sizeof(T) == 4 || sizeof(T) == 8),
+                        T>::type
+nvshmem_ldg(const T *ptr) {
+  return *ptr;
+}
+
+/* Reference to an element of a ReadOnly view or a view of const value
+ * type. It only converts to the value of the element. */
+template <class T, class Traits>
+struct NVSHMEMReadElement {
+  typedef typename std::remove_const<T>::type non_const_value_type;
+  typedef const non_const_value_type const_value_type;
+  non_const_value_type *ptr;
+  const non_const_value_type *lptr;
+  int pe;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  KOKKOS_INLINE_FUNCTION
+  NVSHMEMReadElement(T *ptr_, int pe_, int i_, T *lptr_)
+      : ptr(const_cast<non_const_value_type *>(ptr_) + i_),
+        lptr(nvshmem_direct_ptr(lptr_)), pe(pe_), is_local(lptr_ != NULL) {}
+
+  KOKKOS_INLINE_FUNCTION
+  non_const_value_type get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    return lptr ? nvshmem_ldg(lptr) : shmem_type_g(ptr, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  operator const_value_type() const { return get(); }
+};
+
+/* Reference to an element of a WriteOnly view. It only supports
+ * assignment, stores complete remotely at the next fence. */
+template <class T, class Traits>
+struct NVSHMEMWriteElement {
+  typedef const T const_value_type;
+  typedef T non_const_value_type;
+  T *ptr;
+  T *lptr;
+  int pe;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  KOKKOS_INLINE_FUNCTION
+  NVSHMEMWriteElement(T *ptr_, int pe_, int i_, T *lptr_)
+      : ptr(ptr_ + i_), lptr(nvshmem_direct_ptr(lptr_)), pe(pe_),
+        is_local(lptr_ != NULL) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (lptr)
+      *lptr = val;
+    else
+      shmem_type_p(ptr, val, pe);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator=(const_value_type &val) const {
+    put(val);
+    return val;
+  }
 };
 
-template <class T> struct NVSHMEMDataHandle {
+template <class T, class Traits>
+using NVSHMEMElement = typename Kokkos::Experimental::Impl::remote_element<
+    T, Traits, NVSHMEMDataElement, NVSHMEMReadElement, NVSHMEMWriteElement>::type;
+
+/* NVSHMEM constants of signal updates and wait conditions */
+KOKKOS_INLINE_FUNCTION int nvshmem_signal_op_of(const int op) {
+  return op == Kokkos::Experimental::SignalAdd ? NVSHMEM_SIGNAL_ADD
+                                               : NVSHMEM_SIGNAL_SET;
+}
+
+KOKKOS_INLINE_FUNCTION int nvshmem_cmp_of(const int cmp) {
+  switch (cmp) {
+  case Kokkos::Experimental::CmpEQ: return NVSHMEM_CMP_EQ;
+  case Kokkos::Experimental::CmpNE: return NVSHMEM_CMP_NE;
+  case Kokkos::Experimental::CmpGT: return NVSHMEM_CMP_GT;
+  case Kokkos::Experimental::CmpGE: return NVSHMEM_CMP_GE;
+  case Kokkos::Experimental::CmpLT: return NVSHMEM_CMP_LT;
+  default: return NVSHMEM_CMP_LE;
+  }
+}
+
+/* Completion handle of a non-blocking bulk transfer, enqueued together
+ * with its completion on a CUDA stream */
+struct NVSHMEMRemoteRequest {
+  cudaStream_t stream;
+  bool pending;
+  // Device buffer staging a host buffer, released on completion
+  std::shared_ptr<void> staging;
+
+  NVSHMEMRemoteRequest() : stream(0), pending(false) {}
+
+  void wait() {
+    if (pending) {
+      cudaStreamSynchronize(stream);
+      pending = false;
+      staging.reset();
+    }
+  }
+
+  bool test() {
+    if (pending && cudaStreamQuery(stream) == cudaSuccess) {
+      pending = false;
+      staging.reset();
+    }
+    return !pending;
+  }
+};
+
+/* Device staging buffer of a request. cudaFree synchronizes the device,
+ * so the buffer outlives transfers of requests dropped before waiting. */
+inline std::shared_ptr<void> nvshmem_staging_buffer(const size_t nbytes) {
+  void *buf = NULL;
+  cudaMalloc(&buf, nbytes);
+  return std::shared_ptr<void>(buf, [](void *p) { cudaFree(p); });
+}
+
+/* Stream on which transfers ordered after work of exec are enqueued */
+inline cudaStream_t nvshmem_stream(const Kokkos::Cuda &exec) {
+  return exec.cuda_stream();
+}
+
+template <class ExecSpace>
+inline cudaStream_t nvshmem_stream(const ExecSpace &) {
+  return 0;
+}
+
+/* NVSHMEM transfers on streams require local buffers in device memory */
+inline bool nvshmem_is_device_ptr(const void *ptr) {
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    cudaGetLastError();
+    return false;
+  }
+  return attr.type == cudaMemoryTypeDevice ||
+         attr.type == cudaMemoryTypeManaged;
+}
+
+template <class T, class Traits> struct NVSHMEMDataHandle {
+  enum : bool {
+    is_remote_only = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_remote_only
+  };
   T *ptr;
+  // Rank of the calling PE in scope
+  int my_pe;
+  // World PE of each rank in scope in managed memory, NULL for
+  // NVSHMEM_TEAM_WORLD
+  const int *pe_map;
+  // Team of the allocation, PE indices are ranks in it
+  nvshmem_team_t scope;
+  // Allocation addresses of load/store reachable peers by rank in scope,
+  // NULL without such peers, see the peer_ptrs member of the record
+  void *const *peer_ptrs = NULL;
+  // Element offset of ptr within the allocation, non-zero for subviews
+  size_t offset = 0;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  // Access counters of the allocation, NULL if untracked
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
   KOKKOS_INLINE_FUNCTION
-  NVSHMEMDataHandle() : ptr(NULL) {}
+  NVSHMEMDataHandle()
+      : ptr(NULL), my_pe(-1), pe_map(NULL), scope(NVSHMEM_TEAM_WORLD) {}
+  KOKKOS_INLINE_FUNCTION
+  NVSHMEMDataHandle(T *ptr_, int my_pe_ = -1, const int *pe_map_ = NULL,
+                    nvshmem_team_t scope_ = NVSHMEM_TEAM_WORLD)
+      : ptr(ptr_), my_pe(my_pe_), pe_map(pe_map_), scope(scope_) {}
+  // Also converts handles of T to handles of const T
+  template <class SrcT, class SrcTraits>
+  KOKKOS_INLINE_FUNCTION
+  NVSHMEMDataHandle(const NVSHMEMDataHandle<SrcT, SrcTraits> &rhs)
+      : ptr(rhs.ptr), my_pe(rhs.my_pe), pe_map(rhs.pe_map),
+        scope(rhs.scope), peer_ptrs(rhs.peer_ptrs), offset(rhs.offset) {
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    counters = rhs.counters;
+#endif
+  }
+
+  /* Rank of the calling PE in scope */
+  KOKKOS_INLINE_FUNCTION int impl_my_pe() const { return my_pe; }
+
+  /* PE argument of the NVSHMEM routines for rank pe of scope */
+  KOKKOS_INLINE_FUNCTION int world_pe(const int pe) const {
+    return pe_map ? pe_map[pe] : pe;
+  }
+
+  /* Address of element i of the segment of pe if it can be reached by
+   * load/store from this PE, NULL otherwise. Peers mapped by the runtime,
+   * e.g. over NVLink, are accessed with plain loads and stores instead of
+   * NVSHMEM calls. */
   KOKKOS_INLINE_FUNCTION
-  NVSHMEMDataHandle(T *ptr_) : ptr(ptr_) {}
+  T *local_ptr(const int pe, const size_t i) const {
+    if (is_remote_only)
+      return NULL;
+    if (pe == my_pe)
+      return ptr + i;
+    if (peer_ptrs && peer_ptrs[pe])
+      return static_cast<T *>(peer_ptrs[pe]) + offset + i;
+    return NULL;
+  }
+
   template <typename iType>
-  KOKKOS_INLINE_FUNCTION NVSHMEMDataElement<T>
+  KOKKOS_INLINE_FUNCTION NVSHMEMElement<T, Traits>
   operator()(const int &pe, const iType &i) const {
-    NVSHMEMDataElement<T> element(ptr, pe, i);
+    NVSHMEMElement<T, Traits> element(ptr, world_pe(pe), i,
+                                      local_ptr(pe, i));
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    element.counters = counters;
+#endif
     return element;
   }
+
+  /* Bulk transfers of n contiguous elements starting at element first
+   * of the segment owned by pe. Both complete before returning. Device
+   * buffers are transferred directly, host buffers are staged in chunks
+   * through NVSHMEMHostStaging. */
+  void get(T *dst, const int pe, const size_t first, const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, nbytes);
+    if (nvshmem_is_device_ptr(dst)) {
+      nvshmem_getmem(dst, ptr + first, nbytes, world_pe(pe));
+      return;
+    }
+    NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+    std::lock_guard<std::mutex> lock(staging.mutex);
+    void *buf = staging.get();
+    const char *remote = reinterpret_cast<const char *>(ptr + first);
+    for (size_t pos = 0; pos < nbytes; pos += NVSHMEMHostStaging::size) {
+      const size_t count =
+          std::min<size_t>(nbytes - pos, NVSHMEMHostStaging::size);
+      nvshmem_getmem(buf, remote + pos, count, world_pe(pe));
+      memcpy(reinterpret_cast<char *>(dst) + pos, buf, count);
+    }
+  }
+
+  void put(const T *src, const int pe, const size_t first,
+           const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, nbytes);
+    if (nvshmem_is_device_ptr(src)) {
+      nvshmem_putmem(ptr + first, src, nbytes, world_pe(pe));
+      nvshmem_quiet();
+      return;
+    }
+    NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+    std::lock_guard<std::mutex> lock(staging.mutex);
+    void *buf = staging.get();
+    char *remote = reinterpret_cast<char *>(ptr + first);
+    // A blocking put returns once its local buffer may be reused
+    for (size_t pos = 0; pos < nbytes; pos += NVSHMEMHostStaging::size) {
+      const size_t count =
+          std::min<size_t>(nbytes - pos, NVSHMEMHostStaging::size);
+      memcpy(buf, reinterpret_cast<const char *>(src) + pos, count);
+      nvshmem_putmem(remote + pos, buf, count, world_pe(pe));
+    }
+    nvshmem_quiet();
+  }
+
+  /* Transfers between a strided local buffer and the strided region of
+   * the segment owned by pe that starts at element first. If the remote
+   * region has no gaps, the elements are packed into remote order on the
+   * device and moved as one transfer; otherwise a kernel moves them one
+   * by one. Host buffers are staged through device memory. Both complete
+   * before returning. */
+  void get_strided(
+      T *dst, const Kokkos::Experimental::Impl::StridedLayout &dst_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &src_layout) const {
+    typedef Kokkos::RangePolicy<Kokkos::Cuda> policy_type;
+    const size_t n = src_layout.size();
+    if (n == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    const Kokkos::Experimental::Impl::StridedLayout dl = dst_layout;
+    const Kokkos::Experimental::Impl::StridedLayout sl = src_layout;
+    const int target = world_pe(pe);
+    // Gaps of a staged host buffer must survive the copy back
+    const size_t dst_span = dl.span();
+    T *d_dst = dst;
+    if (!nvshmem_is_device_ptr(dst)) {
+      cudaMalloc(&d_dst, dst_span * sizeof(T));
+      cudaMemcpy(d_dst, dst, dst_span * sizeof(T), cudaMemcpyDefault);
+    }
+    const T *remote = ptr + first;
+    if (sl.is_contiguous()) {
+      T *packed;
+      cudaMalloc(&packed, n * sizeof(T));
+      nvshmem_getmem(packed, remote, n * sizeof(T), target);
+      Kokkos::parallel_for(
+          "NVSHMEM::unpack", policy_type(0, n), KOKKOS_LAMBDA(const size_t k) {
+            d_dst[dl.offset(k)] = packed[sl.offset(k)];
+          });
+      Kokkos::fence();
+      cudaFree(packed);
+    } else {
+      Kokkos::parallel_for(
+          "NVSHMEM::get_strided", policy_type(0, n),
+          KOKKOS_LAMBDA(const size_t k) {
+            nvshmem_getmem(d_dst + dl.offset(k), remote + sl.offset(k),
+                           sizeof(T), target);
+          });
+      Kokkos::fence();
+    }
+    if (d_dst != dst) {
+      cudaMemcpy(dst, d_dst, dst_span * sizeof(T), cudaMemcpyDefault);
+      cudaFree(d_dst);
+    }
+  }
+
+  void put_strided(
+      const T *src, const Kokkos::Experimental::Impl::StridedLayout &src_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &dst_layout) const {
+    typedef Kokkos::RangePolicy<Kokkos::Cuda> policy_type;
+    const size_t n = src_layout.size();
+    if (n == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    const Kokkos::Experimental::Impl::StridedLayout dl = dst_layout;
+    const Kokkos::Experimental::Impl::StridedLayout sl = src_layout;
+    const int target = world_pe(pe);
+    const T *d_src = src;
+    T *staged = NULL;
+    if (!nvshmem_is_device_ptr(src)) {
+      const size_t src_span = sl.span();
+      cudaMalloc(&staged, src_span * sizeof(T));
+      cudaMemcpy(staged, src, src_span * sizeof(T), cudaMemcpyDefault);
+      d_src = staged;
+    }
+    T *remote = ptr + first;
+    if (dl.is_contiguous()) {
+      T *packed;
+      cudaMalloc(&packed, n * sizeof(T));
+      Kokkos::parallel_for(
+          "NVSHMEM::pack", policy_type(0, n), KOKKOS_LAMBDA(const size_t k) {
+            packed[dl.offset(k)] = d_src[sl.offset(k)];
+          });
+      Kokkos::fence();
+      nvshmem_putmem(remote, packed, n * sizeof(T), target);
+      cudaFree(packed);
+    } else {
+      Kokkos::parallel_for(
+          "NVSHMEM::put_strided", policy_type(0, n),
+          KOKKOS_LAMBDA(const size_t k) {
+            nvshmem_putmem(remote + dl.offset(k), d_src + sl.offset(k),
+                           sizeof(T), target);
+          });
+      Kokkos::fence();
+    }
+    nvshmem_quiet();
+    if (staged)
+      cudaFree(staged);
+  }
+
+  typedef NVSHMEMRemoteRequest request_type;
+
+  /* Non-blocking counterparts of get/put, enqueued on the stream of exec.
+   * Host buffers, e.g. of HostSpace or CudaHostPinnedSpace views, are
+   * staged through a device buffer. The copy between the two is enqueued
+   * on the same stream, so the host thread does not wait for either. */
+  template <class ExecSpace>
+  request_type get_async(const ExecSpace &exec, T *dst, const int pe,
+                         const size_t first, const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    request_type req;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, nbytes);
+    req.stream = nvshmem_stream(exec);
+    void *d_dst = dst;
+    if (!nvshmem_is_device_ptr(dst)) {
+      req.staging = nvshmem_staging_buffer(nbytes);
+      d_dst = req.staging.get();
+    }
+    nvshmemx_getmem_nbi_on_stream(d_dst, ptr + first, nbytes, world_pe(pe),
+                                  req.stream);
+    nvshmemx_quiet_on_stream(req.stream);
+    if (d_dst != dst)
+      cudaMemcpyAsync(dst, d_dst, nbytes, cudaMemcpyDeviceToHost,
+                      req.stream);
+    req.pending = true;
+    return req;
+  }
+
+  template <class ExecSpace>
+  request_type put_async(const ExecSpace &exec, const T *src, const int pe,
+                         const size_t first, const size_t n) const {
+    const size_t nbytes = n * sizeof(T);
+    request_type req;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, nbytes);
+    req.stream = nvshmem_stream(exec);
+    const void *d_src = src;
+    if (!nvshmem_is_device_ptr(src)) {
+      req.staging = nvshmem_staging_buffer(nbytes);
+      cudaMemcpyAsync(req.staging.get(), src, nbytes, cudaMemcpyHostToDevice,
+                      req.stream);
+      d_src = req.staging.get();
+    }
+    nvshmemx_putmem_nbi_on_stream(ptr + first, d_src, nbytes, world_pe(pe),
+                                  req.stream);
+    nvshmemx_quiet_on_stream(req.stream);
+    req.pending = true;
+    return req;
+  }
+
+  /* Puts n elements like put, then updates element sig_index of the
+   * segment of pe in the signal allocation of sig with value. The data
+   * is complete at pe before the signal changes. Host buffers are staged
+   * through the pinned buffer of NVSHMEMHostStaging, the signal travels
+   * with the last chunk. */
+  template <class SigHandle>
+  void put_signal(const T *src, const int pe, const size_t first,
+                  const size_t n, const SigHandle &sig,
+                  const size_t sig_index, const uint64_t value,
+                  const int sig_op) const {
+    const size_t nbytes = n * sizeof(T);
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, nbytes);
+    const int target = world_pe(pe);
+    const int op = nvshmem_signal_op_of(sig_op);
+    const cudaStream_t stream = nvshmem_stream(Kokkos::Cuda());
+    if (nvshmem_is_device_ptr(src)) {
+      nvshmemx_putmem_signal_on_stream(ptr + first, src, nbytes,
+                                       sig.ptr + sig_index, value, op,
+                                       target, stream);
+      nvshmemx_quiet_on_stream(stream);
+      cudaStreamSynchronize(stream);
+      return;
+    }
+    NVSHMEMHostStaging &staging = NVSHMEMHostStaging::instance();
+    std::lock_guard<std::mutex> lock(staging.mutex);
+    void *buf = staging.get();
+    char *remote = reinterpret_cast<char *>(ptr + first);
+    const char *local = reinterpret_cast<const char *>(src);
+    size_t pos = 0;
+    for (; nbytes - pos > NVSHMEMHostStaging::size;
+         pos += NVSHMEMHostStaging::size) {
+      memcpy(buf, local + pos, NVSHMEMHostStaging::size);
+      nvshmem_putmem(remote + pos, buf, NVSHMEMHostStaging::size, target);
+    }
+    // Leading chunks complete before the signal may change
+    if (pos)
+      nvshmem_quiet();
+    memcpy(buf, local + pos, nbytes - pos);
+    nvshmemx_putmem_signal_on_stream(remote + pos, buf, nbytes - pos,
+                                     sig.ptr + sig_index, value, op, target,
+                                     stream);
+    nvshmemx_quiet_on_stream(stream);
+    // The staging buffer is reused once the lock is released
+    cudaStreamSynchronize(stream);
+  }
+
+  /* Atomically sets or adds value to element i of the segment of pe of
+   * a signal allocation, ordered after prior puts of the calling PE.
+   * Issued by a single-thread kernel. */
+  void signal(const int pe, const size_t i, const uint64_t value,
+              const int sig_op) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, world_pe(pe),
+                               pe == my_pe, sizeof(T));
+    uint64_t *sig_addr = ptr + i;
+    const int op = nvshmem_signal_op_of(sig_op);
+    const int target = world_pe(pe);
+    Kokkos::parallel_for(
+        "NVSHMEM::signal", Kokkos::RangePolicy<Kokkos::Cuda>(0, 1),
+        KOKKOS_LAMBDA(const int) {
+          nvshmem_fence();
+          nvshmemx_signal_op(sig_addr, value, op, target);
+        });
+    Kokkos::fence();
+  }
+
+  /* Blocks until element i of the local segment of a signal allocation
+   * satisfies cmp against cmp_value and returns it. Waits in a
+   * single-thread kernel. */
+  uint64_t wait_until(const size_t i, const int cmp,
+                      const uint64_t cmp_value) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    Kokkos::View<uint64_t, Kokkos::CudaSpace> result("NVSHMEM::signal");
+    uint64_t *sig_addr = ptr + i;
+    const int c = nvshmem_cmp_of(cmp);
+    Kokkos::parallel_for(
+        "NVSHMEM::wait_until", Kokkos::RangePolicy<Kokkos::Cuda>(0, 1),
+        KOKKOS_LAMBDA(const int) {
+          result() = nvshmem_signal_wait_until(sig_addr, c, cmp_value);
+        });
+    uint64_t value;
+    Kokkos::deep_copy(value, result);
+    return value;
+  }
+
+  /* Device-side counterparts of get/put for team- and thread-level
+   * local_deep_copy. A team maps to a CUDA block, so team transfers are
+   * issued cooperatively by the whole block. */
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_get(const TeamType &team, T *dst,
+                                       const int pe, const size_t first,
+                                       const size_t n) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    if (team.team_rank() == 0)
+      KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                                 pe == my_pe, n * sizeof(T));
+    nvshmemx_getmem_block(dst, ptr + first, n * sizeof(T), world_pe(pe));
+    team.team_barrier();
+#else
+    Kokkos::abort("NVSHMEMSpace team transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_put(const TeamType &team, const T *src,
+                                       const int pe, const size_t first,
+                                       const size_t n) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    if (team.team_rank() == 0)
+      KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                                 pe == my_pe, n * sizeof(T));
+    team.team_barrier();
+    nvshmemx_putmem_block(ptr + first, src, n * sizeof(T), world_pe(pe));
+#else
+    Kokkos::abort("NVSHMEMSpace team transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  /* Elements are distributed over the threads of the block. Each thread
+   * issues its remote elements as non-blocking gets and completes them
+   * with a single quiet, so the latencies of all gets of the team
+   * overlap. */
+  template <class TeamType>
+  KOKKOS_INLINE_FUNCTION void team_gather(const TeamType &team, T *dst,
+                                          const int *pes,
+                                          const size_t *offsets,
+                                          const size_t n) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    team.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n),
+                         [&](const size_t j) {
+      Kokkos::single(Kokkos::PerThread(team), [&]() {
+        const T *lptr = local_ptr(pes[j], offsets[j]);
+        KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pes[j]),
+                                   lptr != NULL, sizeof(T));
+        if (lptr)
+          dst[j] = *lptr;
+        else
+          nvshmem_getmem_nbi(dst + j, ptr + offsets[j], sizeof(T),
+                             world_pe(pes[j]));
+      });
+    });
+    nvshmem_quiet();
+    team.team_barrier();
+#else
+    Kokkos::abort("NVSHMEMSpace team transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_get(T *dst, const int pe, const size_t first,
+                  const size_t n) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    nvshmem_getmem(dst, ptr + first, n * sizeof(T), world_pe(pe));
+#else
+    Kokkos::abort("NVSHMEMSpace thread transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_put(const T *src, const int pe, const size_t first,
+                  const size_t n) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    nvshmem_putmem(ptr + first, src, n * sizeof(T), world_pe(pe));
+#else
+    Kokkos::abort("NVSHMEMSpace thread transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  template <class SigHandle>
+  KOKKOS_INLINE_FUNCTION void
+  thread_put_signal(const T *src, const int pe, const size_t first,
+                    const size_t n, const SigHandle &sig,
+                    const size_t sig_index, const uint64_t value,
+                    const int sig_op) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    nvshmem_putmem_signal(ptr + first, src, n * sizeof(T),
+                          sig.ptr + sig_index, value,
+                          nvshmem_signal_op_of(sig_op), world_pe(pe));
+#else
+    Kokkos::abort("NVSHMEMSpace thread transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void thread_signal(const int pe, const size_t i, const uint64_t value,
+                     const int sig_op) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, world_pe(pe),
+                               pe == my_pe, sizeof(T));
+    nvshmem_fence();
+    nvshmemx_signal_op(ptr + i, value, nvshmem_signal_op_of(sig_op),
+                       world_pe(pe));
+#else
+    Kokkos::abort("NVSHMEMSpace thread transfers require a CUDA execution "
+                  "space");
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  uint64_t thread_wait_until(const size_t i, const int cmp,
+                             const uint64_t cmp_value) const {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    return nvshmem_signal_wait_until(ptr + i, nvshmem_cmp_of(cmp),
+                                     cmp_value);
+#else
+    Kokkos::abort("NVSHMEMSpace thread transfers require a CUDA execution "
+                  "space");
+    return 0;
+#endif
+  }
 };
 
 template <class Traits>
@@ -392,19 +1330,39 @@ struct ViewDataHandle<
                 Kokkos::Experimental::RemoteSpaceSpecializeTag>::value>::type> {
 
   typedef typename Traits::value_type value_type;
-  typedef NVSHMEMDataHandle<value_type> handle_type;
-  typedef NVSHMEMDataElement<value_type> return_type;
+  typedef NVSHMEMDataHandle<value_type, Traits> handle_type;
+  typedef NVSHMEMElement<value_type, Traits> return_type;
   typedef Kokkos::Impl::SharedAllocationTracker track_type;
 
   KOKKOS_INLINE_FUNCTION
   static handle_type assign(value_type *arg_data_ptr,
-                            track_type const & /*arg_tracker*/) {
+                            track_type const &arg_tracker) {
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+    auto *record =
+        arg_tracker.template get_record<Kokkos::Experimental::NVSHMEMSpace>();
+    if (record) {
+      handle_type handle(arg_data_ptr, -1, record->m_space.pe_map,
+                         record->m_space.scope);
+      handle.peer_ptrs = record->peer_ptrs;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+      handle.counters = record->counters;
+#endif
+      return handle;
+    }
+#endif
     return handle_type(arg_data_ptr);
   }
 
   KOKKOS_INLINE_FUNCTION
-  static handle_type assign(handle_type const arg_data_ptr, size_t offset) {
-    return handle_type(arg_data_ptr + offset);
+  static handle_type assign(handle_type const arg_handle, size_t offset) {
+    handle_type handle(arg_handle.ptr + offset, arg_handle.my_pe,
+                       arg_handle.pe_map, arg_handle.scope);
+    handle.peer_ptrs = arg_handle.peer_ptrs;
+    handle.offset = arg_handle.offset + offset;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    handle.counters = arg_handle.counters;
+#endif
+    return handle;
   }
 };
 } // namespace Impl
@@ -447,13 +1405,23 @@ private:
 
   typedef typename ViewDataHandle<Traits>::handle_type handle_type;
 
+  enum : bool {
+    is_fixed_pe = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_fixed_pe
+  };
+
   handle_type m_handle;
   offset_type m_offset;
   int m_num_pes;
+  // First PE addressed by the view, non-zero for subviews
+  int m_pe_offset;
+  // Row distribution of Asymmetric and Monolithic allocations
+  Kokkos::Experimental::Impl::PEPartition m_partition;
 
   KOKKOS_INLINE_FUNCTION
   ViewMapping(const handle_type &arg_handle, const offset_type &arg_offset)
-      : m_handle(arg_handle), m_offset(arg_offset) {}
+      : m_handle(arg_handle), m_offset(arg_offset), m_num_pes(0),
+        m_pe_offset(0) {}
 
 public:
   typedef void printable_label_typedef;
@@ -466,7 +1434,8 @@ public:
 
   template <typename iType>
   KOKKOS_INLINE_FUNCTION constexpr size_t extent(const iType &r) const {
-    return m_offset.m_dim.extent(r);
+    return (r == 0 && m_partition.is_monolithic) ? m_partition.global_rows
+                                                 : m_offset.m_dim.extent(r);
   }
 
   KOKKOS_INLINE_FUNCTION constexpr typename Traits::array_layout
@@ -475,7 +1444,9 @@ public:
   }
 
   KOKKOS_INLINE_FUNCTION constexpr size_t dimension_0() const {
-    return m_num_pes;
+    return is_fixed_pe ? m_offset.dimension_0()
+                       : m_partition.is_monolithic ? m_partition.global_rows
+                                                   : m_num_pes;
   }
   KOKKOS_INLINE_FUNCTION constexpr size_t dimension_1() const {
     return m_offset.dimension_1();
@@ -535,9 +1506,10 @@ public:
   //----------------------------------------
   // Range span
 
-  /** \brief  Span of the mapped range */
+  /** \brief  Span of the mapped range in the local segment */
   KOKKOS_INLINE_FUNCTION constexpr size_t span() const {
-    return m_offset.span();
+    return m_partition.is_monolithic ? m_offset.span() * m_partition.local_rows
+                                     : m_offset.span();
   }
 
   /** \brief  Is the mapped range span contiguous */
@@ -553,60 +1525,77 @@ public:
     return m_handle.ptr;
   }
 
+  /** \brief  Query the remote data handle */
+  KOKKOS_INLINE_FUNCTION const handle_type &handle() const { return m_handle; }
+
+  /** \brief  Query the first PE addressed by the view */
+  KOKKOS_INLINE_FUNCTION int pe_offset() const { return m_pe_offset; }
+
+  /** \brief  Query the row distribution of the allocation */
+  KOKKOS_INLINE_FUNCTION
+  const Kokkos::Experimental::Impl::PEPartition &partition() const {
+    return m_partition;
+  }
+
   //----------------------------------------
   // The View class performs all rank and bounds checking before
   // calling these element reference methods.
 
   KOKKOS_FORCEINLINE_FUNCTION
-  reference_type reference() const { return m_handle[0]; }
+  reference_type reference() const { return m_handle(m_pe_offset, 0); }
 
-  template <typename I0>
+  /* Element i of the segment selected by the leading index i0. For
+   * Monolithic views i0 is a global row, otherwise a PE relative to
+   * m_pe_offset. */
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  !std::is_same<typename Traits::array_layout,
-                                                Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+  reference_type pe_reference(const size_t i0, const size_t i) const {
+    if (!m_partition.is_monolithic)
+      return m_handle(m_pe_offset + i0, i);
+    const int pe = m_partition.owner(i0);
+    return m_handle(pe, (i0 - m_partition.offsets[pe]) * m_offset.span() + i);
   }
 
+  // Views with a fixed PE address the segment of PE m_pe_offset only,
+  // otherwise the leading index selects the segment, see pe_reference.
   template <typename I0>
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  std::is_same<typename Traits::array_layout,
-                                               Kokkos::LayoutStride>::value,
-                              reference_type>::type
+      typename std::enable_if<std::is_integral<I0>::value, reference_type>::type
       reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+    return is_fixed_pe ? m_handle(m_pe_offset, m_offset(i0))
+                       : pe_reference(i0, 0);
   }
 
   template <typename I0, typename I1>
-  KOKKOS_FORCEINLINE_FUNCTION const reference_type
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1) const {
-    // const reference_type element = m_handle(i0, m_offset(0, i1));
-    return m_handle(i0, m_offset(0, i1));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1))
+               : pe_reference(i0, m_offset(0, i1));
   }
 
   template <typename I0, typename I1, typename I2>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2) const {
-    return m_handle(i0, m_offset(0, i1, i2));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2))
+               : pe_reference(i0, m_offset(0, i1, i2));
   }
 
   template <typename I0, typename I1, typename I2, typename I3>
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3))
+               : pe_reference(i0, m_offset(0, i1, i2, i3));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2,
-                                                       const I3 &i3,
-                                                       const I4 &i4) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
+            const I4 &i4) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -614,7 +1603,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -622,7 +1613,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -630,7 +1623,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6, const I7 &i7) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6, i7))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
   }
 
   //----------------------------------------
@@ -642,32 +1637,38 @@ private:
 public:
   /** \brief  Span, in bytes, of the referenced memory */
   KOKKOS_INLINE_FUNCTION constexpr size_t memory_span() const {
-    return (m_offset.span() * sizeof(typename Traits::value_type) +
-            MemorySpanMask) &
+    return (span() * sizeof(typename Traits::value_type) + MemorySpanMask) &
            ~size_t(MemorySpanMask);
   }
 
   //----------------------------------------
 
   KOKKOS_INLINE_FUNCTION ~ViewMapping() {}
-  KOKKOS_INLINE_FUNCTION ViewMapping() : m_handle(), m_offset(), m_num_pes(0) {}
+  KOKKOS_INLINE_FUNCTION ViewMapping()
+      : m_handle(), m_offset(), m_num_pes(0), m_pe_offset(0) {}
   KOKKOS_INLINE_FUNCTION ViewMapping(const ViewMapping &rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_INLINE_FUNCTION ViewMapping &operator=(const ViewMapping &rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
   KOKKOS_INLINE_FUNCTION ViewMapping(ViewMapping &&rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_INLINE_FUNCTION ViewMapping &operator=(ViewMapping &&rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
@@ -704,6 +1705,7 @@ public:
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
     m_num_pes = nvshmem_n_pes();
+    m_pe_offset = 0;
   }
 
   /**\brief  Assign data */
@@ -728,6 +1730,9 @@ public:
     typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
         record_type;
 
+    static_assert(!is_fixed_pe,
+                  "Views with a fixed PE can only be created as subviews");
+
     // Query the mapping for byte-size of allocation.
     // If padding is allowed then pass in sizeof value type
     // for padding computation.
@@ -740,22 +1745,64 @@ public:
       layout.dimension[i] = arg_layout.dimension[i];
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
-    m_num_pes = nvshmem_n_pes();
+    const memory_space &space =
+        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
+            .value;
+    m_num_pes = space.impl_num_pes();
+    m_pe_offset = 0;
+
+    const int allocation_mode = space.allocation_mode;
+    size_t *pe_offsets = NULL;
+    size_t *pe_offsets_device = NULL;
+    if (allocation_mode == Kokkos::Experimental::Asymmetric ||
+        allocation_mode == Kokkos::Experimental::Monolithic) {
+      const bool is_monolithic =
+          allocation_mode == Kokkos::Experimental::Monolithic;
+      // Offsets within a segment only agree across PEs of different extents
+      // if the varying extent is the slowest running one
+      if (!is_monolithic && Traits::rank > 2 &&
+          !std::is_same<typename Traits::array_layout,
+                        Kokkos::LayoutRight>::value)
+        Kokkos::abort("Asymmetric views of rank > 2 require LayoutRight");
+      const size_t local_rows =
+          is_monolithic ? arg_layout.dimension[0]
+                        : (Traits::rank > 1 ? arg_layout.dimension[1] : 1);
+      // The offsets are gathered over MPI_COMM_WORLD, whose ranks are the
+      // PEs of the world team. Teams of a subset of the PEs only allocate
+      // Symmetric views from a RemoteArena, abort before the collective.
+      if (m_num_pes != nvshmem_n_pes())
+        Kokkos::abort("NVSHMEMSpace: Asymmetric and Monolithic views require a "
+                      "team of all PEs.");
+      pe_offsets = Kokkos::Experimental::Impl::allgather_pe_offsets(local_rows);
+      // Element access on the device requires a device copy of the table
+      const size_t nbytes = (m_num_pes + 1) * sizeof(size_t);
+      cudaMalloc(&pe_offsets_device, nbytes);
+      cudaMemcpy(pe_offsets_device, pe_offsets, nbytes, cudaMemcpyHostToDevice);
+      m_partition = Kokkos::Experimental::Impl::PEPartition(
+          pe_offsets_device, pe_offsets, m_num_pes, is_monolithic, local_rows,
+          pe_offsets[m_num_pes]);
+    }
 
     const size_t alloc_size = memory_span();
 
     // Create shared memory tracking record with allocate memory from the memory
     // space
     record_type *const record = record_type::allocate(
-        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
-            .value,
+        space,
         ((Kokkos::Impl::ViewCtorProp<void, std::string> const &)arg_prop).value,
         alloc_size);
+    record->pe_offsets = pe_offsets;
+    record->pe_offsets_device = pe_offsets_device;
 
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     if (alloc_size) {
 #endif
-      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()));
+      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()),
+                             space.impl_my_pe(), space.pe_map, space.scope);
+      m_handle.peer_ptrs = record->peer_ptrs;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+      m_handle.counters = record->counters;
+#endif
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     }
 #endif
@@ -771,7 +1818,195 @@ public:
   }
 };
 
+/* Team-based reductions, stream-ordered from the host and block-wide
+ * from device code */
+#define KOKKOS_SHMEM_REDUCE(type, name)                                        \
+  static inline void shmem_type_reduce(nvshmem_team_t team, type *dst,         \
+                                       const type *src, const size_t n,        \
+                                       const int op, cudaStream_t stream) {    \
+    switch (op) {                                                              \
+    case Kokkos::Experimental::OpSum:                                          \
+      nvshmemx_##name##_sum_reduce_on_stream(team, dst, src, n, stream);       \
+      break;                                                                   \
+    case Kokkos::Experimental::OpProd:                                         \
+      nvshmemx_##name##_prod_reduce_on_stream(team, dst, src, n, stream);      \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMin:                                          \
+      nvshmemx_##name##_min_reduce_on_stream(team, dst, src, n, stream);       \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMax:                                          \
+      nvshmemx_##name##_max_reduce_on_stream(team, dst, src, n, stream);       \
+      break;                                                                   \
+    default:                                                                   \
+      Kokkos::abort("NVSHMEMSpace: unsupported reduction operation.");         \
+    }                                                                          \
+  }
+
+KOKKOS_SHMEM_REDUCE(short, short)
+KOKKOS_SHMEM_REDUCE(unsigned short, ushort)
+KOKKOS_SHMEM_REDUCE(int, int)
+KOKKOS_SHMEM_REDUCE(unsigned int, uint)
+KOKKOS_SHMEM_REDUCE(long, long)
+KOKKOS_SHMEM_REDUCE(unsigned long, ulong)
+KOKKOS_SHMEM_REDUCE(long long, longlong)
+KOKKOS_SHMEM_REDUCE(unsigned long long, ulonglong)
+KOKKOS_SHMEM_REDUCE(float, float)
+KOKKOS_SHMEM_REDUCE(double, double)
+
+#undef KOKKOS_SHMEM_REDUCE
+
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+#define KOKKOS_SHMEM_REDUCE_BLOCK(type, name)                                  \
+  static KOKKOS_INLINE_FUNCTION void shmem_type_reduce_block(                  \
+      nvshmem_team_t team, type *dst, const type *src, const size_t n,         \
+      const int op) {                                                          \
+    switch (op) {                                                              \
+    case Kokkos::Experimental::OpSum:                                          \
+      nvshmemx_##name##_sum_reduce_block(team, dst, src, n);                   \
+      break;                                                                   \
+    case Kokkos::Experimental::OpProd:                                         \
+      nvshmemx_##name##_prod_reduce_block(team, dst, src, n);                  \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMin:                                          \
+      nvshmemx_##name##_min_reduce_block(team, dst, src, n);                   \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMax:                                          \
+      nvshmemx_##name##_max_reduce_block(team, dst, src, n);                   \
+      break;                                                                   \
+    default:                                                                   \
+      Kokkos::abort("NVSHMEMSpace: unsupported reduction operation.");         \
+    }                                                                          \
+  }
+
+KOKKOS_SHMEM_REDUCE_BLOCK(short, short)
+KOKKOS_SHMEM_REDUCE_BLOCK(unsigned short, ushort)
+KOKKOS_SHMEM_REDUCE_BLOCK(int, int)
+KOKKOS_SHMEM_REDUCE_BLOCK(unsigned int, uint)
+KOKKOS_SHMEM_REDUCE_BLOCK(long, long)
+KOKKOS_SHMEM_REDUCE_BLOCK(unsigned long, ulong)
+KOKKOS_SHMEM_REDUCE_BLOCK(long long, longlong)
+KOKKOS_SHMEM_REDUCE_BLOCK(unsigned long long, ulonglong)
+KOKKOS_SHMEM_REDUCE_BLOCK(float, float)
+KOKKOS_SHMEM_REDUCE_BLOCK(double, double)
+
+#undef KOKKOS_SHMEM_REDUCE_BLOCK
+#endif
+
+} // namespace Impl
+
+namespace Experimental {
+namespace Impl {
+
+/* Collectives over the local segments of symmetric allocations. Source
+ * and destination must both be symmetric. Collectives issued with a
+ * Kokkos::Cuda instance are enqueued on its stream and do not block the
+ * host; the team_* variants are called by one block per PE from inside a
+ * kernel. NVSHMEM has no rooted reduction, reduce leaves the result on
+ * every PE. */
+template <> struct RemoteCollectives<Kokkos::Experimental::NVSHMEMSpace> {
+  typedef Kokkos::Experimental::NVSHMEMSpace::scope_type scope_type;
+
+  template <class T>
+  static void allreduce(const Kokkos::Cuda &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int op) {
+    Kokkos::Impl::shmem_type_reduce(scope, dst, src, n, op,
+                                    Kokkos::Impl::nvshmem_stream(exec));
+  }
+
+  template <class T>
+  static void reduce(const Kokkos::Cuda &exec, scope_type scope, T *dst,
+                     const T *src, const size_t n, const int op, const int) {
+    allreduce(exec, scope, dst, src, n, op);
+  }
+
+  template <class T>
+  static void broadcast(const Kokkos::Cuda &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int root) {
+    nvshmemx_broadcastmem_on_stream(scope, dst, src, n * sizeof(T), root,
+                                    Kokkos::Impl::nvshmem_stream(exec));
+  }
+
+  template <class T>
+  static void fcollect(const Kokkos::Cuda &exec, scope_type scope, T *dst,
+                       const T *src, const size_t n) {
+    nvshmemx_fcollectmem_on_stream(scope, dst, src, n * sizeof(T),
+                                   Kokkos::Impl::nvshmem_stream(exec));
+  }
+
+  /* Other execution spaces order the collective by fencing and wait for
+   * its completion */
+  template <class ExecSpace, class T>
+  static void allreduce(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int op) {
+    exec.fence();
+    allreduce(Kokkos::Cuda(), scope, dst, src, n, op);
+    Kokkos::Cuda().fence();
+  }
+
+  template <class ExecSpace, class T>
+  static void reduce(const ExecSpace &exec, scope_type scope, T *dst,
+                     const T *src, const size_t n, const int op,
+                     const int root) {
+    exec.fence();
+    reduce(Kokkos::Cuda(), scope, dst, src, n, op, root);
+    Kokkos::Cuda().fence();
+  }
+
+  template <class ExecSpace, class T>
+  static void broadcast(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int root) {
+    exec.fence();
+    broadcast(Kokkos::Cuda(), scope, dst, src, n, root);
+    Kokkos::Cuda().fence();
+  }
+
+  template <class ExecSpace, class T>
+  static void fcollect(const ExecSpace &exec, scope_type scope, T *dst,
+                       const T *src, const size_t n) {
+    exec.fence();
+    fcollect(Kokkos::Cuda(), scope, dst, src, n);
+    Kokkos::Cuda().fence();
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_allreduce(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int op) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    team.team_barrier();
+    Kokkos::Impl::shmem_type_reduce_block(scope, dst, src, n, op);
+#else
+    Kokkos::abort("NVSHMEMSpace: team collectives require a Cuda kernel.");
+#endif
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_broadcast(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int root) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    team.team_barrier();
+    nvshmemx_broadcastmem_block(scope, dst, src, n * sizeof(T), root);
+#else
+    Kokkos::abort("NVSHMEMSpace: team collectives require a Cuda kernel.");
+#endif
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_INLINE_FUNCTION static void
+  team_fcollect(const TeamType &team, scope_type scope, T *dst, const T *src,
+                const size_t n) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA
+    team.team_barrier();
+    nvshmemx_fcollectmem_block(scope, dst, src, n * sizeof(T));
+#else
+    Kokkos::abort("NVSHMEMSpace: team collectives require a Cuda kernel.");
+#endif
+  }
+};
+
 } // namespace Impl
+} // namespace Experimental
 } // namespace Kokkos
 
-#endif
\ No newline at end of file
+#endif
@@ -44,6 +44,8 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_SHMEMSpace.hpp>
+#include <Kokkos_RemoteSpaces_Topology.hpp>
+#include <map>
 #include <shmem.h>
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -51,8 +53,43 @@
 namespace Kokkos {
 namespace Experimental {
 
+namespace {
+
+/* Translation tables of the teams used so far */
+const int *team_pe_map(shmem_team_t team) {
+  static std::map<shmem_team_t, int *> maps;
+  if (team == SHMEM_TEAM_WORLD)
+    return NULL;
+  int *&map = maps[team];
+  if (!map) {
+    const int num_pes = shmem_team_n_pes(team);
+    map = new int[num_pes];
+    for (int pe = 0; pe < num_pes; pe++)
+      map[pe] = shmem_team_translate_pe(team, pe, SHMEM_TEAM_WORLD);
+  }
+  return map;
+}
+
+} // namespace
+
 /* Default allocation mechanism */
-SHMEMSpace::SHMEMSpace() : allocation_mode(Symmetric) {}
+SHMEMSpace::SHMEMSpace()
+    : allocation_mode(Symmetric), scope(SHMEM_TEAM_WORLD), pe_map(NULL) {}
+
+SHMEMSpace::SHMEMSpace(const scope_type &team)
+    : allocation_mode(Symmetric), scope(team), pe_map(team_pe_map(team)) {
+  if (team == SHMEM_TEAM_INVALID)
+    Kokkos::abort("SHMEMSpace: invalid team.");
+}
+
+SHMEMSpace::SHMEMSpace(const MPI_Comm &comm)
+    : allocation_mode(Symmetric), scope(SHMEM_TEAM_WORLD), pe_map(NULL) {
+  int result;
+  MPI_Comm_compare(comm, MPI_COMM_WORLD, &result);
+  if (result != MPI_IDENT && result != MPI_CONGRUENT)
+    Kokkos::abort("SHMEMSpace: communicators must span all PEs, construct "
+                  "the space from a shmem_team_t instead.");
+}
 
 
 void SHMEMSpace::impl_set_allocation_mode(const int allocation_mode_) {
@@ -61,6 +98,11 @@ void SHMEMSpace::impl_set_allocation_mode(const int allocation_mode_) {
 
 void SHMEMSpace::impl_set_extent(const int64_t extent_) { extent = extent_; }
 
+void SHMEMSpace::impl_set_arena(
+    const std::shared_ptr<Impl::RemoteArenaState> &arena_) {
+  arena = arena_;
+}
+
 void *SHMEMSpace::allocate(const size_t arg_alloc_size) const {
   static_assert(sizeof(void *) == sizeof(uintptr_t),
                 "Error sizeof(void*) != sizeof(uintptr_t)");
@@ -70,24 +112,60 @@ void *SHMEMSpace::allocate(const size_t arg_alloc_size) const {
       "Memory alignment must be power of two");
 
   void *ptr = 0;
-  if (arg_alloc_size) {
-
-    if (allocation_mode == Kokkos::Experimental::Symmetric) {
+  if (arg_alloc_size && arena) {
+    // Blocks lie at the same offset of the arena on all PEs and are
+    // therefore symmetric
+    if (allocation_mode != Kokkos::Experimental::Symmetric)
+      Kokkos::abort("SHMEMSpace: RemoteArena only supports Symmetric views.");
+    ptr = arena->allocate_ptr(arg_alloc_size, name());
+  } else if (arg_alloc_size) {
+    if (impl_num_pes() != shmem_n_pes())
+      Kokkos::abort("SHMEMSpace: allocations of a team of a subset of the "
+                    "PEs require a RemoteArena.");
+
+    // The runtime already maps on-node peers to load/store
+    if (allocation_mode == Kokkos::Experimental::Symmetric ||
+        allocation_mode == Kokkos::Experimental::SymmetricShared) {
       int num_pes = shmem_n_pes();
       int my_id = shmem_my_pe();
       ptr = shmem_malloc(arg_alloc_size);
+    } else if (allocation_mode == Kokkos::Experimental::Asymmetric ||
+               allocation_mode == Kokkos::Experimental::Monolithic) {
+      // The symmetric heap requires the same size on all PEs
+      ptr = shmem_malloc(
+          Kokkos::Experimental::Impl::allreduce_max_size(arg_alloc_size));
     } else {
-      Kokkos::abort("SHMEMSpace only supports symmetric allocation policy.");
+      Kokkos::abort("SHMEMSpace: unknown allocation policy.");
     }
+    // shmem_malloc is collective over all PEs
+    Kokkos::Experimental::Impl::numa_first_touch(ptr, arg_alloc_size, true);
   }
   return ptr;
 }
 
-void SHMEMSpace::deallocate(void *const arg_alloc_ptr, const size_t) const {
-  shmem_free(arg_alloc_ptr);
+void SHMEMSpace::deallocate(void *const arg_alloc_ptr,
+                            const size_t arg_alloc_size) const {
+  if (arena)
+    arena->deallocate_ptr(arg_alloc_ptr, arg_alloc_size);
+  else
+    shmem_free(arg_alloc_ptr);
+}
+
+void SHMEMSpace::fence() {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("SHMEMSpace::fence");
+  shmem_quiet();
+  shmem_team_sync(scope);
 }
 
-void SHMEMSpace::fence() { shmem_barrier_all(); }
+/* Puts and gets are blocking and thus locally complete on return */
+void SHMEMSpace::fence_local() const {}
+
+void SHMEMSpace::fence_all(const bool barrier, const scope_type &team) {
+  KOKKOS_REMOTE_SPACES_FENCE_TIMER("SHMEMSpace::fence(view)");
+  shmem_quiet();
+  if (barrier)
+    shmem_team_sync(team);
+}
 
 } // namespace Experimental
 
@@ -129,6 +207,11 @@ SharedAllocationRecord<Kokkos::Experimental::SHMEMSpace,
   }
 #endif
 
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessRegistry::instance().retire(
+      counters);
+#endif
+  delete[] pe_offsets;
   m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
                      SharedAllocationRecord<void, void>::m_alloc_size);
 }
@@ -162,6 +245,15 @@ SharedAllocationRecord<Kokkos::Experimental::SHMEMSpace, void>::
 
   strncpy(RecordBase::m_alloc_ptr->m_label, arg_label.c_str(),
           SharedAllocationHeader::maximum_label_length);
+  pe_offsets = NULL;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  // Elements address world PEs
+  std::vector<int> world_pes(shmem_n_pes());
+  for (int pe = 0; pe < int(world_pes.size()); pe++)
+    world_pes[pe] = pe;
+  counters = Kokkos::Experimental::Impl::RemoteAccessRegistry::instance()
+                 .create(arg_label, world_pes);
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -47,6 +47,7 @@
 
 #include <cstring>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <typeinfo>
 
@@ -85,6 +86,9 @@ public:
 
   typedef Kokkos::Device<execution_space, memory_space> device_type;
 
+  /* PEs addressed by views of an instance */
+  typedef shmem_team_t scope_type;
+
   SHMEMSpace();
   SHMEMSpace(SHMEMSpace &&rhs) = default;
   SHMEMSpace(const SHMEMSpace &rhs) = default;
@@ -92,7 +96,17 @@ public:
   SHMEMSpace &operator=(const SHMEMSpace &) = default;
   ~SHMEMSpace() = default;
 
-  explicit SHMEMSpace(const MPI_Comm &);
+  /**\brief Views allocated with this instance span the PEs of team only.
+   *         Their PE index is the rank in team and fences synchronize the
+   *         team. The symmetric heap is collective over all PEs, so views
+   *         of a team spanning a subset of the PEs are allocated from a
+   *         RemoteArena, see RemoteArena::space(const memory_space &). */
+  explicit SHMEMSpace(const scope_type &team);
+
+  /**\brief SHMEM teams cannot be derived from a communicator without
+   *         involving all PEs, comm must therefore span all PEs in
+   *         order */
+  explicit SHMEMSpace(const MPI_Comm &comm);
 
   void *allocate(const size_t arg_alloc_size) const;
 
@@ -106,15 +120,64 @@ public:
   /**\brief Return Name of the MemorySpace */
   static constexpr const char *name() { return m_name; }
 
+  /**\brief Complete all outstanding one-sided operations and synchronize
+   *         the PEs of the team of this instance */
   void fence();
 
+  /**\brief Complete outstanding one-sided operations issued by this PE.
+   *         SHMEM has no per-allocation completion, so this completes
+   *         operations on all allocations; with barrier, the PEs of the
+   *         team of v synchronize afterwards */
+  template <class ViewType>
+  void fence(const ViewType &v, const bool barrier = true) const {
+    fence_all(barrier, v.impl_map().handle().scope);
+  }
+
+  /**\brief Local completion of outstanding operations */
+  template <class ViewType> void fence_local(const ViewType &) const {
+    fence_local();
+  }
+  void fence_local() const;
+
+  static void fence_all(const bool barrier,
+                        const scope_type &team = SHMEM_TEAM_WORLD);
+
+  /**\brief Completes remote operations issued by the calling PE */
+  static void quiet() { shmem_quiet(); }
+
+  /**\brief Orders remote stores of the calling PE to each PE without
+   *         awaiting their completion */
+  static void ordering_fence() { shmem_fence(); }
+
+  /**\brief Rank of the calling PE in and size of team */
+  static int impl_my_pe(const scope_type &team) {
+    return shmem_team_my_pe(team);
+  }
+  static int impl_num_pes(const scope_type &team) {
+    return shmem_team_n_pes(team);
+  }
+  int impl_my_pe() const { return impl_my_pe(scope); }
+  int impl_num_pes() const { return impl_num_pes(scope); }
+
   int *rank_list;
   int allocation_mode;
   int64_t extent;
 
+  /* Team of the allocations, SHMEM_TEAM_WORLD by default */
+  scope_type scope;
+
+  /* World PE of each rank of scope, NULL for SHMEM_TEAM_WORLD. Shared by
+   * all instances of a team and never freed. */
+  const int *pe_map;
+
+  /* Set on instances returned by RemoteArena::space(). Allocations are
+   * then carved from the arena instead of the symmetric heap. */
+  std::shared_ptr<Impl::RemoteArenaState> arena;
+
   void impl_set_rank_list(int *const);
   void impl_set_allocation_mode(const int);
   void impl_set_extent(int64_t N);
+  void impl_set_arena(const std::shared_ptr<Impl::RemoteArenaState> &);
 
 private:
   static constexpr const char *m_name = "SHMEM";
@@ -183,6 +246,15 @@ protected:
       const RecordBase::function_type arg_dealloc = &deallocate);
 
 public:
+  /* Row offsets of Asymmetric and Monolithic allocations, see
+   * Kokkos::Experimental::Impl::PEPartition. Owned by the record. */
+  size_t *pe_offsets;
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  /* Access counters of the allocation. Owned by the record. */
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters;
+#endif
+
   inline std::string get_label() const {
     return std::string(RecordBase::head()->m_label);
   }
@@ -253,7 +325,9 @@ struct DeepCopy<Kokkos::Experimental::SHMEMSpace,
 } // namespace Impl
 } // namespace Kokkos
 
+#include <Kokkos_RemoteSpaces_Partition.hpp>
 #include <Kokkos_SHMEMSpace_ViewMapping.hpp>
+#include <Kokkos_RemoteSpaces_Subview.hpp>
 #include <Kokkos_RemoteSpaces_DeepCopy.hpp>
 
 #endif // #define KOKKOS_SHMEMSPACE_HPP
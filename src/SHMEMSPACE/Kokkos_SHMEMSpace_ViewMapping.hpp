@@ -105,282 +105,822 @@ KOKKOS_SHMEM_G(double, shmem_double_g)
 
 #undef KOKKOS_SHMEM_G
 
-template <class T> 
+/* Remote atomics. Typed OpenSHMEM atomics exist for the integer types,
+ * swap additionally for float and double. Outside host code the element
+ * is updated with a Kokkos atomic, which is only meaningful for the
+ * local segment. */
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+#define KOKKOS_SHMEM_ATOMIC(op, kfxn, type, ctype, fxn) \
+static inline type shmem_type_atomic_##op(type *ptr, const type &val, \
+                                         int pe) { \
+  return (type)fxn((ctype *)ptr, (ctype)val, pe); \
+}
+#define KOKKOS_SHMEM_ATOMIC_CSWAP(type, fxn) \
+static inline type shmem_type_atomic_compare_swap( \
+    type *ptr, const type &cond, const type &val, int pe) { \
+  return fxn(ptr, cond, val, pe); \
+}
+#else
+#define KOKKOS_SHMEM_ATOMIC(op, kfxn, type, ctype, fxn) \
+static inline type shmem_type_atomic_##op(type *ptr, const type &val, \
+                                         int pe) { \
+  return Kokkos::kfxn(ptr, val); \
+}
+#define KOKKOS_SHMEM_ATOMIC_CSWAP(type, fxn) \
+static inline type shmem_type_atomic_compare_swap( \
+    type *ptr, const type &cond, const type &val, int pe) { \
+  return Kokkos::atomic_compare_exchange(ptr, cond, val); \
+}
+#endif
+
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, int, int,
+                    shmem_int_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, unsigned int, unsigned int,
+                    shmem_uint_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, long, long,
+                    shmem_long_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, unsigned long, unsigned long,
+                    shmem_ulong_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, long long, long long,
+                    shmem_longlong_atomic_fetch_add)
+KOKKOS_SHMEM_ATOMIC(fetch_add, atomic_fetch_add, unsigned long long,
+                    unsigned long long, shmem_ulonglong_atomic_fetch_add)
+
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, int, int32_t,
+                    shmem_int32_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, unsigned int, unsigned int,
+                    shmem_uint_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, long, int64_t,
+                    shmem_int64_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, unsigned long, unsigned long,
+                    shmem_ulong_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, long long, int64_t,
+                    shmem_int64_atomic_fetch_and)
+KOKKOS_SHMEM_ATOMIC(fetch_and, atomic_fetch_and, unsigned long long,
+                    unsigned long long, shmem_ulonglong_atomic_fetch_and)
+
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, int, int32_t,
+                    shmem_int32_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, unsigned int, unsigned int,
+                    shmem_uint_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, long, int64_t,
+                    shmem_int64_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, unsigned long, unsigned long,
+                    shmem_ulong_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, long long, int64_t,
+                    shmem_int64_atomic_fetch_or)
+KOKKOS_SHMEM_ATOMIC(fetch_or, atomic_fetch_or, unsigned long long,
+                    unsigned long long, shmem_ulonglong_atomic_fetch_or)
+
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, int, int32_t,
+                    shmem_int32_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, unsigned int, unsigned int,
+                    shmem_uint_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, long, int64_t,
+                    shmem_int64_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, unsigned long, unsigned long,
+                    shmem_ulong_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, long long, int64_t,
+                    shmem_int64_atomic_fetch_xor)
+KOKKOS_SHMEM_ATOMIC(fetch_xor, atomic_fetch_xor, unsigned long long,
+                    unsigned long long, shmem_ulonglong_atomic_fetch_xor)
+
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, int, int, shmem_int_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, unsigned int, unsigned int,
+                    shmem_uint_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, long, long, shmem_long_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, unsigned long, unsigned long,
+                    shmem_ulong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, long long, long long,
+                    shmem_longlong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, unsigned long long,
+                    unsigned long long, shmem_ulonglong_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, float, float,
+                    shmem_float_atomic_swap)
+KOKKOS_SHMEM_ATOMIC(swap, atomic_exchange, double, double,
+                    shmem_double_atomic_swap)
+
+KOKKOS_SHMEM_ATOMIC_CSWAP(int, shmem_int_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned int, shmem_uint_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(long, shmem_long_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned long, shmem_ulong_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(long long, shmem_longlong_atomic_compare_swap)
+KOKKOS_SHMEM_ATOMIC_CSWAP(unsigned long long,
+                          shmem_ulonglong_atomic_compare_swap)
+
+#undef KOKKOS_SHMEM_ATOMIC
+#undef KOKKOS_SHMEM_ATOMIC_CSWAP
+
+template <class T, class Traits>
 struct SHMEMDataElement {
   typedef const T const_value_type;
   typedef T non_const_value_type;
   T *ptr;
   int pe;
-  SHMEMDataElement(T *ptr_, int pe_, int i_) : ptr(ptr_ + i_), pe(pe_) {}
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  SHMEMDataElement(T *ptr_, int pe_, int i_, bool is_local_)
+      : ptr(ptr_ + i_), pe(pe_), is_local(is_local_) {}
+
+  // Elements in the local segment are accessed directly
+  KOKKOS_DEFAULTED_FUNCTION
+  T get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    return is_local ? *ptr : shmem_type_g(ptr, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (is_local)
+      *ptr = val;
+    else
+      shmem_type_p(ptr, val, pe);
+  }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator=(const_value_type &val) const {
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   void inc() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   void dec() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator++() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator--() const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator++(int) const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val++;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator--(int) const {
-    T val = shmem_type_g(ptr, pe);
+    T val = get();
     val--;
-    shmem_type_p(ptr, val, pe);
+    put(val);
     return val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator+=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp += val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator-=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp -= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator*=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp *= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator/=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp /= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator%=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp %= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator&=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp &= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator^=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp ^= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator|=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp |= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator<<=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp <<= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator>>=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     tmp >>= val;
-    shmem_type_p(ptr, tmp, pe);
+    put(tmp);
     return tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator+(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp + val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator-(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp - val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator*(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp * val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator/(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp / val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator%(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp % val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator!() const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return !tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator&&(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp && val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator||(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp || val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator&(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp & val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator|(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp | val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator^(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp ^ val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator~() const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return ~tmp;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator<<(const unsigned int &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp << val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   const_value_type operator>>(const unsigned int &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp >> val;
   }
 
+  /* Remote atomics. Each returns the value found at the target before
+   * the update. They are issued through SHMEM even for the local
+   * segment so that they stay atomic with respect to other PEs. */
+  KOKKOS_DEFAULTED_FUNCTION
+  T fetch_add(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_add(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  T fetch_and(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_and(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  T fetch_or(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_or(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  T fetch_xor(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_fetch_xor(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  T exchange(const_value_type &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_swap(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  T compare_exchange(const_value_type &expected,
+                     const_value_type &desired) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, pe, is_local, sizeof(T));
+    return shmem_type_atomic_compare_swap(ptr, expected, desired, pe);
+  }
+
   KOKKOS_DEFAULTED_FUNCTION
   bool operator==(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp == val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   bool operator!=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp != val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   bool operator>=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp >= val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   bool operator<=(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp <= val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   bool operator<(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp < val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
   bool operator>(const_value_type &val) const {
-    T tmp = shmem_type_g(ptr, pe);
+    T tmp = get();
     return tmp > val;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
-  operator const_value_type() const { return shmem_type_g(ptr, pe); }
+  operator const_value_type() const { return get(); }
+};
+
+/* Reference to an element of a ReadOnly view or a view of const value
+ * type. It only converts to the value of the element. */
+template <class T, class Traits>
+struct SHMEMReadElement {
+  typedef typename std::remove_const<T>::type non_const_value_type;
+  typedef const non_const_value_type const_value_type;
+  non_const_value_type *ptr;
+  int pe;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  SHMEMReadElement(T *ptr_, int pe_, int i_, bool is_local_)
+      : ptr(const_cast<non_const_value_type *>(ptr_) + i_), pe(pe_),
+        is_local(is_local_) {}
+
+  KOKKOS_DEFAULTED_FUNCTION
+  non_const_value_type get() const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, pe, is_local, sizeof(T));
+    return is_local ? *ptr : shmem_type_g(ptr, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  operator const_value_type() const { return get(); }
 };
 
-template <class T> struct SHMEMDataHandle {
+/* Reference to an element of a WriteOnly view. It only supports
+ * assignment, stores complete remotely at the next fence. */
+template <class T, class Traits>
+struct SHMEMWriteElement {
+  typedef const T const_value_type;
+  typedef T non_const_value_type;
   T *ptr;
+  int pe;
+  bool is_local;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
+
+  SHMEMWriteElement(T *ptr_, int pe_, int i_, bool is_local_)
+      : ptr(ptr_ + i_), pe(pe_), is_local(is_local_) {}
+
+  KOKKOS_DEFAULTED_FUNCTION
+  void put(const T &val) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, pe, is_local, sizeof(T));
+    if (is_local)
+      *ptr = val;
+    else
+      shmem_type_p(ptr, val, pe);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  const_value_type operator=(const_value_type &val) const {
+    put(val);
+    return val;
+  }
+};
+
+template <class T, class Traits>
+using SHMEMElement = typename Kokkos::Experimental::Impl::remote_element<
+    T, Traits, SHMEMDataElement, SHMEMReadElement, SHMEMWriteElement>::type;
+
+/* Strided transfers of elements of N bytes */
+template <int N> struct shmem_strided;
+
+#define KOKKOS_SHMEM_STRIDED(bytes, iput, iget) \
+template <> struct shmem_strided<bytes> { \
+  static void put(void *dst, const void *src, ptrdiff_t dst_stride, \
+                  ptrdiff_t src_stride, size_t n, int pe) { \
+    iput(dst, src, dst_stride, src_stride, n, pe); \
+  } \
+  static void get(void *dst, const void *src, ptrdiff_t dst_stride, \
+                  ptrdiff_t src_stride, size_t n, int pe) { \
+    iget(dst, src, dst_stride, src_stride, n, pe); \
+  } \
+};
+
+KOKKOS_SHMEM_STRIDED(1, shmem_iput8, shmem_iget8)
+KOKKOS_SHMEM_STRIDED(2, shmem_iput16, shmem_iget16)
+KOKKOS_SHMEM_STRIDED(4, shmem_iput32, shmem_iget32)
+KOKKOS_SHMEM_STRIDED(8, shmem_iput64, shmem_iget64)
+KOKKOS_SHMEM_STRIDED(16, shmem_iput128, shmem_iget128)
+
+#undef KOKKOS_SHMEM_STRIDED
+
+/* SHMEM constants of signal updates and wait conditions */
+inline int shmem_signal_op_of(const int op) {
+  return op == Kokkos::Experimental::SignalAdd ? SHMEM_SIGNAL_ADD
+                                               : SHMEM_SIGNAL_SET;
+}
+
+inline int shmem_cmp_of(const int cmp) {
+  switch (cmp) {
+  case Kokkos::Experimental::CmpEQ: return SHMEM_CMP_EQ;
+  case Kokkos::Experimental::CmpNE: return SHMEM_CMP_NE;
+  case Kokkos::Experimental::CmpGT: return SHMEM_CMP_GT;
+  case Kokkos::Experimental::CmpGE: return SHMEM_CMP_GE;
+  case Kokkos::Experimental::CmpLT: return SHMEM_CMP_LT;
+  default: return SHMEM_CMP_LE;
+  }
+}
+
+/* Completion handle of a non-blocking bulk transfer. OpenSHMEM completes
+ * non-blocking transfers per PE rather than individually, so completing
+ * one request completes all outstanding transfers of the calling PE and
+ * test() blocks. */
+struct SHMEMRemoteRequest {
+  bool pending;
+
+  SHMEMRemoteRequest() : pending(false) {}
+
+  void wait() {
+    if (pending) {
+      shmem_quiet();
+      pending = false;
+    }
+  }
+
+  bool test() {
+    wait();
+    return true;
+  }
+};
+
+template <class T, class Traits> struct SHMEMDataHandle {
+  enum : bool {
+    is_remote_only = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_remote_only
+  };
+  T *ptr;
+  // Rank of the calling PE in scope
+  int my_pe;
+  // World PE of each rank in scope, NULL for SHMEM_TEAM_WORLD
+  const int *pe_map;
+  // Team of the allocation, PE indices are ranks in it
+  shmem_team_t scope;
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+  // Access counters of the allocation, NULL if untracked
+  Kokkos::Experimental::Impl::RemoteAccessCounters *counters = NULL;
+#endif
   KOKKOS_DEFAULTED_FUNCTION
-  SHMEMDataHandle() : ptr(NULL) {}
+  SHMEMDataHandle()
+      : ptr(NULL), my_pe(-1), pe_map(NULL), scope(SHMEM_TEAM_WORLD) {}
   KOKKOS_DEFAULTED_FUNCTION
-  SHMEMDataHandle(T *ptr_) : ptr(ptr_) {}
+  SHMEMDataHandle(T *ptr_, int my_pe_ = -1, const int *pe_map_ = NULL,
+                  shmem_team_t scope_ = SHMEM_TEAM_WORLD)
+      : ptr(ptr_), my_pe(my_pe_), pe_map(pe_map_), scope(scope_) {}
+  // Also converts handles of T to handles of const T
+  template <class SrcT, class SrcTraits>
+  KOKKOS_DEFAULTED_FUNCTION
+  SHMEMDataHandle(const SHMEMDataHandle<SrcT, SrcTraits> &rhs)
+      : ptr(rhs.ptr), my_pe(rhs.my_pe), pe_map(rhs.pe_map),
+        scope(rhs.scope) {
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    counters = rhs.counters;
+#endif
+  }
+
+  /* Rank of the calling PE in scope */
+  KOKKOS_DEFAULTED_FUNCTION int impl_my_pe() const { return my_pe; }
+
+  /* PE argument of the SHMEM routines for rank pe of scope */
+  KOKKOS_DEFAULTED_FUNCTION int world_pe(const int pe) const {
+    return pe_map ? pe_map[pe] : pe;
+  }
+
   template <typename iType>
-  KOKKOS_DEFAULTED_FUNCTION SHMEMDataElement<T> operator()(const int &pe,
-                                                        const iType &i) const {
-    SHMEMDataElement<T> element(ptr, pe, i);
+  KOKKOS_DEFAULTED_FUNCTION SHMEMElement<T, Traits>
+  operator()(const int &pe, const iType &i) const {
+    SHMEMElement<T, Traits> element(ptr, world_pe(pe), i,
+                                        !is_remote_only && pe == my_pe);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    element.counters = counters;
+#endif
     return element;
   }
+
+  /* Bulk transfers of n contiguous elements starting at element first
+   * of the segment owned by pe. Both complete before returning. */
+  void get(T *dst, const int pe, const size_t first, const size_t n) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    shmem_getmem(dst, ptr + first, n * sizeof(T), world_pe(pe));
+  }
+
+  void put(const T *src, const int pe, const size_t first,
+           const size_t n) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    shmem_putmem(ptr + first, src, n * sizeof(T), world_pe(pe));
+    shmem_quiet();
+  }
+
+  /* Transfers between a strided local buffer and the strided region of
+   * the segment owned by pe that starts at element first. The last index
+   * is moved with one shmem_iput/iget per combination of the leading
+   * indices. Both complete before returning. */
+  void get_strided(
+      T *dst, const Kokkos::Experimental::Impl::StridedLayout &dst_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &src_layout) const {
+    const size_t n = src_layout.size();
+    if (n == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    const int last = src_layout.rank - 1;
+    const size_t len = src_layout.extent[last];
+    for (size_t k = 0; k < n; k += len)
+      shmem_strided<sizeof(T)>::get(
+          dst + dst_layout.offset(k), ptr + first + src_layout.offset(k),
+          dst_layout.stride[last], src_layout.stride[last], len,
+          world_pe(pe));
+  }
+
+  void put_strided(
+      const T *src, const Kokkos::Experimental::Impl::StridedLayout &src_layout,
+      const int pe, const size_t first,
+      const Kokkos::Experimental::Impl::StridedLayout &dst_layout) const {
+    const size_t n = src_layout.size();
+    if (n == 0)
+      return;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    const int last = src_layout.rank - 1;
+    const size_t len = src_layout.extent[last];
+    for (size_t k = 0; k < n; k += len)
+      shmem_strided<sizeof(T)>::put(
+          ptr + first + dst_layout.offset(k), src + src_layout.offset(k),
+          dst_layout.stride[last], src_layout.stride[last], len,
+          world_pe(pe));
+    shmem_quiet();
+  }
+
+  typedef SHMEMRemoteRequest request_type;
+
+  /* Non-blocking counterparts of get/put. The transfer is complete once
+   * the returned request is. */
+  template <class ExecSpace>
+  request_type get_async(const ExecSpace &, T *dst, const int pe,
+                         const size_t first, const size_t n) const {
+    request_type req;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    shmem_getmem_nbi(dst, ptr + first, n * sizeof(T), world_pe(pe));
+    req.pending = true;
+    return req;
+  }
+
+  template <class ExecSpace>
+  request_type put_async(const ExecSpace &, const T *src, const int pe,
+                         const size_t first, const size_t n) const {
+    request_type req;
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    shmem_putmem_nbi(ptr + first, src, n * sizeof(T), world_pe(pe));
+    req.pending = true;
+    return req;
+  }
+
+  /* Reads element offsets[j] of the segment owned by pes[j] into dst[j]
+   * for j < n. Elements of the calling PE are copied directly, all others
+   * are issued as non-blocking gets that complete together. Completes
+   * before returning. */
+  void gather(T *dst, const int *pes, const size_t *offsets,
+              const size_t n) const {
+    bool pending = false;
+    for (size_t j = 0; j < n; j++) {
+      const bool is_local = !is_remote_only && pes[j] == my_pe;
+      KOKKOS_REMOTE_SPACES_COUNT(counters, Get, world_pe(pes[j]), is_local,
+                                 sizeof(T));
+      if (is_local) {
+        dst[j] = ptr[offsets[j]];
+      } else {
+        shmem_getmem_nbi(dst + j, ptr + offsets[j], sizeof(T),
+                         world_pe(pes[j]));
+        pending = true;
+      }
+    }
+    if (pending)
+      shmem_quiet();
+  }
+
+  /* Puts n elements like put, then updates element sig_index of the
+   * segment of pe in the signal allocation of sig with value. The data
+   * is complete at pe before the signal changes. */
+  template <class SigHandle>
+  void put_signal(const T *src, const int pe, const size_t first,
+                  const size_t n, const SigHandle &sig,
+                  const size_t sig_index, const uint64_t value,
+                  const int sig_op) const {
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Put, world_pe(pe),
+                               pe == my_pe, n * sizeof(T));
+    shmem_putmem_signal(ptr + first, src, n * sizeof(T),
+                        sig.ptr + sig_index, value,
+                        shmem_signal_op_of(sig_op), world_pe(pe));
+  }
+
+  /* Atomically sets or adds value to element i of the segment of pe of
+   * a signal allocation. Ordered after prior puts of the calling PE. */
+  void signal(const int pe, const size_t i, const uint64_t value,
+              const int sig_op) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    KOKKOS_REMOTE_SPACES_COUNT(counters, Atomic, world_pe(pe),
+                               pe == my_pe, sizeof(T));
+    shmem_fence();
+    if (sig_op == Kokkos::Experimental::SignalAdd)
+      shmem_uint64_atomic_add(ptr + i, value, world_pe(pe));
+    else
+      shmem_uint64_atomic_set(ptr + i, value, world_pe(pe));
+  }
+
+  /* Blocks until element i of the local segment of a signal allocation
+   * satisfies cmp against cmp_value and returns it */
+  uint64_t wait_until(const size_t i, const int cmp,
+                      const uint64_t cmp_value) const {
+    static_assert(std::is_same<T, uint64_t>::value,
+                  "Signals must be of type uint64_t");
+    return shmem_signal_wait_until(ptr + i, shmem_cmp_of(cmp), cmp_value);
+  }
+
+  /* Device-side counterparts of get/put for team- and thread-level
+   * local_deep_copy. One member of the team issues the transfer. */
+  template <class TeamType>
+  KOKKOS_DEFAULTED_FUNCTION void team_get(const TeamType &team, T *dst,
+                                          const int pe, const size_t first,
+                                          const size_t n) const {
+    Kokkos::single(Kokkos::PerTeam(team), [&]() { get(dst, pe, first, n); });
+    team.team_barrier();
+  }
+
+  template <class TeamType>
+  KOKKOS_DEFAULTED_FUNCTION void team_put(const TeamType &team, const T *src,
+                                          const int pe, const size_t first,
+                                          const size_t n) const {
+    team.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(team), [&]() { put(src, pe, first, n); });
+  }
+
+  template <class TeamType>
+  KOKKOS_DEFAULTED_FUNCTION void team_gather(const TeamType &team, T *dst,
+                                             const int *pes,
+                                             const size_t *offsets,
+                                             const size_t n) const {
+    team.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { gather(dst, pes, offsets, n); });
+    team.team_barrier();
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  void thread_get(T *dst, const int pe, const size_t first,
+                  const size_t n) const {
+    get(dst, pe, first, n);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  void thread_put(const T *src, const int pe, const size_t first,
+                  const size_t n) const {
+    put(src, pe, first, n);
+  }
+
+  template <class SigHandle>
+  KOKKOS_DEFAULTED_FUNCTION void
+  thread_put_signal(const T *src, const int pe, const size_t first,
+                    const size_t n, const SigHandle &sig,
+                    const size_t sig_index, const uint64_t value,
+                    const int sig_op) const {
+    put_signal(src, pe, first, n, sig, sig_index, value, sig_op);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  void thread_signal(const int pe, const size_t i, const uint64_t value,
+                     const int sig_op) const {
+    signal(pe, i, value, sig_op);
+  }
+
+  KOKKOS_DEFAULTED_FUNCTION
+  uint64_t thread_wait_until(const size_t i, const int cmp,
+                             const uint64_t cmp_value) const {
+    return wait_until(i, cmp, cmp_value);
+  }
 };
 
 template <class Traits>
@@ -390,19 +930,33 @@ struct ViewDataHandle<
         typename Traits::specialize, Kokkos::Experimental::RemoteSpaceSpecializeTag>::value>::type> {
 
   typedef typename Traits::value_type value_type;
-  typedef SHMEMDataHandle<value_type> handle_type;
-  typedef SHMEMDataElement<value_type> return_type;
+  typedef SHMEMDataHandle<value_type, Traits> handle_type;
+  typedef SHMEMElement<value_type, Traits> return_type;
   typedef Kokkos::Impl::SharedAllocationTracker track_type;
 
   KOKKOS_DEFAULTED_FUNCTION
   static handle_type assign(value_type *arg_data_ptr,
-                            track_type const & /*arg_tracker*/) {
-    return handle_type(arg_data_ptr);
+                            track_type const &arg_tracker) {
+    auto *record =
+        arg_tracker.template get_record<Kokkos::Experimental::SHMEMSpace>();
+    if (!record)
+      return handle_type(arg_data_ptr);
+    handle_type handle(arg_data_ptr, -1, record->m_space.pe_map,
+                       record->m_space.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    handle.counters = record->counters;
+#endif
+    return handle;
   }
 
   KOKKOS_DEFAULTED_FUNCTION
-  static handle_type assign(handle_type const arg_data_ptr, size_t offset) {
-    return handle_type(arg_data_ptr + offset);
+  static handle_type assign(handle_type const arg_handle, size_t offset) {
+    handle_type handle(arg_handle.ptr + offset, arg_handle.my_pe,
+                       arg_handle.pe_map, arg_handle.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+    handle.counters = arg_handle.counters;
+#endif
+    return handle;
   }
 };
 
@@ -445,13 +999,23 @@ private:
 
   typedef typename ViewDataHandle<Traits>::handle_type handle_type;
 
+  enum : bool {
+    is_fixed_pe = Kokkos::Experimental::RemoteSpaces_MemoryTraits<
+        typename Traits::memory_traits>::is_fixed_pe
+  };
+
   handle_type m_handle;
   offset_type m_offset;
   int m_num_pes;
+  // First PE addressed by the view, non-zero for subviews
+  int m_pe_offset;
+  // Row distribution of Asymmetric and Monolithic allocations
+  Kokkos::Experimental::Impl::PEPartition m_partition;
 
   KOKKOS_DEFAULTED_FUNCTION
   ViewMapping(const handle_type &arg_handle, const offset_type &arg_offset)
-      : m_handle(arg_handle), m_offset(arg_offset) {}
+      : m_handle(arg_handle), m_offset(arg_offset), m_num_pes(0),
+        m_pe_offset(0) {}
 
 public:
   typedef void printable_label_typedef;
@@ -464,7 +1028,8 @@ public:
 
   template <typename iType>
   KOKKOS_DEFAULTED_FUNCTION constexpr size_t extent(const iType &r) const {
-    return m_offset.m_dim.extent(r);
+    return (r == 0 && m_partition.is_monolithic) ? m_partition.global_rows
+                                                 : m_offset.m_dim.extent(r);
   }
 
   KOKKOS_DEFAULTED_FUNCTION constexpr typename Traits::array_layout
@@ -473,7 +1038,9 @@ public:
   }
 
   KOKKOS_DEFAULTED_FUNCTION constexpr size_t dimension_0() const {
-    return m_num_pes;
+    return is_fixed_pe ? m_offset.dimension_0()
+                       : m_partition.is_monolithic ? m_partition.global_rows
+                                                   : m_num_pes;
   }
   KOKKOS_DEFAULTED_FUNCTION constexpr size_t dimension_1() const {
     return m_offset.dimension_1();
@@ -533,9 +1100,10 @@ public:
   //----------------------------------------
   // Range span
 
-  /** \brief  Span of the mapped range */
+  /** \brief  Span of the mapped range in the local segment */
   KOKKOS_DEFAULTED_FUNCTION constexpr size_t span() const {
-    return m_offset.span();
+    return m_partition.is_monolithic ? m_offset.span() * m_partition.local_rows
+                                     : m_offset.span();
   }
 
   /** \brief  Is the mapped range span contiguous */
@@ -551,60 +1119,79 @@ public:
     return m_handle.ptr;
   }
 
+  /** \brief  Query the remote data handle */
+  KOKKOS_DEFAULTED_FUNCTION const handle_type &handle() const {
+    return m_handle;
+  }
+
+  /** \brief  Query the first PE addressed by the view */
+  KOKKOS_DEFAULTED_FUNCTION int pe_offset() const { return m_pe_offset; }
+
+  /** \brief  Query the row distribution of the allocation */
+  KOKKOS_DEFAULTED_FUNCTION
+  const Kokkos::Experimental::Impl::PEPartition &partition() const {
+    return m_partition;
+  }
+
   //----------------------------------------
   // The View class performs all rank and bounds checking before
   // calling these element reference methods.
 
   KOKKOS_FORCEINLINE_FUNCTION
-  reference_type reference() const { return m_handle[0]; }
+  reference_type reference() const { return m_handle(m_pe_offset, 0); }
 
-  template <typename I0>
+  /* Element i of the segment selected by the leading index i0. For
+   * Monolithic views i0 is a global row, otherwise a PE relative to
+   * m_pe_offset. */
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  !std::is_same<typename Traits::array_layout,
-                                                Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+  reference_type pe_reference(const size_t i0, const size_t i) const {
+    if (!m_partition.is_monolithic)
+      return m_handle(m_pe_offset + i0, i);
+    const int pe = m_partition.owner(i0);
+    return m_handle(pe, (i0 - m_partition.offsets[pe]) * m_offset.span() + i);
   }
 
+  // Views with a fixed PE address the segment of PE m_pe_offset only,
+  // otherwise the leading index selects the segment, see pe_reference.
   template <typename I0>
   KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  std::is_same<typename Traits::array_layout,
-                                               Kokkos::LayoutStride>::value,
-                              reference_type>::type
+      typename std::enable_if<std::is_integral<I0>::value, reference_type>::type
       reference(const I0 &i0) const {
-    return m_handle(i0, 0);
+    return is_fixed_pe ? m_handle(m_pe_offset, m_offset(i0))
+                       : pe_reference(i0, 0);
   }
 
   template <typename I0, typename I1>
-  KOKKOS_FORCEINLINE_FUNCTION const reference_type
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1) const {
-    const reference_type element = m_handle(i0, m_offset(0, i1));
-    return element;
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1))
+               : pe_reference(i0, m_offset(0, i1));
   }
 
   template <typename I0, typename I1, typename I2>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2) const {
-    return m_handle(i0, m_offset(0, i1, i2));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2))
+               : pe_reference(i0, m_offset(0, i1, i2));
   }
 
   template <typename I0, typename I1, typename I2, typename I3>
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3))
+               : pe_reference(i0, m_offset(0, i1, i2, i3));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0 &i0,
-                                                       const I1 &i1,
-                                                       const I2 &i2,
-                                                       const I3 &i3,
-                                                       const I4 &i4) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4));
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
+            const I4 &i4) const {
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -612,7 +1199,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -620,7 +1209,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
   }
 
   template <typename I0, typename I1, typename I2, typename I3, typename I4,
@@ -628,7 +1219,9 @@ public:
   KOKKOS_FORCEINLINE_FUNCTION reference_type
   reference(const I0 &i0, const I1 &i1, const I2 &i2, const I3 &i3,
             const I4 &i4, const I5 &i5, const I6 &i6, const I7 &i7) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
+    return is_fixed_pe
+               ? m_handle(m_pe_offset, m_offset(i0, i1, i2, i3, i4, i5, i6, i7))
+               : pe_reference(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
   }
 
   //----------------------------------------
@@ -640,8 +1233,7 @@ private:
 public:
   /** \brief  Span, in bytes, of the referenced memory */
   KOKKOS_DEFAULTED_FUNCTION constexpr size_t memory_span() const {
-    return (m_offset.span() * sizeof(typename Traits::value_type) +
-            MemorySpanMask) &
+    return (span() * sizeof(typename Traits::value_type) + MemorySpanMask) &
            ~size_t(MemorySpanMask);
   }
 
@@ -656,24 +1248,31 @@ public:
   }
 
   KOKKOS_DEFAULTED_FUNCTION ~ViewMapping() {}
-  KOKKOS_DEFAULTED_FUNCTION ViewMapping() : m_handle(), m_offset(), m_num_pes(0) {}
+  KOKKOS_DEFAULTED_FUNCTION ViewMapping()
+      : m_handle(), m_offset(), m_num_pes(0), m_pe_offset(0) {}
   KOKKOS_DEFAULTED_FUNCTION ViewMapping(const ViewMapping &rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_DEFAULTED_FUNCTION ViewMapping &operator=(const ViewMapping &rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
   KOKKOS_DEFAULTED_FUNCTION ViewMapping(ViewMapping &&rhs)
       : m_handle(rhs.m_handle), m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
+        m_num_pes(rhs.m_num_pes), m_pe_offset(rhs.m_pe_offset),
+        m_partition(rhs.m_partition) {}
   KOKKOS_DEFAULTED_FUNCTION ViewMapping &operator=(ViewMapping &&rhs) {
     m_handle = rhs.m_handle;
     m_offset = rhs.m_offset;
     m_num_pes = rhs.m_num_pes;
+    m_pe_offset = rhs.m_pe_offset;
+    m_partition = rhs.m_partition;
     return *this;
   }
 
@@ -698,6 +1297,7 @@ public:
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
     m_num_pes = shmem_n_pes();
+    m_pe_offset = 0;
   }
 
   /**\brief  Assign data */
@@ -722,6 +1322,9 @@ public:
     typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
         record_type;
 
+    static_assert(!is_fixed_pe,
+                  "Views with a fixed PE can only be created as subviews");
+
     // Query the mapping for byte-size of allocation.
     // If padding is allowed then pass in sizeof value type
     // for padding computation.
@@ -734,22 +1337,57 @@ public:
       layout.dimension[i] = arg_layout.dimension[i];
     layout.dimension[0] = 1;
     m_offset = offset_type(padding(), layout);
-    m_num_pes = shmem_n_pes();
+    const memory_space &space =
+        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
+            .value;
+    m_num_pes = space.impl_num_pes();
+    m_pe_offset = 0;
+
+    const int allocation_mode = space.allocation_mode;
+    size_t *pe_offsets = NULL;
+    if (allocation_mode == Kokkos::Experimental::Asymmetric ||
+        allocation_mode == Kokkos::Experimental::Monolithic) {
+      const bool is_monolithic =
+          allocation_mode == Kokkos::Experimental::Monolithic;
+      // Offsets within a segment only agree across PEs of different extents
+      // if the varying extent is the slowest running one
+      if (!is_monolithic && Traits::rank > 2 &&
+          !std::is_same<typename Traits::array_layout,
+                        Kokkos::LayoutRight>::value)
+        Kokkos::abort("Asymmetric views of rank > 2 require LayoutRight");
+      const size_t local_rows =
+          is_monolithic ? arg_layout.dimension[0]
+                        : (Traits::rank > 1 ? arg_layout.dimension[1] : 1);
+      // The offsets are gathered over MPI_COMM_WORLD, whose ranks are the
+      // PEs of the world team. Teams of a subset of the PEs only allocate
+      // Symmetric views from a RemoteArena, abort before the collective.
+      if (m_num_pes != shmem_n_pes())
+        Kokkos::abort("SHMEMSpace: Asymmetric and Monolithic views require a "
+                      "team of all PEs.");
+      pe_offsets = Kokkos::Experimental::Impl::allgather_pe_offsets(local_rows);
+      m_partition = Kokkos::Experimental::Impl::PEPartition(
+          pe_offsets, pe_offsets, m_num_pes, is_monolithic, local_rows,
+          pe_offsets[m_num_pes]);
+    }
 
     const size_t alloc_size = memory_span();
 
     // Create shared memory tracking record with allocate memory from the memory
     // space
     record_type *const record = record_type::allocate(
-        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const &)arg_prop)
-            .value,
+        space,
         ((Kokkos::Impl::ViewCtorProp<void, std::string> const &)arg_prop).value,
         alloc_size);
+    record->pe_offsets = pe_offsets;
 
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     if (alloc_size) {
 #endif
-      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()));
+      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()),
+                             space.impl_my_pe(), space.pe_map, space.scope);
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+      m_handle.counters = record->counters;
+#endif
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
     }
 #endif
@@ -773,6 +1411,137 @@ public:
   }
 };
 
+/* Team-based reductions of OpenSHMEM 1.5 */
+#define KOKKOS_SHMEM_REDUCE(type, name)                                        \
+  static inline void shmem_type_reduce(shmem_team_t team, type *dst,          \
+                                       const type *src, const size_t n,        \
+                                       const int op) {                         \
+    switch (op) {                                                              \
+    case Kokkos::Experimental::OpSum:                                          \
+      shmem_##name##_sum_reduce(team, dst, src, n);                            \
+      break;                                                                   \
+    case Kokkos::Experimental::OpProd:                                         \
+      shmem_##name##_prod_reduce(team, dst, src, n);                           \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMin:                                          \
+      shmem_##name##_min_reduce(team, dst, src, n);                            \
+      break;                                                                   \
+    case Kokkos::Experimental::OpMax:                                          \
+      shmem_##name##_max_reduce(team, dst, src, n);                            \
+      break;                                                                   \
+    default:                                                                   \
+      Kokkos::abort("SHMEMSpace: unsupported reduction operation.");           \
+    }                                                                          \
+  }
+
+KOKKOS_SHMEM_REDUCE(short, short)
+KOKKOS_SHMEM_REDUCE(unsigned short, ushort)
+KOKKOS_SHMEM_REDUCE(int, int)
+KOKKOS_SHMEM_REDUCE(unsigned int, uint)
+KOKKOS_SHMEM_REDUCE(long, long)
+KOKKOS_SHMEM_REDUCE(unsigned long, ulong)
+KOKKOS_SHMEM_REDUCE(long long, longlong)
+KOKKOS_SHMEM_REDUCE(unsigned long long, ulonglong)
+KOKKOS_SHMEM_REDUCE(float, float)
+KOKKOS_SHMEM_REDUCE(double, double)
+
+#undef KOKKOS_SHMEM_REDUCE
+
+} // namespace Impl
+
+namespace Experimental {
+namespace Impl {
+
+/* Collectives over the local segments of symmetric allocations. Source
+ * and destination must both be symmetric. SHMEM has no rooted reduction,
+ * reduce leaves the result on every PE. */
+template <> struct RemoteCollectives<Kokkos::Experimental::SHMEMSpace> {
+  typedef Kokkos::Experimental::SHMEMSpace::scope_type scope_type;
+
+  template <class T>
+  static void allreduce(scope_type scope, T *dst, const T *src,
+                        const size_t n, const int op) {
+    Kokkos::Impl::shmem_type_reduce(scope, dst, src, n, op);
+  }
+
+  template <class T>
+  static void reduce(scope_type scope, T *dst, const T *src, const size_t n,
+                     const int op, const int) {
+    allreduce(scope, dst, src, n, op);
+  }
+
+  template <class T>
+  static void broadcast(scope_type scope, T *dst, const T *src,
+                        const size_t n, const int root) {
+    shmem_broadcastmem(scope, dst, src, n * sizeof(T), root);
+  }
+
+  template <class T>
+  static void fcollect(scope_type scope, T *dst, const T *src,
+                       const size_t n) {
+    shmem_fcollectmem(scope, dst, src, n * sizeof(T));
+  }
+
+  template <class ExecSpace, class T>
+  static void allreduce(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int op) {
+    exec.fence();
+    allreduce(scope, dst, src, n, op);
+  }
+
+  template <class ExecSpace, class T>
+  static void reduce(const ExecSpace &exec, scope_type scope, T *dst,
+                     const T *src, const size_t n, const int op,
+                     const int root) {
+    exec.fence();
+    reduce(scope, dst, src, n, op, root);
+  }
+
+  template <class ExecSpace, class T>
+  static void broadcast(const ExecSpace &exec, scope_type scope, T *dst,
+                        const T *src, const size_t n, const int root) {
+    exec.fence();
+    broadcast(scope, dst, src, n, root);
+  }
+
+  template <class ExecSpace, class T>
+  static void fcollect(const ExecSpace &exec, scope_type scope, T *dst,
+                       const T *src, const size_t n) {
+    exec.fence();
+    fcollect(scope, dst, src, n);
+  }
+
+  /* Called by one team per PE. A single thread of the team issues the
+   * collective. */
+  template <class TeamType, class T>
+  KOKKOS_DEFAULTED_FUNCTION static void
+  team_allreduce(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int op) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { allreduce(scope, dst, src, n, op); });
+    team.team_barrier();
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_DEFAULTED_FUNCTION static void
+  team_broadcast(const TeamType &team, scope_type scope, T *dst, const T *src,
+                 const size_t n, const int root) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { broadcast(scope, dst, src, n, root); });
+    team.team_barrier();
+  }
+
+  template <class TeamType, class T>
+  KOKKOS_DEFAULTED_FUNCTION static void
+  team_fcollect(const TeamType &team, scope_type scope, T *dst, const T *src,
+                const size_t n) {
+    Kokkos::single(Kokkos::PerTeam(team),
+                   [&]() { fcollect(scope, dst, src, n); });
+    team.team_barrier();
+  }
+};
+
 } // namespace Impl
+} // namespace Experimental
 
 } // namespace Kokkos
@@ -0,0 +1,158 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef TEST_AGGREGATOR_HPP_
+#define TEST_AGGREGATOR_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_aggregator_sum(int size, int updates, size_t capacity)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using Aggregator_t = Kokkos::Experimental::RemoteAggregator<
+      RemoteView_t, Kokkos::Experimental::OpSum>;
+
+  RemoteView_t v_R("RemoteView", num_ranks, size);
+  Aggregator_t agg(v_R, capacity);
+
+  RemoteSpace_t().fence();
+
+  // Every rank adds 1 to element j % size of every PE, j < updates.
+  // Updates rejected by a full pool are issued again after a flush.
+  Kokkos::View<int**> v_done("Done", updates, num_ranks);
+  int remaining;
+  do {
+    Kokkos::parallel_reduce(
+      "Update", updates, KOKKOS_LAMBDA(const int j, int &rem) {
+        for (int pe = 0; pe < num_ranks; pe++) {
+          if (v_done(j, pe)) continue;
+          if (agg.update(pe, j % size, (Data_t) 1))
+            v_done(j, pe) = 1;
+          else
+            rem++;
+        }
+      }, remaining);
+    agg.flush();
+    MPI_Allreduce(MPI_IN_PLACE, &remaining, 1, MPI_INT, MPI_MAX,
+                  MPI_COMM_WORLD);
+  } while (remaining > 0);
+
+  agg.fence();
+
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Read", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(my_rank, i); });
+  Kokkos::fence();
+  auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+
+  for (int i = 0; i < size; i++) {
+    const int count = updates / size + (i < updates % size ? 1 : 0);
+    ASSERT_EQ(h_D(i), (Data_t) (count * num_ranks));
+  }
+
+  RemoteSpace_t().fence();
+}
+
+template <class Data_t>
+void test_aggregator_max(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using Aggregator_t = Kokkos::Experimental::RemoteAggregator<
+      RemoteView_t, Kokkos::Experimental::OpMax>;
+
+  RemoteView_t v_R("RemoteView", num_ranks, size);
+  Aggregator_t agg(v_R, 2 * size * num_ranks);
+
+  RemoteSpace_t().fence();
+
+  // All ranks update the same elements
+  int rejected = 0;
+  Kokkos::parallel_reduce(
+    "Update", size, KOKKOS_LAMBDA(const int i, int &rej) {
+      for (int pe = 0; pe < num_ranks; pe++) {
+        if (!agg.update(pe, i, (Data_t) i)) rej++;
+        if (!agg.update(pe, i, (Data_t) (i + pe))) rej++;
+      }
+    }, rejected);
+  ASSERT_EQ(rejected, 0);
+
+  agg.fence();
+
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Read", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(my_rank, i); });
+  Kokkos::fence();
+  auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_D(i), (Data_t) (i + my_rank));
+
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_aggregator) {
+  // Sums from all ranks to the same elements require atomic updates
+  test_aggregator_sum<int64_t>(1000, 12345, 1 << 16);
+  // Pools smaller than the number of updates take several flushes
+  test_aggregator_sum<int64_t>(1000, 12345, 100);
+  test_aggregator_sum<double>(89, 1000, 64);
+  test_aggregator_max<int64_t>(1000);
+}
+
+#endif /* TEST_AGGREGATOR_HPP_ */
@@ -49,6 +49,7 @@
 #include <mpi.h>
 #include <Kokkos_Core.hpp>
 #include <Kokkos_RemoteSpaces.hpp>
+#include <vector>
 
 using RemoteMemSpace = Kokkos::Experimental::DefaultRemoteMemorySpace;
 
@@ -92,4 +93,139 @@ TEST(TEST_CATEGORY, test_allocate_symmetric_remote_view_by_rank) {
   test_allocate_symmetric_remote_view_by_rank<double ****, RemoteMemSpace>(9, 10, 7);
 }
 
+template <class DataType, class RemoteSpace>
+void test_allocate_asymmetric_remote_view(int n) {
+
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  using RemoteViewType = Kokkos::View<DataType **, RemoteSpace>;
+  using HostViewType = Kokkos::View<DataType **, Kokkos::HostSpace>;
+
+  // Every rank owns a different number of entries
+  const int local_n = n * (myRank + 1);
+  const int nextRank = (myRank + 1) % numRanks;
+  const int next_n = n * (nextRank + 1);
+
+  RemoteViewType view =
+      Kokkos::Experimental::allocate_asymmetric_remote_view<RemoteViewType>(
+          "MyRemoteView", numRanks, local_n);
+  ASSERT_EQ(view.extent(1), local_n);
+  auto range = Kokkos::Experimental::get_range(view, nextRank);
+  ASSERT_EQ(range.second - range.first, size_t(next_n));
+
+  Kokkos::parallel_for(
+      "Init", local_n, KOKKOS_LAMBDA(const int i) {
+        view(myRank, i) = (DataType)myRank * 1000 + i;
+      });
+  RemoteSpace().fence();
+
+  HostViewType v_H("HostView", 1, next_n);
+  Kokkos::Experimental::deep_copy(v_H, view, nextRank,
+                                  Kokkos::pair<size_t, size_t>(0, next_n));
+  for (int i = 0; i < next_n; i++)
+    ASSERT_EQ(v_H(0, i), (DataType)nextRank * 1000 + i);
+  RemoteSpace().fence();
+}
+
+template <class DataType, class RemoteSpace>
+void test_allocate_monolithic_remote_view(int n) {
+
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  using RemoteViewType = Kokkos::View<DataType *, RemoteSpace>;
+
+  // Uneven blocks of a global index space
+  const size_t local_rows = n * (myRank + 1);
+  const size_t global_rows = n * numRanks * (numRanks + 1) / 2;
+
+  RemoteViewType view =
+      Kokkos::Experimental::allocate_monolithic_remote_view<RemoteViewType>(
+          "MyRemoteView", local_rows);
+  ASSERT_EQ(view.extent(0), global_rows);
+
+  auto range = Kokkos::Experimental::get_local_range(view);
+  ASSERT_EQ(range.first, size_t(n * myRank * (myRank + 1) / 2));
+  ASSERT_EQ(range.second - range.first, local_rows);
+
+  const size_t first = range.first;
+  Kokkos::parallel_for(
+      "Init", local_rows, KOKKOS_LAMBDA(const int i) {
+        view(first + i) = (DataType)(first + i);
+      });
+  RemoteSpace().fence();
+
+  // Every rank reads the whole global index space
+  DataType sum = 0;
+  Kokkos::parallel_reduce(
+      "Read", global_rows,
+      KOKKOS_LAMBDA(const int i, DataType &lsum) { lsum += view(i); }, sum);
+  ASSERT_EQ(sum, (DataType)(global_rows * (global_rows - 1) / 2));
+  RemoteSpace().fence();
+}
+
+template <class DataType, class RemoteSpace>
+void test_allocate_many_remote_views(int num_views, int n) {
+  int myRank;
+  int numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  using RemoteViewType = Kokkos::View<DataType **, RemoteSpace>;
+
+  std::vector<RemoteViewType> views;
+  for (int k = 0; k < num_views; k++)
+    views.push_back(RemoteViewType("MyRemoteView", numRanks, n));
+  RemoteSpace().fence();
+
+#if defined(KOKKOS_ENABLE_MPISPACE) && \
+    defined(KOKKOS_ENABLE_MPISPACE_DYNAMIC_WINDOW)
+  // All allocations share the dynamic window
+  for (int k = 1; k < num_views; k++)
+    ASSERT_EQ(views[k].impl_map().handle().win,
+              views[0].impl_map().handle().win);
+#endif
+
+  const int next = (myRank + 1) % numRanks;
+  for (int k = 0; k < num_views; k++) {
+    RemoteViewType v = views[k];
+    Kokkos::parallel_for(
+        "Put", n, KOKKOS_LAMBDA(const int i) {
+          v(next, i) = (DataType)(k + myRank * i);
+        });
+  }
+  RemoteSpace().fence();
+
+  const int prev = (myRank + numRanks - 1) % numRanks;
+  for (int k = 0; k < num_views; k++) {
+    RemoteViewType v = views[k];
+    int errors = 0;
+    Kokkos::parallel_reduce(
+        "Check", n,
+        KOKKOS_LAMBDA(const int i, int &lerrors) {
+          lerrors += (v(myRank, i) == (DataType)(k + prev * i)) ? 0 : 1;
+        },
+        errors);
+    ASSERT_EQ(errors, 0);
+  }
+  RemoteSpace().fence();
+}
+
+TEST(TEST_CATEGORY, test_allocate_many_remote_views) {
+  test_allocate_many_remote_views<int, RemoteMemSpace>(300, 1);
+  test_allocate_many_remote_views<double, RemoteMemSpace>(100, 1000);
+}
+
+TEST(TEST_CATEGORY, test_allocate_asymmetric_remote_view) {
+  test_allocate_asymmetric_remote_view<double, RemoteMemSpace>(10);
+  test_allocate_asymmetric_remote_view<int64_t, RemoteMemSpace>(113);
+}
+
+TEST(TEST_CATEGORY, test_allocate_monolithic_remote_view) {
+  test_allocate_monolithic_remote_view<double, RemoteMemSpace>(10);
+  test_allocate_monolithic_remote_view<int64_t, RemoteMemSpace>(113);
+}
+
 #endif /* TEST_ALLOCATION_HPP_ */
@@ -0,0 +1,147 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_ARENA_HPP_
+#define TEST_ARENA_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_arena_steps(int size, int steps)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteArena<RemoteSpace_t> arena(1 << 20);
+  const int next = (my_rank + 1) % num_ranks;
+  const int prev = (my_rank + num_ranks - 1) % num_ranks;
+
+  Data_t *first_ptr = NULL;
+  for (int step = 0; step < steps; step++) {
+    RemoteView_t v_R(Kokkos::view_alloc("Tmp", arena.space()), num_ranks,
+                     size);
+    RemoteView_t w_R(Kokkos::view_alloc("Tmp2", arena.space()), num_ranks,
+                     size);
+    ASSERT_GT(arena.used(), size_t(0));
+
+    // Freed blocks are reused by the next step
+    if (step == 0)
+      first_ptr = v_R.data();
+    else
+      ASSERT_EQ(v_R.data(), first_ptr);
+
+    RemoteSpace_t().fence();
+    Kokkos::parallel_for(
+      "Put", size, KOKKOS_LAMBDA(const int i) {
+        v_R(next, i) = (Data_t) (i + step * my_rank);
+        w_R(next, i) = (Data_t) my_rank;
+      });
+    RemoteSpace_t().fence();
+
+    Kokkos::View<Data_t*> v_D("Local", size);
+    Kokkos::parallel_for(
+      "Get", size, KOKKOS_LAMBDA(const int i) {
+        v_D(i) = v_R(my_rank, i) + w_R(my_rank, i);
+      });
+    Kokkos::fence();
+    auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+    for (int i = 0; i < size; i++)
+      ASSERT_EQ(h_D(i), (Data_t) (i + step * prev + prev));
+
+    RemoteSpace_t().fence();
+  }
+  ASSERT_EQ(arena.used(), size_t(0));
+}
+
+void test_arena_lifetime()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<int**, RemoteSpace_t>;
+  RemoteView_t v_R;
+  {
+    RemoteArena<RemoteSpace_t> arena(4096);
+    v_R = RemoteView_t(Kokkos::view_alloc("Tmp", arena.space()), num_ranks,
+                       64);
+    // Exhausting the arena fails on all ranks alike
+    ASSERT_THROW(RemoteView_t(Kokkos::view_alloc("Big", arena.space()),
+                              num_ranks, 4096),
+                 std::runtime_error);
+  }
+
+  // The view keeps the reservation alive
+  const int next = (my_rank + 1) % num_ranks;
+  RemoteSpace_t().fence();
+  Kokkos::parallel_for(
+    "Put", 64, KOKKOS_LAMBDA(const int i) { v_R(next, i) = i; });
+  RemoteSpace_t().fence();
+  Kokkos::View<int*> v_D("Local", 64);
+  Kokkos::parallel_for(
+    "Get", 64, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(my_rank, i); });
+  Kokkos::fence();
+  auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+  for (int i = 0; i < 64; i++)
+    ASSERT_EQ(h_D(i), i);
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_arena) {
+  test_arena_steps<int>(1, 10);
+  test_arena_steps<int64_t>(1000, 10);
+  test_arena_steps<double>(4099, 3);
+  test_arena_lifetime();
+}
+
+#endif /* TEST_ARENA_HPP_ */
@@ -0,0 +1,223 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef TEST_ATOMICS_HPP_
+#define TEST_ATOMICS_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class View_t>
+typename View_t::non_const_value_type read_element(const View_t &v, int pe,
+                                                   int i)
+{
+  using Data_t = typename View_t::non_const_value_type;
+  Kokkos::View<Data_t*> result("Result", 1);
+  Kokkos::parallel_for(
+    "Read", 1, KOKKOS_LAMBDA(const int) { result(0) = v(pe, i); });
+  auto h_result =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), result);
+  return h_result(0);
+}
+
+template <class Data_t>
+void test_atomic_fetch_add(int updates)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R("RemoteView", num_ranks, 1);
+  RemoteSpace_t().fence();
+
+  // Every rank draws tickets from a counter owned by rank 0
+  Data_t sum = 0;
+  Kokkos::parallel_reduce(
+    "Draw", updates, KOKKOS_LAMBDA(const int, Data_t &lsum) {
+      lsum += atomic_fetch_add(v_R(0, 0), Data_t(1));
+    }, sum);
+  RemoteSpace_t().fence();
+
+  // Tickets are unique iff their sum over all ranks is 0 + 1 + ... + n-1
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  const Data_t total = Data_t(updates) * num_ranks;
+  ASSERT_EQ(sum, total * (total - 1) / 2);
+  ASSERT_EQ(read_element(v_R, 0, 0), total);
+
+  RemoteSpace_t().fence();
+}
+
+template <class Data_t>
+void test_atomic_compare_exchange()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R("RemoteView", num_ranks, 2);
+  RemoteSpace_t().fence();
+
+  // Exactly one rank claims the lock word of rank 0
+  int won = 0;
+  Kokkos::parallel_reduce(
+    "Claim", 1, KOKKOS_LAMBDA(const int, int &lwon) {
+      const Data_t old =
+          atomic_compare_exchange(v_R(0, 1), Data_t(0), Data_t(my_rank + 1));
+      lwon += (old == Data_t(0)) ? 1 : 0;
+    }, won);
+  RemoteSpace_t().fence();
+
+  int winners = 0;
+  MPI_Allreduce(&won, &winners, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  ASSERT_EQ(winners, 1);
+
+  const Data_t owner = read_element(v_R, 0, 1);
+  ASSERT_GE(owner, Data_t(1));
+  ASSERT_LE(owner, Data_t(num_ranks));
+  if (won) ASSERT_EQ(owner, Data_t(my_rank + 1));
+
+  // Exchange with the right neighbor returns the initial value
+  const int right = (my_rank + 1) % num_ranks;
+  Data_t old = 1;
+  Kokkos::parallel_reduce(
+    "Exchange", 1, KOKKOS_LAMBDA(const int, Data_t &lold) {
+      lold = atomic_exchange(v_R(right, 0), Data_t(my_rank + 1));
+    }, old);
+  RemoteSpace_t().fence();
+
+  const int left = (my_rank + num_ranks - 1) % num_ranks;
+  ASSERT_EQ(old, Data_t(0));
+  ASSERT_EQ(read_element(v_R, my_rank, 0), Data_t(left + 1));
+
+  RemoteSpace_t().fence();
+}
+
+template <class Data_t>
+void test_atomic_bitwise()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R("RemoteView", num_ranks, 2);
+  RemoteSpace_t().fence();
+
+  const int bits = 8 * sizeof(Data_t);
+  Data_t all = 0;
+  for (int r = 0; r < num_ranks; r++) all |= Data_t(1) << (r % bits);
+  const Data_t mine = Data_t(1) << (my_rank % bits);
+
+  // Each rank sets its bit in element 0 and toggles it twice in element 1
+  Kokkos::parallel_for(
+    "Set", 1, KOKKOS_LAMBDA(const int) {
+      atomic_fetch_or(v_R(0, 0), mine);
+      atomic_fetch_xor(v_R(0, 1), mine);
+      atomic_fetch_xor(v_R(0, 1), mine);
+    });
+  RemoteSpace_t().fence();
+
+  ASSERT_EQ(read_element(v_R, 0, 0), all);
+  ASSERT_EQ(read_element(v_R, 0, 1), Data_t(0));
+  RemoteSpace_t().fence();
+
+  // Clearing all bits again leaves zero
+  Kokkos::parallel_for(
+    "Clear", 1, KOKKOS_LAMBDA(const int) {
+      atomic_fetch_and(v_R(0, 0), Data_t(~mine));
+    });
+  RemoteSpace_t().fence();
+
+  ASSERT_EQ(read_element(v_R, 0, 0), Data_t(0));
+  RemoteSpace_t().fence();
+}
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+template <class Data_t>
+void test_atomic_host_nvshmem()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R("RemoteView", num_ranks, 1);
+  RemoteSpace_t().fence();
+
+  // Atomics on host element references update the segment of their PE
+  auto map = v_R.impl_map();
+  const Data_t old = atomic_fetch_add(map.reference(0, 0), Data_t(1));
+  ASSERT_LT(old, Data_t(num_ranks));
+  RemoteSpace_t().fence();
+
+  ASSERT_EQ(read_element(v_R, 0, 0), Data_t(num_ranks));
+  RemoteSpace_t().fence();
+}
+#endif
+
+TEST(TEST_CATEGORY, test_atomics) {
+  test_atomic_fetch_add<int64_t>(1000);
+  test_atomic_compare_exchange<int64_t>();
+  test_atomic_compare_exchange<unsigned int>();
+  test_atomic_bitwise<uint64_t>();
+  test_atomic_bitwise<unsigned int>();
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+  test_atomic_host_nvshmem<int64_t>();
+#endif
+}
+
+#endif /* TEST_ATOMICS_HPP_ */
@@ -0,0 +1,104 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef TEST_CACHED_VIEW_HPP_
+#define TEST_CACHED_VIEW_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_cached_view(int size, size_t cache_bytes, size_t line_bytes)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using CachedView_t = Kokkos::Experimental::CachedView<RemoteView_t>;
+
+  RemoteView_t v_R("RemoteView", num_ranks, size);
+  CachedView_t v_C(v_R, cache_bytes, line_bytes);
+
+  for (int round = 0; round < 2; round++) {
+    Kokkos::parallel_for(
+      "Init", size, KOKKOS_LAMBDA(const int i) {
+        v_R(my_rank, i) = (Data_t) (round * num_ranks + my_rank) * size + i;
+      });
+
+    // Completes the writes and drops lines cached in the previous round
+    v_C.fence();
+
+    // Every element of every segment is read repeatedly
+    Data_t sum = 0;
+    Kokkos::parallel_reduce(
+      "Read", size, KOKKOS_LAMBDA(const int i, Data_t &lsum) {
+        for (int rep = 0; rep < 3; rep++)
+          for (int pe = 0; pe < num_ranks; pe++)
+            lsum += v_C(pe, (i * 7 + rep) % size);
+    }, sum);
+
+    Data_t ref = 0;
+    for (int i = 0; i < size; i++)
+      for (int rep = 0; rep < 3; rep++)
+        for (int pe = 0; pe < num_ranks; pe++)
+          ref += (Data_t) (round * num_ranks + pe) * size + (i * 7 + rep) % size;
+    ASSERT_EQ(sum, ref);
+
+    RemoteSpace_t().fence();
+  }
+}
+
+TEST(TEST_CATEGORY, test_cached_view) {
+  test_cached_view<int64_t>(12345, 1 << 20, 4096);
+  // A cache smaller than the remote data forces line replacement
+  test_cached_view<int64_t>(12345, 1 << 12, 256);
+  test_cached_view<double>(89, 1 << 10, 64);
+}
+
+#endif /* TEST_CACHED_VIEW_HPP_ */
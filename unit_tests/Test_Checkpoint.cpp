@@ -0,0 +1,114 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_CHECKPOINT_HPP_
+#define TEST_CHECKPOINT_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <cstdio>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_checkpoint(int size)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  const std::string path = "Test_Checkpoint.krs";
+
+  // Element i of the segment of PE r is element r * size + i of the file
+  ViewRemote_t v_W = ViewRemote_t("WriteView", num_ranks, size);
+  Kokkos::parallel_for(
+    "Init", size, KOKKOS_LAMBDA(const int i) {
+      v_W(my_rank, i) = (Data_t) my_rank * size + i;
+    });
+  write_remote_view(v_W, path);
+
+  ViewRemote_t v_R = ViewRemote_t("ReadView", num_ranks, size);
+  read_remote_view(v_R, path);
+
+  int errors = 0;
+  Kokkos::parallel_reduce(
+    "Check", size, KOKKOS_LAMBDA(const int i, int &err) {
+      if (v_R(my_rank, i) != (Data_t) my_rank * size + i) err++;
+    }, errors);
+  ASSERT_EQ(errors, 0);
+
+  // Restart with a different distribution of the same elements: the
+  // last PE takes one more row from each of the others
+  const int local = my_rank == num_ranks - 1 ? size + num_ranks - 1
+                                             : size - 1;
+  const int first = my_rank * (size - 1);
+  ViewRemote_t v_A = allocate_asymmetric_remote_view<ViewRemote_t>(
+      "AsymmetricView", num_ranks, local);
+  read_remote_view(v_A, path);
+
+  errors = 0;
+  Kokkos::parallel_reduce(
+    "CheckRedistributed", local, KOKKOS_LAMBDA(const int i, int &err) {
+      if (v_A(my_rank, i) != (Data_t) first + i) err++;
+    }, errors);
+  ASSERT_EQ(errors, 0);
+
+  // Element counts must match
+  ViewRemote_t v_S = ViewRemote_t("SmallView", num_ranks, size - 1);
+  ASSERT_THROW(read_remote_view(v_S, path), std::runtime_error);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (my_rank == 0)
+    std::remove(path.c_str());
+}
+
+TEST(TEST_CATEGORY, test_checkpoint) {
+  test_checkpoint<int>(1234);
+  test_checkpoint<double>(77);
+}
+
+#endif /* TEST_CHECKPOINT_HPP_ */
@@ -0,0 +1,181 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_COLLECTIVES_HPP_
+#define TEST_COLLECTIVES_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class View_t>
+Kokkos::View<typename View_t::non_const_value_type *, Kokkos::HostSpace>
+read_segment(const View_t &v, int pe, int size)
+{
+  using Data_t = typename View_t::non_const_value_type;
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Read", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v(pe, i); });
+  Kokkos::fence();
+  return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+}
+
+template <class Data_t>
+void test_allreduce(int size)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t src("Source", num_ranks, size);
+  RemoteView_t dst("Destination", num_ranks, size);
+
+  Kokkos::parallel_for(
+    "Init", size, KOKKOS_LAMBDA(const int i) {
+      src(my_rank, i) = (Data_t) (i + my_rank);
+    });
+  RemoteSpace_t().fence();
+
+  allreduce(dst, src, OpSum);
+  auto h_sum = read_segment(dst, my_rank, size);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_sum(i),
+              (Data_t) (i * num_ranks + num_ranks * (num_ranks - 1) / 2));
+
+  allreduce(Kokkos::DefaultExecutionSpace(), dst, src, OpMax);
+  Kokkos::fence();
+  auto h_max = read_segment(dst, my_rank, size);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_max(i), (Data_t) (i + num_ranks - 1));
+
+  // In place
+  allreduce(src, src, OpMin);
+  auto h_min = read_segment(src, my_rank, size);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_min(i), (Data_t) i);
+
+  RemoteSpace_t().fence();
+}
+
+template <class Data_t>
+void test_broadcast_fcollect(int size)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t src("Source", num_ranks, size);
+  RemoteView_t dst("Destination", num_ranks, size);
+  RemoteView_t all("Collected", num_ranks, size * num_ranks);
+
+  Kokkos::parallel_for(
+    "Init", size, KOKKOS_LAMBDA(const int i) {
+      src(my_rank, i) = (Data_t) (i + size * my_rank);
+    });
+  RemoteSpace_t().fence();
+
+  const int root = num_ranks - 1;
+  broadcast(dst, src, root);
+  auto h_bcast = read_segment(dst, my_rank, size);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_bcast(i), (Data_t) (i + size * root));
+
+  fcollect(all, src);
+  auto h_all = read_segment(all, my_rank, size * num_ranks);
+  for (int i = 0; i < size * num_ranks; i++)
+    ASSERT_EQ(h_all(i), (Data_t) i);
+
+  RemoteSpace_t().fence();
+}
+
+template <class Data_t>
+void test_team_allreduce(int size)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using TeamPolicy_t = Kokkos::TeamPolicy<>;
+  RemoteView_t v("Values", num_ranks, size);
+  RemoteSpace_t().fence();
+
+  // Fill, reduce and scale within one kernel
+  Kokkos::parallel_for(
+    "TeamAllreduce", TeamPolicy_t(1, Kokkos::AUTO),
+    KOKKOS_LAMBDA(const TeamPolicy_t::member_type &team) {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, size),
+                           [&](const int i) { v(my_rank, i) = (Data_t) 1; });
+      team_allreduce(team, v, v, OpSum);
+      team.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, size),
+                           [&](const int i) { v(my_rank, i) *= (Data_t) 2; });
+    });
+  RemoteSpace_t().fence();
+
+  auto h_v = read_segment(v, my_rank, size);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_v(i), (Data_t) (2 * num_ranks));
+}
+
+TEST(TEST_CATEGORY, test_collectives) {
+  test_allreduce<int>(1);
+  test_allreduce<int64_t>(1000);
+  test_allreduce<double>(123);
+  test_broadcast_fcollect<int>(1);
+  test_broadcast_fcollect<double>(257);
+  test_team_allreduce<int64_t>(100);
+  test_team_allreduce<double>(1);
+}
+
+#endif /* TEST_COLLECTIVES_HPP_ */
@@ -231,6 +231,289 @@ void test_deepcopy( int i1, int i2,
   });
 }
 
+template <class Data_t>
+void test_deepcopy_bulk(int i1, int first, int last)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace>;
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRow_t = Kokkos::View<Data_t*, Kokkos::HostSpace>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const Kokkos::pair<size_t, size_t> range(first, last);
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int i = 0; i < i1; ++i)
+    v_H(0,i) = (Data_t) my_rank * i1 + i;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace().fence();
+
+  // Fetch a slice of the neighbor's segment
+  ViewRow_t v_G ("GetView",last - first);
+  Kokkos::Experimental::deep_copy(v_G, v_R, next_rank, range);
+  for(int i = first; i < last; ++i)
+    ASSERT_EQ(v_G(i - first), (Data_t) next_rank * i1 + i);
+  RemoteSpace().fence();
+
+  // Overwrite the same slice of the neighbor's segment; ours is
+  // overwritten by the previous rank in turn
+  ViewRow_t v_P ("PutView",last - first);
+  for(int i = first; i < last; ++i)
+    v_P(i - first) = (Data_t) -i;
+  Kokkos::Experimental::deep_copy(v_R, v_P, next_rank, range);
+  RemoteSpace().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    if (i >= first && i < last)
+      ASSERT_EQ(v_H(0,i), (Data_t) -i);
+    else
+      ASSERT_EQ(v_H(0,i), (Data_t) my_rank * i1 + i);
+}
+
+template <class Data_t>
+void test_deepcopy_bulk_async(int i1, int first, int last)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace>;
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRow_t = Kokkos::View<Data_t*, Kokkos::HostSpace>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const Kokkos::pair<size_t, size_t> range(first, last);
+  Kokkos::DefaultHostExecutionSpace exec;
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int i = 0; i < i1; ++i)
+    v_H(0,i) = (Data_t) my_rank * i1 + i;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace().fence();
+
+  // Fetch a slice of the neighbor's segment while computing locally
+  ViewRow_t v_G ("GetView",last - first);
+  auto get = Kokkos::Experimental::deep_copy(exec, v_G, v_R, next_rank, range);
+  Data_t local = 0;
+  for(int i = 0; i < i1; ++i)
+    local += v_H(0,i);
+  get.wait();
+  ASSERT_EQ(local, (Data_t) (my_rank * i1 * i1 + i1 * (i1 - 1) / 2));
+  for(int i = first; i < last; ++i)
+    ASSERT_EQ(v_G(i - first), (Data_t) next_rank * i1 + i);
+  RemoteSpace().fence();
+
+  ViewRow_t v_P ("PutView",last - first);
+  for(int i = first; i < last; ++i)
+    v_P(i - first) = (Data_t) -i;
+  auto put = Kokkos::Experimental::deep_copy(exec, v_R, v_P, next_rank, range);
+  while (!put.test()) {}
+  RemoteSpace().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    if (i >= first && i < last)
+      ASSERT_EQ(v_H(0,i), (Data_t) -i);
+    else
+      ASSERT_EQ(v_H(0,i), (Data_t) my_rank * i1 + i);
+}
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+template <class Data_t>
+void test_deepcopy_host_nvshmem(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace>;
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewPinned_t = Kokkos::View<Data_t*, Kokkos::CudaHostPinnedSpace>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const int prev_rank = (my_rank + num_ranks - 1) % num_ranks;
+  const Kokkos::pair<size_t, size_t> range(0, i1);
+  Kokkos::Cuda exec;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+
+  // Host element accesses go through host-initiated transfers
+  auto map = v_R.impl_map();
+  for(int i = 0; i < i1; ++i)
+    map.reference(next_rank, i) = (Data_t) my_rank * i1 + i;
+  RemoteSpace().fence();
+
+  for(int i = 0; i < i1; ++i)
+    ASSERT_EQ((Data_t) map.reference(my_rank, i), (Data_t) prev_rank * i1 + i);
+  RemoteSpace().fence();
+
+  // Pinned host buffers are filled on the stream of exec
+  ViewPinned_t v_P ("PinnedView", i1);
+  auto get = Kokkos::Experimental::deep_copy(exec, v_P, v_R, next_rank, range);
+  get.wait();
+  for(int i = 0; i < i1; ++i)
+    ASSERT_EQ(v_P(i), (Data_t) my_rank * i1 + i);
+  RemoteSpace().fence();
+
+  for(int i = 0; i < i1; ++i)
+    v_P(i) = (Data_t) -i;
+  auto put = Kokkos::Experimental::deep_copy(exec, v_R, v_P, next_rank, range);
+  put.wait();
+  RemoteSpace().fence();
+
+  ViewHost_t v_H ("HostView",1,i1);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    ASSERT_EQ(v_H(0,i), (Data_t) -i);
+}
+#endif
+
+template <class Data_t>
+void test_deepcopy_strided(int i1, int i2)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<Data_t***, Kokkos::LayoutRight, RemoteSpace>;
+  using ViewRight_t = Kokkos::View<Data_t***, Kokkos::LayoutRight, Kokkos::HostSpace>;
+  using ViewLeft_t = Kokkos::View<Data_t***, Kokkos::LayoutLeft, Kokkos::HostSpace>;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1, i2);
+
+  // LayoutLeft into LayoutRight
+  ViewLeft_t v_L ("LeftView",1,i1,i2);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      v_L(0,i,j) = (Data_t) (my_rank * i1 + i) * i2 + j;
+  Kokkos::Experimental::deep_copy(v_R, v_L);
+  RemoteSpace().fence();
+
+  ViewRight_t v_H ("RightView",1,i1,i2);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_H(0,i,j), v_L(0,i,j));
+
+  // LayoutRight back into LayoutLeft
+  ViewLeft_t v_L2 ("LeftView2",1,i1,i2);
+  Kokkos::Experimental::deep_copy(v_L2, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_L2(0,i,j), v_L(0,i,j));
+  RemoteSpace().fence();
+
+  // Strided columns of a wider view, leaving the other columns untouched
+  ViewRight_t v_W ("WideView",1,i1,2*i2);
+  auto v_S = Kokkos::subview(v_W, Kokkos::ALL(), Kokkos::ALL(),
+                             Kokkos::make_pair(i2, 2*i2));
+  Kokkos::Experimental::deep_copy(v_S, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j) {
+      ASSERT_EQ(v_W(0,i,j), (Data_t) 0);
+      ASSERT_EQ(v_W(0,i,i2+j), v_L(0,i,j));
+    }
+
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      v_S(0,i,j) = (Data_t) -j;
+  Kokkos::Experimental::deep_copy(v_R, v_S);
+  RemoteSpace().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_H(0,i,j), (Data_t) -j);
+  RemoteSpace().fence();
+
+  // The segment of the neighbor, which takes the remote strided path
+  using ViewLeft2D_t = Kokkos::View<Data_t**, Kokkos::LayoutLeft, Kokkos::HostSpace>;
+  const int next_rank = (my_rank + 1) % num_ranks;
+  auto v_N = Kokkos::subview(v_R, next_rank, Kokkos::ALL(), Kokkos::ALL());
+
+  // LayoutLeft put into the neighbor's LayoutRight segment
+  ViewLeft2D_t v_P ("PutView",i1,i2);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      v_P(i,j) = (Data_t) (next_rank * i1 + i) * i2 + j + 1;
+  Kokkos::Experimental::deep_copy(v_N, v_P);
+  RemoteSpace().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_H(0,i,j), (Data_t) (my_rank * i1 + i) * i2 + j + 1);
+
+  // ... and read back into LayoutLeft
+  ViewLeft2D_t v_G ("GetView",i1,i2);
+  Kokkos::Experimental::deep_copy(v_G, v_N);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_G(i,j), v_P(i,j));
+  RemoteSpace().fence();
+
+  // Strided columns of the neighbor's segment
+  const int half = i2 / 2;
+  auto v_NC = Kokkos::subview(v_R, next_rank, Kokkos::ALL(),
+                              Kokkos::make_pair(0, half));
+  ViewLeft2D_t v_C ("ColumnView",i1,half);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < half; ++j)
+      v_C(i,j) = (Data_t) -(next_rank * i1 + i) * i2 - j;
+  Kokkos::Experimental::deep_copy(v_NC, v_C);
+  RemoteSpace().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < i2; ++j)
+      ASSERT_EQ(v_H(0,i,j), j < half ? (Data_t) -(my_rank * i1 + i) * i2 - j
+                                     : (Data_t) (my_rank * i1 + i) * i2 + j + 1);
+
+  ViewLeft2D_t v_CG ("ColumnGetView",i1,half);
+  Kokkos::Experimental::deep_copy(v_CG, v_NC);
+  for(int i = 0; i < i1; ++i)
+    for(int j = 0; j < half; ++j)
+      ASSERT_EQ(v_CG(i,j), v_C(i,j));
+  RemoteSpace().fence();
+}
+
+TEST(TEST_CATEGORY, test_deepcopy_bulk) {
+  test_deepcopy_bulk<int>(100, 0, 100);
+  test_deepcopy_bulk<int64_t>(200, 10, 150);
+  test_deepcopy_bulk<double>(300, 299, 300);
+}
+
+TEST(TEST_CATEGORY, test_deepcopy_strided) {
+  test_deepcopy_strided<int>(10, 20);
+  test_deepcopy_strided<int64_t>(33, 7);
+  test_deepcopy_strided<double>(1, 100);
+}
+
+TEST(TEST_CATEGORY, test_deepcopy_bulk_async) {
+  test_deepcopy_bulk_async<int>(100, 0, 100);
+  test_deepcopy_bulk_async<int64_t>(200, 10, 150);
+  test_deepcopy_bulk_async<double>(300, 300, 300);
+}
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+TEST(TEST_CATEGORY, test_deepcopy_host_nvshmem) {
+  test_deepcopy_host_nvshmem<int>(100);
+  test_deepcopy_host_nvshmem<double>(33);
+}
+#endif
+
 TEST(TEST_CATEGORY, test_deepcopy) {
   //scalar
   test_deepcopy<int, RemoteSpace, Kokkos::HostSpace>();
@@ -0,0 +1,108 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_GLOBAL_VIEW_HPP_
+#define TEST_GLOBAL_VIEW_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t, class Distribution_t>
+void test_globalview(size_t n)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using GlobalView_t =
+      Kokkos::Experimental::GlobalView<Data_t, Distribution_t, RemoteSpace_t>;
+
+  GlobalView_t v("GlobalView", n);
+  ASSERT_EQ(v.extent(0), n);
+
+  // Owners initialize their elements through the local segment
+  const size_t local_n = v.local_extent();
+  Kokkos::parallel_for(
+    "Init", local_n, KOKKOS_LAMBDA(const size_t j) {
+      const size_t i = v.map().global_index(my_rank, j);
+      if (i < n) v.view()(my_rank, j) = (Data_t) i;
+    });
+
+  RemoteSpace_t().fence();
+
+  // The map must be a bijection between global indices and segments
+  for (size_t i = 0; i < n; i++) {
+    const int pe = v.map().pe(i);
+    const size_t offset = v.map().offset(i);
+    ASSERT_LT(pe, num_ranks);
+    ASSERT_LT(offset, local_n);
+    ASSERT_EQ(v.map().global_index(pe, offset), i);
+  }
+
+  Data_t sum = 0;
+  Kokkos::parallel_reduce(
+    "Read", n, KOKKOS_LAMBDA(const size_t i, Data_t &lsum) {
+      lsum += v(i);
+  }, sum);
+  ASSERT_EQ(sum, (Data_t) (n * (n - 1) / 2));
+
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_globalview) {
+  using namespace Kokkos::Experimental;
+  test_globalview<int64_t, Block<>>(1000);
+  test_globalview<int64_t, Block<1024>>(1000);
+  test_globalview<int64_t, Block<1000>>(1000);
+  test_globalview<int64_t, Cyclic>(1001);
+  test_globalview<double, BlockCyclic<16>>(1001);
+  test_globalview<double, BlockCyclic<10>>(1001);
+}
+
+#endif /* TEST_GLOBAL_VIEW_HPP_ */
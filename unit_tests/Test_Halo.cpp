@@ -0,0 +1,110 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_HALO_HPP_
+#define TEST_HALO_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_halo_plan(int size, int steps)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R =
+      allocate_symmetric_remote_view<RemoteView_t>("Data", num_ranks, size);
+
+  // Each rank reads the first and last quarter of every segment twice
+  const int quarter = (size + 3) / 4;
+  Kokkos::View<int*, Kokkos::HostSpace> pes("PEs", 4 * quarter * num_ranks);
+  Kokkos::View<size_t*, Kokkos::HostSpace> offsets("Offsets", pes.extent(0));
+  size_t n = 0;
+  for (int rep = 0; rep < 2; rep++)
+    for (int pe = 0; pe < num_ranks; pe++)
+      for (int i = 0; i < quarter; i++) {
+        pes(n) = pe;
+        offsets(n++) = i;
+        pes(n) = pe;
+        offsets(n++) = size - 1 - i;
+      }
+
+  HaloPlan<RemoteView_t> plan(v_R, pes, offsets);
+  ASSERT_EQ(plan.num_local(), size_t(size));
+  const int remote_per_pe = size < 2 * quarter ? size : 2 * quarter;
+  ASSERT_EQ(plan.num_ghosts(), size_t(remote_per_pe * (num_ranks - 1)));
+  ASSERT_LE(plan.num_transfers(), size_t(2 * (num_ranks - 1)));
+
+  for (int step = 0; step < steps; step++) {
+    Kokkos::parallel_for(
+      "Update", size, KOKKOS_LAMBDA(const int i) {
+        v_R(my_rank, i) = (Data_t) (my_rank * size + i + step);
+      });
+    Kokkos::fence();
+    plan.exchange();
+
+    auto h_values =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), plan.values());
+    auto h_index = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       plan.local_index());
+    for (size_t k = 0; k < n; k++)
+      ASSERT_EQ(h_values(h_index(k)),
+                (Data_t) (pes(k) * size + offsets(k) + step));
+  }
+}
+
+TEST(TEST_CATEGORY, test_halo_plan) {
+  test_halo_plan<int>(1, 3);
+  test_halo_plan<int64_t>(1000, 3);
+  test_halo_plan<double>(4099, 3);
+}
+
+#endif /* TEST_HALO_HPP_ */
@@ -0,0 +1,105 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_INSTRUMENTATION_HPP_
+#define TEST_INSTRUMENTATION_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <sstream>
+
+#ifdef KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_access_counters(int size)
+{
+  using namespace Kokkos::Experimental;
+  using Counters_t = Impl::RemoteAccessCounters;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  RemoteView_t v_R("Counted", num_ranks, size);
+  const int next = (my_rank + 1) % num_ranks;
+
+  RemoteSpace_t().fence();
+  Kokkos::parallel_for(
+    "Put", size, KOKKOS_LAMBDA(const int i) { v_R(next, i) = (Data_t) i; });
+  RemoteSpace_t().fence();
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Get", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(my_rank, i); });
+  Kokkos::fence();
+
+  const Counters_t *c = v_R.impl_map().handle().counters;
+  ASSERT_NE(c, (const Counters_t *) NULL);
+  ASSERT_EQ(c->num_pes, num_ranks);
+  const int local = c->num_pes;
+  const int put_slot =
+      Counters_t::Put * (c->num_pes + 1) + (num_ranks > 1 ? next : local);
+  const int get_slot = Counters_t::Get * (c->num_pes + 1) + local;
+  ASSERT_EQ(c->ops[put_slot], (unsigned long long) size);
+  ASSERT_EQ(c->bytes[put_slot], (unsigned long long) size * sizeof(Data_t));
+  ASSERT_EQ(c->ops[get_slot], (unsigned long long) size);
+  ASSERT_EQ(c->bytes[get_slot], (unsigned long long) size * sizeof(Data_t));
+
+  std::ostringstream os;
+  print_remote_access_statistics(os);
+  ASSERT_NE(os.str().find("view \"Counted\""), std::string::npos);
+  ASSERT_NE(os.str().find("fence "), std::string::npos);
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_instrumentation) {
+  test_access_counters<int>(1);
+  test_access_counters<double>(1000);
+}
+
+#endif /* KOKKOS_ENABLE_REMOTE_SPACES_INSTRUMENTATION */
+
+#endif /* TEST_INSTRUMENTATION_HPP_ */
@@ -137,6 +137,164 @@ void test_localdeepcopy(int i1,
 }
 
 
+template <class Data_t>
+void test_localdeepcopy_block(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using ViewLocal_t = Kokkos::View<Data_t*,
+    typename RemoteSpace_t::execution_space::memory_space>;
+  using TeamPolicy_t =  Kokkos::TeamPolicy<>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const Kokkos::pair<size_t, size_t> range(0, i1);
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int j = 0; j < i1; ++j)
+    v_H(0,j) = (Data_t) my_rank * i1 + j;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  ViewRemote_t v_R_cpy = ViewRemote_t("RemoteView", num_ranks, i1);
+  ViewLocal_t v_L ("LocalView",i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace_t().fence();
+
+  // Fetch the neighbor's segment and forward it to the same neighbor
+  Kokkos::parallel_for(
+    "Team", TeamPolicy_t(1,Kokkos::AUTO), KOKKOS_LAMBDA(typename TeamPolicy_t::member_type team) {
+      Kokkos::Experimental::local_deep_copy(team, v_L, v_R, next_rank, range);
+      Kokkos::Experimental::local_deep_copy(team, v_R_cpy, v_L, next_rank, range);
+  });
+  RemoteSpace_t().fence();
+
+  auto v_L_H = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_L);
+  for(int  j = 0; j<i1; ++j)
+    ASSERT_EQ(v_L_H(j), (Data_t) next_rank * i1 + j);
+
+  Kokkos::Experimental::deep_copy(v_H, v_R_cpy);
+  for(int  j = 0; j<i1; ++j)
+    ASSERT_EQ(v_H(0,j), (Data_t) my_rank * i1 + j);
+}
+
+template <class Data_t>
+void test_localdeepcopy_fixed_pe(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using TeamPolicy_t =  Kokkos::TeamPolicy<>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int j = 0; j < i1; ++j)
+    v_H(0,j) = (Data_t) my_rank * i1 + j;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  ViewRemote_t v_R_get = ViewRemote_t("RemoteView", num_ranks, i1);
+  ViewRemote_t v_R_put = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace_t().fence();
+
+  // Segments of the neighbor and of this rank with a fixed PE
+  auto v_N = Kokkos::subview(v_R, next_rank, Kokkos::ALL());
+  auto v_G = Kokkos::subview(v_R_get, my_rank, Kokkos::ALL());
+  auto v_P = Kokkos::subview(v_R_put, next_rank, Kokkos::ALL());
+
+  // Team fetch of the neighbor's segment, thread put back into it
+  Kokkos::parallel_for(
+    "Team", TeamPolicy_t(1,Kokkos::AUTO), KOKKOS_LAMBDA(typename TeamPolicy_t::member_type team) {
+      Kokkos::Experimental::local_deep_copy(team, v_G, v_N);
+      team.team_barrier();
+      Kokkos::single(Kokkos::PerTeam(team), [&]() {
+        Kokkos::Experimental::local_deep_copy(v_P, v_G);
+       });
+  });
+  RemoteSpace_t().fence();
+
+  Kokkos::Experimental::deep_copy(v_H, v_R_get);
+  for(int  j = 0; j<i1; ++j)
+    ASSERT_EQ(v_H(0,j), (Data_t) next_rank * i1 + j);
+
+  Kokkos::Experimental::deep_copy(v_H, v_R_put);
+  for(int  j = 0; j<i1; ++j)
+    ASSERT_EQ(v_H(0,j), (Data_t) my_rank * i1 + j);
+}
+
+template <class Data_t>
+void test_remote_gather(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using LocalSpace_t = typename RemoteSpace_t::execution_space::memory_space;
+  using TeamPolicy_t =  Kokkos::TeamPolicy<>;
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int j = 0; j < i1; ++j)
+    v_H(0,j) = (Data_t) my_rank * i1 + j;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace_t().fence();
+
+  // Indices interleave all PEs and revisit elements
+  const int n = 2 * i1;
+  Kokkos::View<int*, LocalSpace_t> pes ("PEs", n);
+  Kokkos::View<size_t*, LocalSpace_t> offsets ("Offsets", n);
+  Kokkos::View<Data_t*, LocalSpace_t> v_L ("LocalView", n);
+  auto pes_H = Kokkos::create_mirror_view(pes);
+  auto offsets_H = Kokkos::create_mirror_view(offsets);
+  for(int k = 0; k < n; ++k) {
+    pes_H(k) = (k * 7 + my_rank) % num_ranks;
+    offsets_H(k) = (k * 13) % i1;
+  }
+  Kokkos::deep_copy(pes, pes_H);
+  Kokkos::deep_copy(offsets, offsets_H);
+
+  Kokkos::parallel_for(
+    "Team", TeamPolicy_t(1,Kokkos::AUTO), KOKKOS_LAMBDA(typename TeamPolicy_t::member_type team) {
+      Kokkos::Experimental::remote_gather(team, v_R, pes, offsets, v_L);
+  });
+  Kokkos::fence();
+
+  auto v_L_H = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_L);
+  for(int k = 0; k < n; ++k)
+    ASSERT_EQ(v_L_H(k), (Data_t) pes_H(k) * i1 + offsets_H(k));
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_remote_gather) {
+  test_remote_gather<int>(50);
+  test_remote_gather<int64_t>(150);
+  test_remote_gather<double>(1500);
+}
+
+TEST(TEST_CATEGORY, test_localdeepcopy_block) {
+  test_localdeepcopy_block<int>(50);
+  test_localdeepcopy_block<int64_t>(150);
+  test_localdeepcopy_block<double>(1500);
+}
+
+TEST(TEST_CATEGORY, test_localdeepcopy_fixed_pe) {
+  test_localdeepcopy_fixed_pe<int>(50);
+  test_localdeepcopy_fixed_pe<int64_t>(150);
+  test_localdeepcopy_fixed_pe<double>(1500);
+}
+
 TEST(TEST_CATEGORY, test_localdeepcopy) {
   //Scalar
   test_localdeepcopy<int, Kokkos::HostSpace, RemoteSpace_t>();
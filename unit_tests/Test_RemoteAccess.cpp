@@ -53,7 +53,8 @@
 using RemoteSpace = Kokkos::Experimental::DefaultRemoteMemorySpace;
 
 
-template <class Data_t, class Space_t >
+template <class Data_t, class Space_t,
+          class Traits_t = Kokkos::MemoryTraits<0> >
 void test_remote_accesses(int size)
 {
   int my_rank;
@@ -64,7 +65,7 @@ void test_remote_accesses(int size)
   using TeamPolicy = Kokkos::TeamPolicy<>;
   TeamPolicy policy = TeamPolicy(1, Kokkos::AUTO);
 
-  using RemoteView_t = Kokkos::View<Data_t**, Space_t>;
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t, Traits_t>;
   using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
 
   // Allocate remote view
@@ -92,10 +93,363 @@ void test_remote_accesses(int size)
   ASSERT_EQ(check, ref);
 }
 
+template <class Data_t, class Space_t,
+          class Traits_t = Kokkos::MemoryTraits<0> >
+void test_view_fence(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t, Traits_t>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  // A second live allocation that the view-scoped fence must not require
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  RemoteView_t v_U = RemoteView_t("UnrelatedView", num_ranks, size);
+
+  Kokkos::parallel_for(
+      "Fill", size, KOKKOS_LAMBDA(const int i) {
+        v_R(num_ranks - my_rank - 1, i) = (Data_t)my_rank * size + i;
+      });
+
+  // Local completion first, then remote visibility for v_R only
+  RemoteSpace().fence_local(v_R);
+  RemoteSpace().fence(v_R);
+
+  HostSpace_t v_H("HostView", 1, size);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(v_H(0, i), (Data_t)(num_ranks - my_rank - 1) * size + i);
+
+  // Completion without synchronization, followed by an explicit barrier
+  Kokkos::parallel_for(
+      "Clear", size, KOKKOS_LAMBDA(const int i) {
+        v_R(num_ranks - my_rank - 1, i) = 0;
+      });
+  RemoteSpace().fence(v_R, false);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(v_H(0, i), (Data_t)0);
+}
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+template <class Data_t>
+void test_stream_fence(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  const int next_rank = (my_rank + 1) % num_ranks;
+  Kokkos::Cuda exec;
+
+  Kokkos::parallel_for(
+      "Write", Kokkos::RangePolicy<Kokkos::Cuda>(exec, 0, size),
+      KOKKOS_LAMBDA(const int i) {
+        v_R(next_rank, i) = (Data_t)my_rank * size + i;
+        RemoteSpace::quiet();
+      });
+
+  // Completion and synchronization are ordered on the stream of exec
+  RemoteSpace().fence(exec);
+  exec.fence();
+
+  HostSpace_t v_H("HostView", 1, size);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+
+  const int prev_rank = (my_rank + num_ranks - 1) % num_ranks;
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(v_H(0, i), (Data_t)prev_rank * size + i);
+  RemoteSpace().fence();
+}
+
+template <class Data_t>
+void test_peer_accesses(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const int lo = size / 2;
+
+  // Peers mapped by the runtime are addressed directly, others not
+  auto handle = v_R.impl_map().handle();
+  for (int pe = 0; pe < num_ranks; pe++) {
+    const bool reachable =
+        pe == my_rank || nvshmem_ptr(handle.ptr, pe) != NULL;
+    ASSERT_EQ(handle.local_ptr(pe, 0) != NULL, reachable);
+  }
+
+  // Stores through a window with an element offset into the neighbor
+  auto v_S = Kokkos::subview(v_R, next_rank, Kokkos::make_pair(lo, size));
+  Kokkos::parallel_for(
+    "Write", size - lo, KOKKOS_LAMBDA(const int i) {
+      v_S(i) = (Data_t) my_rank * size + lo + i;
+    });
+
+  RemoteSpace().fence();
+
+  HostSpace_t v_H ("HostView",1,size);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+
+  const int prev_rank = (my_rank + num_ranks - 1) % num_ranks;
+  for (int i = lo; i < size; i++)
+    ASSERT_EQ(v_H(0, i), (Data_t) prev_rank * size + i);
+  RemoteSpace().fence();
+}
+#endif
+
+template <class Data_t, class Space_t>
+void test_local_accesses(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+
+  // Allocate remote view
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  RemoteView_t v_R_cpy = RemoteView_t("RemoteView", num_ranks, size);
+
+  // Stores to the own segment take the local path
+  Kokkos::parallel_for(
+    "Local", size, KOKKOS_LAMBDA(const int i) {
+      v_R(my_rank, i) = (Data_t) my_rank * size + i;
+    });
+
+  RemoteSpace().fence();
+
+  // Mix of local and remote loads
+  Kokkos::parallel_for(
+    "Mixed", size, KOKKOS_LAMBDA(const int i) {
+      v_R_cpy(my_rank, i) = v_R(my_rank, i) + v_R(next_rank, i);
+    });
+
+  RemoteSpace().fence();
+
+  HostSpace_t v_H ("HostView",1,size);
+  Kokkos::Experimental::deep_copy(v_H, v_R_cpy);
+
+  for (int i=0; i<size; i++)
+    ASSERT_EQ(v_H(0,i), (Data_t) (my_rank + next_rank) * size + 2 * i);
+}
+
+template <class Data_t, class Space_t>
+void test_shared_accesses(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  // Peers on the same node reach each other through load/store
+  RemoteView_t v_R =
+      Kokkos::Experimental::allocate_symmetric_shared_remote_view<
+          RemoteView_t>("RemoteView", num_ranks, size);
+
+  Kokkos::parallel_for(
+    "Update", size, KOKKOS_LAMBDA(const int i) {
+      v_R(num_ranks-my_rank-1, i) = (Data_t) my_rank * size + i;
+    });
+
+  RemoteSpace().fence();
+
+  HostSpace_t v_H ("HostView",1,size);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+  for (int i=0; i<size; i++)
+    ASSERT_EQ(v_H(0,i), (Data_t) (num_ranks - my_rank - 1) * size + i);
+
+  // Bulk transfer from the segment of the neighbor
+  const int next_rank = (my_rank + 1) % num_ranks;
+  Kokkos::Experimental::deep_copy(v_H, v_R, next_rank,
+                                  Kokkos::pair<size_t, size_t>(0, size));
+  for (int i=0; i<size; i++)
+    ASSERT_EQ(v_H(0,i), (Data_t) (num_ranks - next_rank - 1) * size + i);
+}
+
+#ifdef KOKKOS_ENABLE_MPISPACE
+template <class Data_t, class Space_t>
+void test_remote_compound_ops(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t>;
+  using HostSpace_t = Kokkos::View<Data_t**, Kokkos::HostSpace> ;
+
+  // Allocate remote view
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  RemoteSpace().fence();
+
+  // All ranks update the segment of rank 0 concurrently
+  Kokkos::parallel_for(
+    "Update", size, KOKKOS_LAMBDA(const int i) {
+      v_R(0, i) += (Data_t) 2;
+      v_R(0, i)++;
+      v_R(0, i) ^= (Data_t) 0x100;
+    });
+
+  RemoteSpace().fence();
+
+  HostSpace_t v_H ("HostView",1,size);
+  Kokkos::Experimental::deep_copy(v_H, v_R);
+
+  if (my_rank == 0) {
+    Data_t ref = (Data_t) (3 * num_ranks);
+    if (num_ranks % 2)
+      ref ^= (Data_t) 0x100;
+    for (int i=0; i<size; i++)
+      ASSERT_EQ(v_H(0,i), ref);
+  }
+}
+
+template <class Data_t, class Space_t>
+void test_access_traits(int size)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using namespace Kokkos::Experimental;
+  using RemoteView_t = Kokkos::View<Data_t**, Space_t>;
+  using WriteView_t =
+      Kokkos::View<Data_t**, Space_t, Kokkos::MemoryTraits<WriteOnly>>;
+  using ReadView_t =
+      Kokkos::View<Data_t**, Space_t, Kokkos::MemoryTraits<ReadOnly>>;
+  using ConstView_t = Kokkos::View<const Data_t**, Space_t,
+                                   Kokkos::MemoryTraits<Kokkos::RandomAccess>>;
+  using RelaxedView_t =
+      Kokkos::View<Data_t**, Space_t, Kokkos::MemoryTraits<Relaxed>>;
+
+  RemoteView_t v_R = RemoteView_t("RemoteView", num_ranks, size);
+  WriteView_t v_W = v_R;
+  ReadView_t v_RO = v_R;
+  ConstView_t v_C = v_R;
+  RelaxedView_t v_X = v_R;
+  const int next = (my_rank + 1) % num_ranks;
+  const int prev = (my_rank + num_ranks - 1) % num_ranks;
+
+  Kokkos::parallel_for(
+    "Write", size, KOKKOS_LAMBDA(const int i) {
+      v_W(next, i) = (Data_t) my_rank * size + i;
+    });
+  RemoteSpace().fence();
+
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Read", size, KOKKOS_LAMBDA(const int i) {
+      const Data_t a = v_RO(next, i);
+      const Data_t b = v_C(my_rank, i);
+      v_D(i) = a + b;
+    });
+  Kokkos::fence();
+  auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_D(i), (Data_t) (my_rank * size + i + prev * size + i));
+
+  // Relaxed stores and updates complete at the fence
+  RemoteSpace().fence();
+  Kokkos::parallel_for(
+    "Relaxed", size, KOKKOS_LAMBDA(const int i) { v_X(next, i) = (Data_t) i; });
+  RemoteSpace().fence();
+  Kokkos::parallel_for(
+    "Relaxed", size, KOKKOS_LAMBDA(const int i) { v_X(next, i)++; });
+  RemoteSpace().fence();
+  Kokkos::parallel_for(
+    "Read", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_C(my_rank, i); });
+  Kokkos::fence();
+  Kokkos::deep_copy(h_D, v_D);
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_D(i), (Data_t) (i + 1));
+}
+
+TEST(TEST_CATEGORY, test_remote_compound_ops) {
+  test_remote_compound_ops<int, RemoteSpace>(1234);
+  test_remote_compound_ops<int64_t, RemoteSpace>(567);
+}
+#endif
+
 TEST(TEST_CATEGORY, test_remote_accesses) {
   test_remote_accesses<int, RemoteSpace>(12345);
   test_remote_accesses<int64_t, RemoteSpace>(4567);
   test_remote_accesses<double, RemoteSpace>(89);
 }
 
+TEST(TEST_CATEGORY, test_remote_accesses_deferred) {
+  using Deferred_t =
+      Kokkos::MemoryTraits<Kokkos::Experimental::DeferredPut>;
+  test_remote_accesses<int, RemoteSpace, Deferred_t>(12345);
+  test_remote_accesses<double, RemoteSpace, Deferred_t>(89);
+}
+
+TEST(TEST_CATEGORY, test_remote_accesses_remote_only) {
+  using RemoteOnly_t =
+      Kokkos::MemoryTraits<Kokkos::Experimental::RemoteOnly>;
+  test_remote_accesses<int, RemoteSpace, RemoteOnly_t>(12345);
+  test_remote_accesses<double, RemoteSpace, RemoteOnly_t>(89);
+}
+
+TEST(TEST_CATEGORY, test_access_traits) {
+  test_access_traits<int, RemoteSpace>(12345);
+  test_access_traits<int64_t, RemoteSpace>(4567);
+  test_access_traits<double, RemoteSpace>(89);
+}
+
+TEST(TEST_CATEGORY, test_view_fence) {
+  using Deferred_t =
+      Kokkos::MemoryTraits<Kokkos::Experimental::DeferredPut>;
+  test_view_fence<int, RemoteSpace>(12345);
+  test_view_fence<double, RemoteSpace, Deferred_t>(89);
+}
+
+#ifdef KOKKOS_ENABLE_NVSHMEMSPACE
+TEST(TEST_CATEGORY, test_stream_fence) {
+  test_stream_fence<int>(12345);
+  test_stream_fence<double>(89);
+}
+
+TEST(TEST_CATEGORY, test_peer_accesses) {
+  test_peer_accesses<int>(12345);
+  test_peer_accesses<double>(89);
+}
+#endif
+
+TEST(TEST_CATEGORY, test_local_accesses) {
+  test_local_accesses<int, RemoteSpace>(12345);
+  test_local_accesses<int64_t, RemoteSpace>(4567);
+  test_local_accesses<double, RemoteSpace>(89);
+}
+
+TEST(TEST_CATEGORY, test_shared_accesses) {
+  test_shared_accesses<int, RemoteSpace>(12345);
+  test_shared_accesses<double, RemoteSpace>(89);
+}
+
 #endif /* TEST_REMOTE_ACCESS_HPP_ */
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_SCOPE_HPP_
+#define TEST_SCOPE_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+/* Splits the PEs into a lower and an upper half and returns the memory
+ * space of the half of the calling PE */
+RemoteSpace_t split_half_space(int num_ranks, int my_rank)
+{
+  const int lower = (num_ranks + 1) / 2;
+#if defined(KOKKOS_ENABLE_NVSHMEMSPACE)
+  nvshmem_team_t team = NVSHMEM_TEAM_INVALID, upper = NVSHMEM_TEAM_INVALID;
+  nvshmem_team_split_strided(NVSHMEM_TEAM_WORLD, 0, 1, lower, NULL, 0, &team);
+  if (num_ranks > lower)
+    nvshmem_team_split_strided(NVSHMEM_TEAM_WORLD, lower, 1,
+                               num_ranks - lower, NULL, 0, &upper);
+  return RemoteSpace_t::team_space(my_rank < lower ? team : upper);
+#elif defined(KOKKOS_ENABLE_SHMEMSPACE)
+  shmem_team_t team = SHMEM_TEAM_INVALID, upper = SHMEM_TEAM_INVALID;
+  shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, lower, NULL, 0, &team);
+  if (num_ranks > lower)
+    shmem_team_split_strided(SHMEM_TEAM_WORLD, lower, 1, num_ranks - lower,
+                             NULL, 0, &upper);
+  return RemoteSpace_t(my_rank < lower ? team : upper);
+#else
+  MPI_Comm comm;
+  MPI_Comm_split(MPI_COMM_WORLD, my_rank < lower, my_rank, &comm);
+  return RemoteSpace_t(comm);
+#endif
+}
+
+/* Split once, teams and communicators are reused by all tests */
+RemoteSpace_t &half_space(int num_ranks, int my_rank)
+{
+  static RemoteSpace_t half = split_half_space(num_ranks, my_rank);
+  return half;
+}
+
+template <class Data_t>
+void test_scoped_ring(int size)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  RemoteSpace_t &half = half_space(num_ranks, my_rank);
+  const int half_rank = half.impl_my_pe();
+  const int half_ranks = half.impl_num_pes();
+  ASSERT_EQ(half_ranks, my_rank < (num_ranks + 1) / 2
+                            ? (num_ranks + 1) / 2
+                            : num_ranks - (num_ranks + 1) / 2);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+#if defined(KOKKOS_ENABLE_NVSHMEMSPACE) || defined(KOKKOS_ENABLE_SHMEMSPACE)
+  // The symmetric heap is collective over all PEs
+  RemoteArena<RemoteSpace_t> arena(1 << 20);
+  RemoteView_t v_R(Kokkos::view_alloc("Ring", arena.space(half)), half_ranks,
+                   size);
+  RemoteView_t s_R(Kokkos::view_alloc("Sum", arena.space(half)), half_ranks,
+                   1);
+#else
+  RemoteView_t v_R = allocate_symmetric_remote_view<RemoteView_t>(
+      "Ring", half, half_ranks, size);
+  RemoteView_t s_R = allocate_symmetric_remote_view<RemoteView_t>(
+      "Sum", half, half_ranks, 1);
+#endif
+
+  // PE indices are ranks within the half
+  const int next = (half_rank + 1) % half_ranks;
+  const int prev = (half_rank + half_ranks - 1) % half_ranks;
+  half.fence();
+  Kokkos::parallel_for(
+    "Put", size, KOKKOS_LAMBDA(const int i) {
+      v_R(next, i) = (Data_t) (i + my_rank);
+    });
+  half.fence();
+
+  Kokkos::View<Data_t*> v_D("Local", size);
+  Kokkos::parallel_for(
+    "Get", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(half_rank, i); });
+  Kokkos::fence();
+  auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+  const int prev_world = my_rank - half_rank + prev;
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(h_D(i), (Data_t) (i + prev_world));
+
+  // Collectives only involve the half
+  Kokkos::parallel_for(
+    "Init", 1, KOKKOS_LAMBDA(const int) { s_R(half_rank, 0) = 1; });
+  half.fence();
+  allreduce(s_R, s_R, OpSum);
+  Kokkos::View<Data_t*> s_D("Local", 1);
+  Kokkos::parallel_for(
+    "Read", 1, KOKKOS_LAMBDA(const int) { s_D(0) = s_R(half_rank, 0); });
+  Kokkos::fence();
+  auto h_S = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), s_D);
+  ASSERT_EQ(h_S(0), (Data_t) half_ranks);
+
+  half.fence();
+}
+
+TEST(TEST_CATEGORY, test_scoped_space) {
+  test_scoped_ring<int>(1);
+  test_scoped_ring<int64_t>(1000);
+  test_scoped_ring<double>(4099);
+}
+
+#endif /* TEST_SCOPE_HPP_ */
@@ -0,0 +1,127 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_SIGNAL_HPP_
+#define TEST_SIGNAL_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_put_signal_ring(int size, int steps)
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using RemoteView_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using SignalView_t = Kokkos::View<uint64_t**, RemoteSpace_t>;
+  RemoteView_t v_R =
+      allocate_symmetric_remote_view<RemoteView_t>("Data", num_ranks, size);
+  // Slot 0 announces data, slot 1 acknowledges its consumption
+  SignalView_t sig =
+      allocate_symmetric_remote_view<SignalView_t>("Signals", num_ranks, 2);
+  RemoteSpace_t().fence();
+
+  const int next = (my_rank + 1) % num_ranks;
+  const int prev = (my_rank + num_ranks - 1) % num_ranks;
+  Kokkos::View<Data_t*, Kokkos::HostSpace> h_src("Src", size);
+  Kokkos::View<Data_t*> v_D("Local", size);
+
+  for (int step = 0; step < steps; step++) {
+    // The segment of next is free once next consumed the previous step
+    if (step > 0)
+      ASSERT_GE(signal_wait_until(sig, 1, CmpGE, uint64_t(step)),
+                uint64_t(step));
+    for (int i = 0; i < size; i++)
+      h_src(i) = (Data_t) (i + step * my_rank);
+    put_signal(v_R, h_src, next, Kokkos::pair<size_t, size_t>(0, size), sig,
+               0, uint64_t(step + 1));
+
+    ASSERT_EQ(signal_wait_until(sig, 0, CmpGE, uint64_t(step + 1)),
+              uint64_t(step + 1));
+    Kokkos::parallel_for(
+      "Get", size, KOKKOS_LAMBDA(const int i) { v_D(i) = v_R(my_rank, i); });
+    Kokkos::fence();
+    auto h_D = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_D);
+    for (int i = 0; i < size; i++)
+      ASSERT_EQ(h_D(i), (Data_t) (i + step * prev));
+    remote_signal(sig, prev, 1, uint64_t(step + 1));
+  }
+  RemoteSpace_t().fence();
+}
+
+void test_signal_add()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using SignalView_t = Kokkos::View<uint64_t**, RemoteSpace_t>;
+  SignalView_t sig =
+      allocate_symmetric_remote_view<SignalView_t>("Signals", num_ranks, 1);
+  RemoteSpace_t().fence();
+
+  // Every rank checks in at rank 0
+  remote_signal(sig, 0, 0, 1, SignalAdd);
+  if (my_rank == 0)
+    ASSERT_EQ(signal_wait_until(sig, 0, CmpEQ, uint64_t(num_ranks)),
+              uint64_t(num_ranks));
+  RemoteSpace_t().fence();
+}
+
+TEST(TEST_CATEGORY, test_signal) {
+  test_put_signal_ring<int>(1, 10);
+  test_put_signal_ring<int64_t>(1000, 10);
+  test_put_signal_ring<double>(4099, 3);
+  test_signal_add();
+}
+
+#endif /* TEST_SIGNAL_HPP_ */
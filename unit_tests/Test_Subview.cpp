@@ -0,0 +1,149 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_SUBVIEW_HPP_
+#define TEST_SUBVIEW_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+template <class Data_t>
+void test_subview_fixed_pe(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewHost1D_t = Kokkos::View<Data_t*, Kokkos::HostSpace>;
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+  using ViewLocal_t = Kokkos::View<Data_t*,
+    typename RemoteSpace_t::execution_space::memory_space>;
+
+  const int next_rank = (my_rank + 1) % num_ranks;
+  const int lo = i1 / 4;
+  const int hi = i1 - i1 / 4;
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int j = 0; j < i1; ++j)
+    v_H(0,j) = (Data_t) my_rank * i1 + j;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace_t().fence();
+
+  // Rank-1 window into the neighbor's segment
+  auto v_S = Kokkos::subview(v_R, next_rank, Kokkos::make_pair(lo, hi));
+  ASSERT_EQ(v_S.extent(0), (size_t) (hi - lo));
+
+  ViewLocal_t v_L ("LocalView", hi - lo);
+  Kokkos::parallel_for(
+    "Read", hi - lo, KOKKOS_LAMBDA(const int j) { v_L(j) = v_S(j); });
+
+  auto v_S_H = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v_L);
+  for(int j = 0; j < hi - lo; ++j)
+    ASSERT_EQ(v_S_H(j), (Data_t) next_rank * i1 + lo + j);
+
+  // Bulk copy of the window of the local segment
+  auto v_S_local = Kokkos::subview(v_R, my_rank, Kokkos::make_pair(lo, hi));
+  ViewHost1D_t v_B_H ("BulkHost", hi - lo);
+  Kokkos::Experimental::deep_copy(v_B_H, v_S_local);
+  for(int j = 0; j < hi - lo; ++j)
+    ASSERT_EQ(v_B_H(j), (Data_t) my_rank * i1 + lo + j);
+}
+
+template <class Data_t>
+void test_subview_pe_range(int i1)
+{
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewHost_t = Kokkos::View<Data_t**, Kokkos::HostSpace>;
+  using ViewRemote_t = Kokkos::View<Data_t**, RemoteSpace_t>;
+
+  ViewHost_t v_H ("HostView",1,i1);
+  for(int j = 0; j < i1; ++j)
+    v_H(0,j) = (Data_t) my_rank * i1 + j;
+
+  ViewRemote_t v_R = ViewRemote_t("RemoteView", num_ranks, i1);
+  Kokkos::Experimental::deep_copy(v_R, v_H);
+  RemoteSpace_t().fence();
+
+  // Drop the first PE, keep the rest addressable by relative index
+  const int first_pe = num_ranks > 1 ? 1 : 0;
+  auto v_S = Kokkos::subview(v_R, Kokkos::make_pair(first_pe, num_ranks),
+                             Kokkos::ALL);
+  ASSERT_EQ(v_S.extent(1), (size_t) i1);
+
+  const int pe = (num_ranks - first_pe) - 1;
+  Data_t sum = 0;
+  Kokkos::parallel_reduce(
+    "Read", i1, KOKKOS_LAMBDA(const int j, Data_t &lsum) {
+      lsum += v_S(pe, j);
+  }, sum);
+
+  Data_t expected = 0;
+  for(int j = 0; j < i1; ++j)
+    expected += (Data_t) (first_pe + pe) * i1 + j;
+  ASSERT_EQ(sum, expected);
+}
+
+TEST(TEST_CATEGORY, test_subview) {
+  test_subview_fixed_pe<int>(40);
+  test_subview_fixed_pe<int64_t>(160);
+  test_subview_fixed_pe<double>(1024);
+
+  test_subview_pe_range<int>(40);
+  test_subview_pe_range<int64_t>(160);
+  test_subview_pe_range<double>(1024);
+}
+
+#endif /* TEST_SUBVIEW_HPP_ */
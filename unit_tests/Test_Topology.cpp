@@ -0,0 +1,117 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef TEST_TOPOLOGY_HPP_
+#define TEST_TOPOLOGY_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <vector>
+
+using RemoteSpace_t = Kokkos::Experimental::DefaultRemoteMemorySpace;
+
+void test_topology()
+{
+  using namespace Kokkos::Experimental;
+  int my_rank;
+  int num_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  using ViewRemote_t = Kokkos::View<int**, RemoteSpace_t>;
+  ViewRemote_t v = ViewRemote_t("TopologyView", num_ranks, 16);
+  PETopology<RemoteSpace_t> topo(v);
+
+  ASSERT_EQ(topo.num_pes(), num_ranks);
+  ASSERT_EQ(topo.my_pe(), my_rank);
+  ASSERT_EQ(topo.my_node(), topo.node(my_rank));
+
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, my_rank,
+                      MPI_INFO_NULL, &node_comm);
+  int node_rank, node_size;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_size(node_comm, &node_size);
+  MPI_Comm_free(&node_comm);
+  ASSERT_EQ(topo.local_rank(my_rank), node_rank);
+  ASSERT_EQ(topo.num_node_local(), node_size);
+
+  // Node and rank within the node identify a PE
+  int pes = 0;
+  for (int n = 0; n < topo.num_nodes(); n++) {
+    ASSERT_GT(topo.node_size(n), 0);
+    pes += topo.node_size(n);
+  }
+  ASSERT_EQ(pes, num_ranks);
+  for (int pe = 0; pe < num_ranks; pe++)
+    ASSERT_EQ(topo.node_pe(topo.node(pe), topo.local_rank(pe)), pe);
+
+  // The access order is a permutation starting with the own node
+  std::vector<int> seen(num_ranks, 0);
+  for (int k = 0; k < num_ranks; k++) {
+    const int pe = topo.order(k);
+    ASSERT_GE(pe, 0);
+    ASSERT_LT(pe, num_ranks);
+    seen[pe]++;
+    ASSERT_EQ(topo.is_node_local(pe), k < topo.num_node_local());
+  }
+  for (int pe = 0; pe < num_ranks; pe++)
+    ASSERT_EQ(seen[pe], 1);
+
+  // Queries agree inside kernels
+  int errors = 0;
+  Kokkos::parallel_reduce(
+    "CheckTopology", num_ranks, KOKKOS_LAMBDA(const int k, int &err) {
+      const int pe = topo.order(k);
+      if (topo.node_pe(topo.node(pe), topo.local_rank(pe)) != pe) err++;
+      if (topo.is_node_local(pe) != (k < topo.num_node_local())) err++;
+    }, errors);
+  ASSERT_EQ(errors, 0);
+}
+
+TEST(TEST_CATEGORY, test_topology) {
+  test_topology();
+}
+
+#endif /* TEST_TOPOLOGY_HPP_ */